@@ -19,6 +19,9 @@ let package = Package(
     .library(
       name: "Atomics",
       targets: ["Atomics"]),
+    .library(
+      name: "AtomicsExecutor",
+      targets: ["AtomicsExecutor"]),
   ],
   targets: [
     .target(name: "_AtomicsShims"),
@@ -26,9 +29,13 @@ let package = Package(
       name: "Atomics",
       dependencies: ["_AtomicsShims"]
     ),
+    .target(
+      name: "AtomicsExecutor",
+      dependencies: ["Atomics", "_AtomicsShims"]
+    ),
     .testTarget(
       name: "AtomicsTests",
-      dependencies: ["Atomics"],
+      dependencies: ["Atomics", "AtomicsExecutor", "_AtomicsShims"],
       exclude: ["main.swift"]
     ),
   ]
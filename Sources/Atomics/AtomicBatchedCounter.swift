@@ -0,0 +1,205 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+/// A counter that accumulates increments in thread-local storage, and only
+/// adds them to a shared atomic total in batches.
+///
+/// Each thread's increments are added to the total (with a single
+/// `loadThenWrappingIncrement(by:ordering:)`) every `flushThreshold`
+/// increments, when the thread reads the counter, when it calls `flush()`,
+/// and when it exits. Most increments therefore don't touch shared memory at
+/// all, which makes this a good fit for frequently updated statistics.
+///
+/// The price is that the total lags behind: `load()` includes every
+/// increment made by the calling thread, and by threads that have exited
+/// or flushed, but may miss up to `flushThreshold - 1` recent increments of
+/// each other running thread.
+///
+/// All counters share a single entry in each thread's per-thread registry:
+/// a table of the thread's per-counter state, indexed by a number that the
+/// counter gets when it's created (and gives back when it's deinitialized).
+/// When a counter is deinitialized, the unflushed increments of other running
+/// threads are discarded; their state for it is released when they exit,
+/// or when they first use a new counter that reuses its index.
+public final class AtomicBatchedCounter {
+  /// The number of increments a thread accumulates before adding them to
+  /// the shared total.
+  public let flushThreshold: Int
+
+  private let _total: ManagedAtomic<Int>
+  private let _index: Int
+
+  /// Creates a new counter with an initial value of zero.
+  ///
+  /// - Parameter flushThreshold: The number of increments a thread
+  ///   accumulates before adding them to the shared total.
+  public init(flushThreshold: Int = 64) {
+    precondition(flushThreshold > 0, "Invalid flush threshold")
+    self.flushThreshold = flushThreshold
+    self._total = ManagedAtomic(0)
+    self._index = _BatchedCounterTable.allocateIndex()
+  }
+
+  deinit {
+    _BatchedCounterTable.current?.removeSlot(at: _index)
+    _BatchedCounterTable.releaseIndex(_index)
+  }
+
+  /// Adds `amount` to the counter, wrapping around on overflow.
+  public func increment(by amount: Int = 1) {
+    let slot = _BatchedCounterTable.forCurrentThread()
+      .slot(at: _index, total: _total)
+    slot.pending &+= amount
+    slot.count += 1
+    if slot.count >= flushThreshold {
+      slot.flush()
+    }
+  }
+
+  /// Adds the increments accumulated by the calling thread to the shared
+  /// total.
+  public func flush() {
+    _BatchedCounterTable.current?.existingSlot(at: _index, total: _total)?
+      .flush()
+  }
+
+  /// Flushes the increments of the calling thread, then returns the shared
+  /// total.
+  public func load() -> Int {
+    flush()
+    return _total.load(ordering: .relaxed)
+  }
+}
+
+/// The increments of a single thread that haven't been added to the shared
+/// total yet. Only the owning thread ever accesses these.
+internal final class _BatchedCounterSlot {
+  // Slots hold on to the total rather than the counter, so that they can
+  // be flushed on thread exit even if the counter is gone. This also tells
+  // slots of a deinitialized counter apart from slots of a new counter that
+  // reuses its index.
+  let total: ManagedAtomic<Int>
+  var pending = 0
+  var count = 0
+
+  init(total: ManagedAtomic<Int>) {
+    self.total = total
+  }
+
+  func flush() {
+    if pending != 0 {
+      _ = total.loadThenWrappingIncrement(by: pending, ordering: .relaxed)
+    }
+    pending = 0
+    count = 0
+  }
+}
+
+/// The batched counter slots of a single thread, indexed by counter. This is
+/// the thread's `_ThreadLocalRegistry` entry for batched counters.
+internal final class _BatchedCounterTable: _ThreadLocalEntry {
+  private var _slots: [_BatchedCounterSlot?] = []
+
+  /// The calling thread's table, if it has one.
+  static var current: _BatchedCounterTable? {
+    _ThreadLocalRegistry.entry(_BatchedCounterTable.self)
+  }
+
+  /// Returns the calling thread's table, creating it if necessary.
+  static func forCurrentThread() -> _BatchedCounterTable {
+    _ThreadLocalRegistry.entry(
+      _BatchedCounterTable.self,
+      orInsert: { _BatchedCounterTable() })
+  }
+
+  func threadDidExit() {
+    flushAll()
+  }
+
+  func existingSlot(
+    at index: Int,
+    total: ManagedAtomic<Int>
+  ) -> _BatchedCounterSlot? {
+    guard index < _slots.count, let slot = _slots[index], slot.total === total
+    else { return nil }
+    return slot
+  }
+
+  func slot(at index: Int, total: ManagedAtomic<Int>) -> _BatchedCounterSlot {
+    if let slot = existingSlot(at: index, total: total) { return slot }
+    if index >= _slots.count {
+      _slots.append(
+        contentsOf: repeatElement(nil, count: index + 1 - _slots.count))
+    }
+    // A slot left over by a deinitialized counter is flushed into its
+    // (unreachable) total, then replaced.
+    _slots[index]?.flush()
+    let slot = _BatchedCounterSlot(total: total)
+    _slots[index] = slot
+    return slot
+  }
+
+  func removeSlot(at index: Int) {
+    guard index < _slots.count else { return }
+    _slots[index] = nil
+  }
+
+  func flushAll() {
+    for slot in _slots {
+      slot?.flush()
+    }
+  }
+}
+
+extension _BatchedCounterTable {
+  /// A node in the list of unused counter indices. Nodes are never reused,
+  /// so popping them with a compare-exchange is not subject to ABA.
+  private final class _FreeIndex: AtomicReference {
+    let index: Int
+    let next: _FreeIndex?
+
+    init(_ index: Int, next: _FreeIndex?) {
+      self.index = index
+      self.next = next
+    }
+  }
+
+  private static let _freeIndices = ManagedAtomic<_FreeIndex?>(nil)
+  private static let _nextIndex = ManagedAtomic<Int>(0)
+
+  /// Returns an index that no live counter uses.
+  static func allocateIndex() -> Int {
+    var head = _freeIndices.load(ordering: .acquiring)
+    while let node = head {
+      let (exchanged, original) = _freeIndices.compareExchange(
+        expected: node,
+        desired: node.next,
+        ordering: .acquiring)
+      if exchanged { return node.index }
+      head = original
+    }
+    return _nextIndex.loadThenWrappingIncrement(ordering: .relaxed)
+  }
+
+  /// Makes the index of a deinitialized counter available for reuse.
+  static func releaseIndex(_ index: Int) {
+    var head = _freeIndices.load(ordering: .relaxed)
+    while true {
+      let (exchanged, original) = _freeIndices.compareExchange(
+        expected: head,
+        desired: _FreeIndex(index, next: head),
+        ordering: .releasing)
+      if exchanged { return }
+      head = original
+    }
+  }
+}
@@ -0,0 +1,292 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+/// An unsafe, fixed-size buffer of atomic values, requiring manual memory
+/// management of the underlying storage.
+///
+/// The storage representations of the elements are laid out contiguously in
+/// a single allocation. Compared to an array of `ManagedAtomic` instances,
+/// this saves a heap object per element, and lets bulk operations like
+/// `snapshot()` walk memory sequentially rather than chasing pointers.
+///
+///     let buckets = UnsafeAtomicBuffer<Int>.create(repeating: 0, count: 64)
+///     defer { buckets.destroy() }
+///
+///     buckets[3].wrappingIncrement(ordering: .relaxed)
+///     let counts = buckets.snapshot()
+///
+/// Elements are independent atomic values; bulk operations access each one
+/// atomically, but they don't take a consistent snapshot of the buffer as a
+/// whole.
+@frozen
+public struct UnsafeAtomicBuffer<Value: AtomicValue> {
+  public typealias Storage = Value.AtomicRepresentation
+
+  @usableFromInline
+  internal let _base: UnsafeMutablePointer<Storage>
+
+  /// The number of elements in the buffer.
+  public let count: Int
+
+  /// Initialize an unsafe atomic buffer that uses the supplied memory
+  /// locations for storage. The `count` storage locations starting at `base`
+  /// must already be initialized to represent valid atomic values.
+  ///
+  /// At the end of the lifetime of the buffer, you must manually ensure that
+  /// the storage locations are correctly `dispose()`d, deinitalized and
+  /// deallocated.
+  ///
+  /// Note: This is not an atomic operation.
+  @inlinable
+  public init(@_nonEphemeral at base: UnsafeMutablePointer<Storage>, count: Int) {
+    precondition(count >= 0, "Negative count")
+    self._base = base
+    self.count = count
+  }
+}
+
+extension UnsafeAtomicBuffer {
+  /// Create a new buffer of `count` atomic values, each holding
+  /// `initialValue`, by dynamically allocating storage for it.
+  ///
+  /// This call is usually paired with `destroy` to get rid of the allocated
+  /// storage at the end of its lifetime.
+  ///
+  /// Note: This is not an atomic operation.
+  @inlinable
+  public static func create(
+    repeating initialValue: Value,
+    count: Int
+  ) -> Self {
+    let base = UnsafeMutablePointer<Storage>.allocate(capacity: count)
+    for index in 0 ..< count {
+      (base + index).initialize(to: Storage(initialValue))
+    }
+    return Self(at: base, count: count)
+  }
+
+  /// Disposes of the current values of all elements, then deinitializes and
+  /// deallocates the storage.
+  ///
+  /// Note: This is not an atomic operation.
+  @inlinable
+  public func destroy() {
+    for index in 0 ..< count {
+      _ = _base[index].dispose()
+    }
+    _base.deinitialize(count: count)
+    _base.deallocate()
+  }
+
+  /// Returns an atomic view of the element at `index`, supporting every
+  /// operation of `UnsafeAtomic`.
+  @inlinable
+  public subscript(index: Int) -> UnsafeAtomic<Value> {
+    precondition(index >= 0 && index < count, "Index out of range")
+    return UnsafeAtomic(at: _base + index)
+  }
+}
+
+extension UnsafeAtomicBuffer {
+  /// Loads every element with relaxed ordering into `target`, which must
+  /// have room for `count` elements.
+  ///
+  /// This does not allocate, so it is suitable for repeatedly scraping the
+  /// same buffer into a preallocated array.
+  @inlinable
+  public func snapshot(into target: UnsafeMutableBufferPointer<Value>) {
+    precondition(target.count >= count, "Target buffer too small")
+    guard let destination = target.baseAddress else { return }
+    // Relaxed loads of machine-sized values compile to plain loads, so this
+    // is a straight copy. (Vector loads would be faster still, but they
+    // aren't guaranteed to be atomic for each element.)
+    for index in 0 ..< count {
+      (destination + index).initialize(
+        to: Storage.atomicLoad(at: _base + index, ordering: .relaxed))
+    }
+  }
+
+  /// Returns the current values of all elements, each loaded with relaxed
+  /// ordering.
+  @inlinable
+  public func snapshot() -> [Value] {
+    Array(unsafeUninitializedCapacity: count) { buffer, initialized in
+      snapshot(into: buffer)
+      initialized = count
+    }
+  }
+
+  /// Stores `value` into every element with relaxed ordering.
+  @inlinable
+  public func reset(to value: Value) {
+    for index in 0 ..< count {
+      Storage.atomicStore(value, at: _base + index, ordering: .relaxed)
+    }
+  }
+
+  /// Replaces every element with `value`, and returns their original values.
+  ///
+  /// Each element is exchanged with relaxed ordering, so updates racing with
+  /// this call are either included in the result or preserved in the
+  /// buffer, never lost.
+  @inlinable
+  public func snapshotAndReset(to value: Value) -> [Value] {
+    Array(unsafeUninitializedCapacity: count) { buffer, initialized in
+      for index in 0 ..< count {
+        (buffer.baseAddress! + index).initialize(
+          to: Storage.atomicExchange(value, at: _base + index, ordering: .relaxed))
+      }
+      initialized = count
+    }
+  }
+}
+
+/// A fixed-size buffer of atomic values, with automatic memory management.
+///
+/// This is the managed counterpart of `UnsafeAtomicBuffer`: its elements are
+/// stored contiguously, and they are deallocated with the buffer object.
+public final class ManagedAtomicBuffer<Value: AtomicValue> {
+  @usableFromInline
+  internal let _buffer: UnsafeAtomicBuffer<Value>
+
+  /// Initialize a new managed atomic buffer of `count` elements, each
+  /// holding `initialValue`.
+  public init(repeating initialValue: Value, count: Int) {
+    _buffer = UnsafeAtomicBuffer.create(repeating: initialValue, count: count)
+  }
+
+  deinit {
+    _buffer.destroy()
+  }
+
+  /// The number of elements in the buffer.
+  @inlinable
+  public var count: Int { _buffer.count }
+}
+
+extension ManagedAtomicBuffer {
+  /// Atomically loads and returns the element at `index`, applying the
+  /// specified memory ordering.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func load(at index: Int, ordering: AtomicLoadOrdering) -> Value {
+    defer { _fixLifetime(self) }
+    return _buffer[index].load(ordering: ordering)
+  }
+
+  /// Atomically sets the element at `index` to `desired`, applying the
+  /// specified memory ordering.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func store(
+    _ desired: __owned Value,
+    at index: Int,
+    ordering: AtomicStoreOrdering
+  ) {
+    defer { _fixLifetime(self) }
+    _buffer[index].store(desired, ordering: ordering)
+  }
+
+  /// Atomically sets the element at `index` to `desired` and returns its
+  /// original value, applying the specified memory ordering.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func exchange(
+    _ desired: __owned Value,
+    at index: Int,
+    ordering: AtomicUpdateOrdering
+  ) -> Value {
+    defer { _fixLifetime(self) }
+    return _buffer[index].exchange(desired, ordering: ordering)
+  }
+
+  /// Perform an atomic compare and exchange operation on the element at
+  /// `index`, applying the specified memory ordering.
+  ///
+  /// - Returns: A tuple `(exchanged, original)`, where `exchanged` is true if
+  ///   the exchange was successful, and `original` is the original value.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func compareExchange(
+    expected: Value,
+    desired: __owned Value,
+    at index: Int,
+    ordering: AtomicUpdateOrdering
+  ) -> (exchanged: Bool, original: Value) {
+    defer { _fixLifetime(self) }
+    return _buffer[index].compareExchange(
+      expected: expected,
+      desired: desired,
+      ordering: ordering)
+  }
+
+  /// Returns the current values of all elements, each loaded with relaxed
+  /// ordering.
+  @inlinable
+  public func snapshot() -> [Value] {
+    defer { _fixLifetime(self) }
+    return _buffer.snapshot()
+  }
+
+  /// Loads every element with relaxed ordering into `target`, which must
+  /// have room for `count` elements.
+  @inlinable
+  public func snapshot(into target: UnsafeMutableBufferPointer<Value>) {
+    defer { _fixLifetime(self) }
+    _buffer.snapshot(into: target)
+  }
+
+  /// Stores `value` into every element with relaxed ordering.
+  @inlinable
+  public func reset(to value: Value) {
+    defer { _fixLifetime(self) }
+    _buffer.reset(to: value)
+  }
+
+  /// Replaces every element with `value`, and returns their original values.
+  @inlinable
+  public func snapshotAndReset(to value: Value) -> [Value] {
+    defer { _fixLifetime(self) }
+    return _buffer.snapshotAndReset(to: value)
+  }
+}
+
+extension ManagedAtomicBuffer where Value: AtomicInteger {
+  /// Atomically increments the element at `index` by `operand` with
+  /// wraparound, applying the specified memory ordering.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func wrappingIncrement(
+    at index: Int,
+    by operand: Value = 1,
+    ordering: AtomicUpdateOrdering
+  ) {
+    defer { _fixLifetime(self) }
+    _buffer[index].wrappingIncrement(by: operand, ordering: ordering)
+  }
+
+  /// Atomically increments the element at `index` by `operand` with
+  /// wraparound, and returns its original value, applying the specified
+  /// memory ordering.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func loadThenWrappingIncrement(
+    at index: Int,
+    by operand: Value = 1,
+    ordering: AtomicUpdateOrdering
+  ) -> Value {
+    defer { _fixLifetime(self) }
+    return _buffer[index].loadThenWrappingIncrement(
+      by: operand,
+      ordering: ordering)
+  }
+}
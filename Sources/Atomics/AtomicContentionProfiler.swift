@@ -0,0 +1,134 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#if ATOMICS_CONTENTION_PROFILING
+import _AtomicsShims
+
+/// A sampling profiler that measures the latency of atomic exchange and
+/// compare-exchange operations, for finding atomic values that cause
+/// excessive cross-core traffic.
+///
+/// The profiler is only available in builds that define the
+/// `ATOMICS_CONTENTION_PROFILING` compilation condition:
+///
+///     $ swift build -Xswiftc -DATOMICS_CONTENTION_PROFILING
+///
+/// In such builds, it is off by default; while it is stopped, each exchange
+/// or compare-exchange operation only pays for an extra relaxed load and a
+/// (well-predicted) branch. Once started, every thread times one in every
+/// `samplingInterval` such operations using the CPU's timestamp counter
+/// (`rdtsc` on x86, `cntvct_el0` on ARM64), and records the result in a
+/// latency histogram associated with the address of the atomic value.
+///
+/// Operations on contended values take much longer than uncontended ones,
+/// as they need to wait for the corresponding cache line to be transferred
+/// from another core. The histograms with the most total latency identify the
+/// atomic values that are worth sharding or padding.
+///
+/// Latencies are measured in timestamp counter ticks, whose duration depends
+/// on the CPU. (On ARM64, the counter often runs at a much lower frequency
+/// than the CPU, so short latencies mostly show up as zero ticks.)
+public enum AtomicContentionProfiler {
+  /// The number of histogram buckets. Bucket 0 counts samples that took zero
+  /// ticks; bucket `i` counts samples that took between `2^(i-1)` and
+  /// `2^i - 1` ticks. The last bucket also counts all longer samples.
+  public static var bucketCount: Int { Int(SWIFTATOMIC_PROFILER_BUCKETS) }
+
+  /// Start sampling atomic exchange and compare-exchange operations, timing
+  /// one in every `samplingInterval` operations on each thread.
+  public static func start(samplingInterval: Int = 1000) {
+    precondition(samplingInterval > 0 && samplingInterval <= UInt32.max,
+                 "Invalid sampling interval")
+    _sa_profiler_set_interval(UInt32(samplingInterval))
+  }
+
+  /// Stop sampling operations. The histograms collected so far are kept.
+  public static func stop() {
+    _sa_profiler_set_interval(0)
+  }
+
+  /// Discard all collected histograms.
+  ///
+  /// Note: Resetting the profiler while it is running may attribute a few
+  /// samples to the wrong location.
+  public static func reset() {
+    _sa_profiler_reset()
+  }
+
+  /// A latency histogram of sampled operations on a single atomic value.
+  public struct Histogram {
+    /// The address of the atomic value's storage, or nil for samples on
+    /// values that didn't fit in the profiler's location table.
+    public let address: UnsafeRawPointer?
+
+    /// The number of samples in each bucket. (See `bucketCount`.)
+    public let counts: [Int]
+
+    /// The total number of samples.
+    public var sampleCount: Int { counts.reduce(0, +) }
+
+    /// An estimate of the total number of ticks spent in sampled operations,
+    /// assuming each sample took as long as the midpoint of its bucket.
+    public var estimatedTicks: Int {
+      var total = 0
+      for (bucket, count) in counts.enumerated() where bucket > 0 {
+        total += count * (3 << (bucket - 1)) / 2
+      }
+      return total
+    }
+
+    /// Returns an upper bound on the number of ticks that the given fraction
+    /// of samples did not exceed (e.g., 0.99 for the 99th percentile).
+    public func percentile(_ fraction: Double) -> Int {
+      precondition(fraction >= 0 && fraction <= 1, "Invalid fraction")
+      let threshold = Int((Double(sampleCount) * fraction).rounded(.up))
+      var seen = 0
+      for (bucket, count) in counts.enumerated() {
+        seen += count
+        if seen >= threshold { return bucket == 0 ? 0 : (1 << bucket) - 1 }
+      }
+      return Int.max
+    }
+  }
+
+  /// Returns the histograms collected so far, in decreasing order of their
+  /// estimated total latency.
+  public static func histograms() -> [Histogram] {
+    var result: [Histogram] = []
+    let locations = Int(SWIFTATOMIC_PROFILER_LOCATIONS)
+    for location in 0 ... locations {
+      let counts = (0 ..< bucketCount).map {
+        Int(truncatingIfNeeded: _sa_profiler_count(Int32(location), Int32($0)))
+      }
+      guard counts.contains(where: { $0 != 0 }) else { continue }
+      let address = location < locations
+        ? _sa_profiler_address(Int32(location))
+        : nil
+      result.append(Histogram(address: address, counts: counts))
+    }
+    return result.sorted { $0.estimatedTicks > $1.estimatedTicks }
+  }
+
+  /// Prints a summary of the (at most) `count` histograms with the highest
+  /// estimated total latency to the standard output.
+  public static func dump(top count: Int = 10) {
+    print(_diagnosticTable(
+      ["samples", "p50 ticks", "p99 ticks", "total ticks"],
+      histograms().prefix(count).map { histogram in (histogram.address, [
+        histogram.sampleCount,
+        histogram.percentile(0.5),
+        histogram.percentile(0.99),
+        histogram.estimatedTicks,
+      ]) }))
+  }
+}
+#endif // ATOMICS_CONTENTION_PROFILING
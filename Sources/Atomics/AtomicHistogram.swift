@@ -0,0 +1,287 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import _AtomicsShims
+
+// A log-linear histogram, in the style of G. Tene's HdrHistogram.
+//
+// With `m` significant bits, values below `2^m` get a bucket each. Above
+// that, every power-of-two range `[2^k, 2^(k+1))` is split into `2^(m-1)`
+// equally sized buckets, so a bucket's width is never more than `2^-(m-1)`
+// times its lower bound. The index of a bucket is computed from the
+// position of the value's most significant bit and the `m` bits below it,
+// without any loops or floating point arithmetic.
+//
+// The counters are laid out in two banks, each split into stripes. A
+// stripe holds one counter per bucket, padded to a whole number of cache
+// lines; threads record into the stripe selected by their identity, which
+// keeps recording threads from contending on the same cache lines.
+//
+// Recording loads the index of the active bank, then increments a counter
+// in it, using relaxed ordering throughout. A reset switches the active
+// bank, then drains the old one by exchanging its counters with zero. A
+// thread that loaded the old bank index just before the switch may still
+// increment a counter in the old bank after it was drained; that sample
+// stays there, and is included in the snapshot that drains the bank the
+// next time. Samples are never lost; at worst they are reported one
+// interval late.
+
+/// A histogram of `UInt64` values that many threads can record into
+/// concurrently, without locks.
+///
+/// The histogram uses log-linear buckets, so values are tracked with a
+/// bounded relative error over the full range of `UInt64`:
+///
+///     let latencies = AtomicHistogram(significantBits: 7)
+///
+///     // On any thread:
+///     latencies.record(elapsedNanoseconds)
+///
+///     // Periodically, on a monitoring thread:
+///     let interval = latencies.snapshotAndReset()
+///     print(interval.value(atPercentile: 99.9))
+///
+/// Recording a value takes a single relaxed atomic increment of a counter
+/// (plus a relaxed load of the active bank's index). Snapshots are
+/// `AtomicHistogram.Snapshot` values, which can be merged and queried for
+/// percentiles.
+public final class AtomicHistogram {
+  /// The number of significant binary digits of recorded values that the
+  /// histogram preserves.
+  public let significantBits: Int
+
+  /// The number of stripes per bank.
+  public let stripeCount: Int
+
+  /// The number of buckets.
+  public let bucketCount: Int
+
+  private let _stripeStride: Int
+  private let _phase = ManagedAtomic<Int>(0)
+  private let _counters: UnsafeAtomicBuffer<UInt64>
+
+  /// Creates an empty histogram.
+  ///
+  /// - Parameter significantBits: The number of significant binary digits
+  ///   preserved; recorded values are accurate to within `2^-(bits - 1)` of
+  ///   their value. This must be between 1 and 16. The default of 7 gives
+  ///   an accuracy of about 1.6%, using 3,776 buckets.
+  /// - Parameter stripeCount: The number of stripes that recording threads
+  ///   are spread across. The default is the number of online processors,
+  ///   up to 8.
+  public init(significantBits: Int = 7, stripeCount: Int? = nil) {
+    precondition(
+      significantBits >= 1 && significantBits <= 16,
+      "Invalid number of significant bits")
+    let stripes = stripeCount
+      ?? Swift.min(8, Int(_sa_processor_count()))
+    precondition(stripes > 0, "Invalid stripe count")
+    let buckets = Snapshot._bucketCount(significantBits: significantBits)
+    typealias Storage = UInt64.AtomicRepresentation
+    let perLine = 64 / MemoryLayout<Storage>.stride
+    let stride = (buckets + perLine - 1) / perLine * perLine
+    self.significantBits = significantBits
+    self.stripeCount = stripes
+    self.bucketCount = buckets
+    self._stripeStride = stride
+
+    let count = 2 * stripes * stride
+    let base = UnsafeMutableRawPointer.allocate(
+      byteCount: count * MemoryLayout<Storage>.stride,
+      alignment: 64
+    ).bindMemory(to: Storage.self, capacity: count)
+    base.initialize(repeating: Storage(0), count: count)
+    _counters = UnsafeAtomicBuffer(at: base, count: count)
+  }
+
+  deinit {
+    // The counters are trivial, so there is nothing to dispose of.
+    _counters._base.deinitialize(count: _counters.count)
+    _counters._base.deallocate()
+  }
+
+  private func _stripe(bank: Int, stripe: Int) -> Int {
+    (bank * stripeCount + stripe) * _stripeStride
+  }
+
+  private var _currentStripe: Int {
+    guard stripeCount > 1 else { return 0 }
+    let thread = UInt(_sa_thread_id())
+    // Thread identifiers are aligned addresses; mix the bits.
+    let hash = (thread >> 4) &* 0x9E3779B9
+    return Int(bitPattern: (hash >> 8) % UInt(stripeCount))
+  }
+
+  /// Records `count` occurrences of `value`.
+  public func record(_ value: UInt64, count: UInt64 = 1) {
+    let bank = _phase.load(ordering: .relaxed)
+    let bucket = Snapshot._bucketIndex(value, significantBits: significantBits)
+    _counters[_stripe(bank: bank, stripe: _currentStripe) + bucket]
+      .wrappingIncrement(by: count, ordering: .relaxed)
+  }
+
+  /// Returns the values recorded since the last reset.
+  ///
+  /// This doesn't stop other threads from recording values, so samples
+  /// recorded concurrently may or may not be included.
+  public func snapshot() -> Snapshot {
+    var result = Snapshot(significantBits: significantBits)
+    for bank in 0 ..< 2 {
+      _accumulate(bank: bank, into: &result, reset: false)
+    }
+    return result
+  }
+
+  /// Returns the values recorded since the last reset, and resets the
+  /// histogram.
+  ///
+  /// Each recorded sample is included in exactly one of the snapshots
+  /// returned by successive calls; samples recorded concurrently with a
+  /// reset may be reported by the next one.
+  public func snapshotAndReset() -> Snapshot {
+    let old = _phase.loadThenBitwiseXor(with: 1, ordering: .relaxed)
+    var result = Snapshot(significantBits: significantBits)
+    _accumulate(bank: old, into: &result, reset: true)
+    return result
+  }
+
+  private func _accumulate(
+    bank: Int,
+    into result: inout Snapshot,
+    reset: Bool
+  ) {
+    for stripe in 0 ..< stripeCount {
+      let start = _stripe(bank: bank, stripe: stripe)
+      for bucket in 0 ..< bucketCount {
+        let counter = _counters[start + bucket]
+        let count = reset
+          ? counter.exchange(0, ordering: .relaxed)
+          : counter.load(ordering: .relaxed)
+        result._counts[bucket] &+= count
+        result.totalCount &+= count
+      }
+    }
+  }
+}
+
+extension AtomicHistogram {
+  /// The counts of a histogram at a point in time.
+  public struct Snapshot: Equatable {
+    /// The number of significant binary digits of recorded values that the
+    /// histogram preserves.
+    public let significantBits: Int
+
+    /// The total number of recorded values.
+    public internal(set) var totalCount: UInt64 = 0
+
+    internal var _counts: [UInt64]
+
+    /// Creates an empty snapshot.
+    public init(significantBits: Int) {
+      precondition(
+        significantBits >= 1 && significantBits <= 16,
+        "Invalid number of significant bits")
+      self.significantBits = significantBits
+      self._counts = Array(
+        repeating: 0,
+        count: Snapshot._bucketCount(significantBits: significantBits))
+    }
+
+    /// Returns the number of recorded values that fall into the same bucket
+    /// as `value`.
+    public func count(near value: UInt64) -> UInt64 {
+      _counts[Snapshot._bucketIndex(value, significantBits: significantBits)]
+    }
+
+    /// Adds the counts of `other` to this snapshot. Both snapshots must
+    /// have the same number of significant bits.
+    public mutating func merge(_ other: Snapshot) {
+      precondition(
+        other.significantBits == significantBits,
+        "Mismatching histogram precision")
+      for bucket in _counts.indices {
+        _counts[bucket] &+= other._counts[bucket]
+      }
+      totalCount &+= other.totalCount
+    }
+
+    /// Returns the value at the given percentile (between 0 and 100) of the
+    /// recorded values, or zero if there are none.
+    ///
+    /// The result is the highest value in the bucket that contains the
+    /// percentile, so it is never less than the true value.
+    public func value(atPercentile percentile: Double) -> UInt64 {
+      precondition(percentile >= 0 && percentile <= 100, "Invalid percentile")
+      guard totalCount > 0 else { return 0 }
+      let exact = (percentile / 100 * Double(totalCount)).rounded(.up)
+      let target = Swift.max(1, Swift.min(totalCount, UInt64(exact)))
+      var seen: UInt64 = 0
+      for bucket in _counts.indices {
+        seen &+= _counts[bucket]
+        if seen >= target {
+          return _highestValue(inBucket: bucket)
+        }
+      }
+      return _highestValue(inBucket: _counts.count - 1)
+    }
+
+    /// The lowest recorded value, rounded down to its bucket's lower bound,
+    /// or nil if there are none.
+    public var minimum: UInt64? {
+      guard let bucket = _counts.firstIndex(where: { $0 > 0 }) else {
+        return nil
+      }
+      return _lowestValue(inBucket: bucket)
+    }
+
+    /// The highest recorded value, rounded up to its bucket's upper bound,
+    /// or nil if there are none.
+    public var maximum: UInt64? {
+      guard let bucket = _counts.lastIndex(where: { $0 > 0 }) else {
+        return nil
+      }
+      return _highestValue(inBucket: bucket)
+    }
+  }
+}
+
+extension AtomicHistogram.Snapshot {
+  internal static func _bucketCount(significantBits: Int) -> Int {
+    (66 - significantBits) &<< (significantBits - 1)
+  }
+
+  @inline(__always)
+  internal static func _bucketIndex(
+    _ value: UInt64,
+    significantBits: Int
+  ) -> Int {
+    // `shift` is the number of low bits dropped from `value`.
+    let shift = (UInt64.bitWidth - 1 - value.leadingZeroBitCount)
+      - (significantBits - 1)
+    guard shift > 0 else { return Int(truncatingIfNeeded: value) }
+    let mantissa = Int(truncatingIfNeeded: value &>> UInt64(shift))
+    return shift &<< (significantBits - 1) &+ mantissa
+  }
+
+  internal func _lowestValue(inBucket bucket: Int) -> UInt64 {
+    let half = 1 &<< (significantBits - 1)
+    guard bucket >= 2 * half else { return UInt64(bucket) }
+    let shift = bucket / half - 1
+    let mantissa = bucket - shift * half
+    return UInt64(mantissa) &<< UInt64(shift)
+  }
+
+  internal func _highestValue(inBucket bucket: Int) -> UInt64 {
+    guard bucket < _counts.count - 1 else { return .max }
+    return _lowestValue(inBucket: bucket + 1) - 1
+  }
+}
@@ -0,0 +1,271 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#if ATOMICS_INSTRUMENTATION
+import _AtomicsShims
+
+/// Diagnostic counters for atomic operations, for tracking down contended
+/// atomic values.
+///
+/// Instrumentation is only available in builds that define the
+/// `ATOMICS_INSTRUMENTATION` compilation condition:
+///
+///     $ swift build -Xswiftc -DATOMICS_INSTRUMENTATION
+///
+/// In such builds, every atomic operation on a storage location counts
+/// itself in a table that is private to the current thread, keyed by the
+/// address of the location. Loads, stores and read-modify-write operations
+/// (exchanges, compare-exchanges and integer/boolean operations) are counted
+/// separately, along with the number of compare-exchange attempts that
+/// failed.
+///
+/// Use `topContended(_:)` or `dump(top:)` to get the locations with the most
+/// failed compare-exchange operations and read-modify-write operations,
+/// summed over all threads.
+///
+/// Note: The counters are meant for diagnostics only. Reports that are taken
+/// while other threads are running may not include their most recent
+/// operations, and `reset()` may miss operations that are concurrent with
+/// it.
+public enum AtomicInstrumentation {
+  /// Operation counts for a single atomic storage location.
+  public struct Entry {
+    /// The address of the atomic storage location, or nil for operations on
+    /// locations that didn't fit into a thread's counter table.
+    public let address: UnsafeRawPointer?
+
+    /// The number of atomic loads.
+    public internal(set) var loads: Int = 0
+
+    /// The number of atomic stores.
+    public internal(set) var stores: Int = 0
+
+    /// The number of atomic read-modify-write operations, including failed
+    /// compare-exchange operations.
+    public internal(set) var readModifyWrites: Int = 0
+
+    /// The number of compare-exchange operations that failed to update the
+    /// location.
+    public internal(set) var failedCompareExchanges: Int = 0
+
+    internal init(address: UnsafeRawPointer?) {
+      self.address = address
+    }
+  }
+
+  /// Returns the operation counts of all atomic storage locations that have
+  /// been accessed since the last reset, summed over all threads.
+  public static func entries() -> [Entry] {
+    var entries: [UInt: Entry] = [:]
+    _registry.forEachBuffer { buffer in
+      buffer.forEachSlot { key, counters in
+        var entry = entries[key]
+          ?? Entry(address: UnsafeRawPointer(bitPattern: key))
+        entry.loads += counters[_Event.load.rawValue]
+        entry.stores += counters[_Event.store.rawValue]
+        entry.readModifyWrites += counters[_Event.readModifyWrite.rawValue]
+        entry.failedCompareExchanges +=
+          counters[_Event.failedReadModifyWrite.rawValue]
+        entries[key] = entry
+      }
+    }
+    return Array(entries.values)
+  }
+
+  /// Returns the (at most) `count` most contended atomic storage locations,
+  /// ordered by decreasing number of failed compare-exchange operations,
+  /// then by decreasing number of read-modify-write operations.
+  public static func topContended(_ count: Int = 10) -> [Entry] {
+    let sorted = entries().sorted { a, b in
+      if a.failedCompareExchanges != b.failedCompareExchanges {
+        return a.failedCompareExchanges > b.failedCompareExchanges
+      }
+      if a.readModifyWrites != b.readModifyWrites {
+        return a.readModifyWrites > b.readModifyWrites
+      }
+      return a.loads + a.stores > b.loads + b.stores
+    }
+    return Array(sorted.prefix(count))
+  }
+
+  /// Prints a table of the (at most) `count` most contended atomic storage
+  /// locations to the standard output.
+  public static func dump(top count: Int = 10) {
+    print(_diagnosticTable(
+      ["loads", "stores", "rmws", "failed cas"],
+      topContended(count).map { entry in (entry.address, [
+        entry.loads,
+        entry.stores,
+        entry.readModifyWrites,
+        entry.failedCompareExchanges,
+      ]) }))
+  }
+
+  /// Clears all counters.
+  public static func reset() {
+    _registry.forEachBuffer { $0.reset() }
+  }
+}
+
+extension AtomicInstrumentation {
+  /// The kinds of events that are counted. Raw values are counter indices
+  /// within a slot of `_Buffer`.
+  @usableFromInline
+  internal enum _Event: Int {
+    case load = 1
+    case store = 2
+    case readModifyWrite = 3
+    case failedReadModifyWrite = 4
+  }
+
+  @inlinable @inline(__always)
+  internal static func _record<Storage>(
+    _ event: _Event,
+    at pointer: UnsafeMutablePointer<Storage>
+  ) {
+    _record(event, address: UInt(bitPattern: pointer))
+  }
+
+  @usableFromInline
+  internal static func _record(_ event: _Event, address: UInt) {
+    _currentBuffer().record(event, address: address)
+  }
+
+  internal static func _currentBuffer() -> _Buffer {
+    _ThreadLocalRegistry.entry(_Buffer.self, orInsert: { _registry.acquire() })
+  }
+}
+
+extension AtomicInstrumentation {
+  /// A per-thread table of operation counters.
+  ///
+  /// The table consists of `capacity` slots (plus one for overflows), indexed
+  /// by a hash of the storage address, with linear probing. Each slot holds
+  /// the address followed by one counter for each kind of event. Only the
+  /// thread owning the buffer ever increments its counters, so these can
+  /// be updated by relaxed loads and stores instead of read-modify-write
+  /// operations; other threads only read them.
+  ///
+  /// A thread's buffer is an entry in its per-thread registry; when the
+  /// thread exits, the buffer goes back to `_registry` for reuse.
+  internal final class _Buffer: _ThreadLocalEntry {
+    static let capacity = 1024
+    static let maxProbes = 32
+    static let slotWidth = 5
+
+    let words: UnsafeMutablePointer<_AtomicUIntStorage>
+
+    init() {
+      let count = (_Buffer.capacity + 1) * _Buffer.slotWidth
+      words = UnsafeMutablePointer.allocate(capacity: count)
+      words.initialize(repeating: _sa_prepare_UInt(0), count: count)
+    }
+
+    deinit {
+      words.deinitialize(count: (_Buffer.capacity + 1) * _Buffer.slotWidth)
+      words.deallocate()
+    }
+
+    func threadDidExit() {
+      _registry.relinquish(self)
+    }
+
+    func record(_ event: _Event, address: UInt) {
+      let slot = self.slot(for: address)
+      increment(slot + event.rawValue)
+      if event == .failedReadModifyWrite {
+        increment(slot + _Event.readModifyWrite.rawValue)
+      }
+    }
+
+    private func increment(_ counter: UnsafeMutablePointer<_AtomicUIntStorage>) {
+      _sa_store_relaxed_UInt(counter, _sa_load_relaxed_UInt(counter) &+ 1)
+    }
+
+    private func slot(
+      for address: UInt
+    ) -> UnsafeMutablePointer<_AtomicUIntStorage> {
+      var index = Int(bitPattern: (address >> 3) ^ (address >> 13))
+      for _ in 0 ..< _Buffer.maxProbes {
+        index &= _Buffer.capacity - 1
+        let slot = words + index * _Buffer.slotWidth
+        let key = _sa_load_relaxed_UInt(slot)
+        if key == address { return slot }
+        if key == 0 {
+          _sa_store_relaxed_UInt(slot, address)
+          return slot
+        }
+        index += 1
+      }
+      // The table is too crowded; count this location in the overflow slot.
+      return words + _Buffer.capacity * _Buffer.slotWidth
+    }
+
+    func forEachSlot(_ body: (UInt, [Int]) -> Void) {
+      for index in 0 ... _Buffer.capacity {
+        let slot = words + index * _Buffer.slotWidth
+        let key = _sa_load_relaxed_UInt(slot)
+        guard key != 0 || index == _Buffer.capacity else { continue }
+        let counters = (0 ..< _Buffer.slotWidth).map {
+          $0 == 0 ? 0 : Int(bitPattern: _sa_load_relaxed_UInt(slot + $0))
+        }
+        guard counters.contains(where: { $0 != 0 }) else { continue }
+        body(key, counters)
+      }
+    }
+
+    func reset() {
+      for index in 0 ... _Buffer.capacity {
+        let slot = words + index * _Buffer.slotWidth
+        for counter in 1 ..< _Buffer.slotWidth {
+          _sa_store_relaxed_UInt(slot + counter, 0)
+        }
+      }
+    }
+  }
+
+  /// The set of all buffers ever allocated. Buffers of exited threads are
+  /// kept (with their counts), and reused by new threads.
+  internal final class _Registry {
+    // A shim lock rather than one built on this package's atomics, which
+    // would count their own operations while the lock is held.
+    private let lock = _sa_lock_create()!
+    private var buffers: [_Buffer] = []
+    private var available: [_Buffer] = []
+
+    private func withLock<R>(_ body: () throws -> R) rethrows -> R {
+      _sa_lock_acquire(lock)
+      defer { _sa_lock_release(lock) }
+      return try body()
+    }
+
+    func acquire() -> _Buffer {
+      withLock {
+        if let buffer = available.popLast() { return buffer }
+        let buffer = _Buffer()
+        buffers.append(buffer)
+        return buffer
+      }
+    }
+
+    func relinquish(_ buffer: _Buffer) {
+      withLock { available.append(buffer) }
+    }
+
+    func forEachBuffer(_ body: (_Buffer) -> Void) {
+      withLock { buffers.forEach(body) }
+    }
+  }
+}
+
+private let _registry = AtomicInstrumentation._Registry()
+#endif // ATOMICS_INSTRUMENTATION
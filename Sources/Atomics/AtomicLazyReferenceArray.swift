@@ -0,0 +1,133 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+/// An unsafe, fixed-size array of lazily initializable atomic strong
+/// references, requiring manual memory management of the underlying
+/// storage.
+///
+/// The references are stored contiguously, one word each, in a single
+/// allocation. This is much more compact than an array of separately
+/// allocated `ManagedAtomicLazyReference` instances, which makes it a good
+/// fit for large tables of lazily created objects, such as per-key caches.
+///
+/// Each element can be set (initialized) exactly once, but read many times.
+///
+///     let cache = UnsafeAtomicLazyReferenceArray<Entry>.create(count: 4096)
+///     defer { cache.destroy() }
+///
+///     func entry(for key: Int) -> Entry {
+///       let slot = key & 4095
+///       if let entry = cache.load(at: slot) { return entry }
+///       return cache.storeIfNilThenLoad(Entry(key), at: slot)
+///     }
+@frozen
+public struct UnsafeAtomicLazyReferenceArray<Instance: AnyObject> {
+  /// The storage representation of an element.
+  public typealias Storage = UnsafeAtomicLazyReference<Instance>.Storage
+
+  @usableFromInline
+  internal let _base: UnsafeMutablePointer<Storage>
+
+  /// The number of elements in the array.
+  public let count: Int
+
+  /// Initialize an unsafe atomic lazy reference array that uses the supplied
+  /// memory locations for storage. The `count` storage locations starting at
+  /// `base` must already be initialized to represent valid atomic lazy
+  /// references.
+  ///
+  /// At the end of the lifetime of the array, you must manually ensure that
+  /// the storage locations are correctly `dispose()`d, deinitalized and
+  /// deallocated.
+  ///
+  /// Note: This is not an atomic operation.
+  @inlinable
+  public init(@_nonEphemeral at base: UnsafeMutablePointer<Storage>, count: Int) {
+    precondition(count >= 0, "Negative count")
+    self._base = base
+    self.count = count
+  }
+}
+
+extension UnsafeAtomicLazyReferenceArray {
+  /// Create a new array of `count` nil references by dynamically allocating
+  /// storage for it.
+  ///
+  /// This call is usually paired with `destroy` to get rid of the allocated
+  /// storage at the end of its lifetime.
+  ///
+  /// Note: This is not an atomic operation.
+  @inlinable
+  public static func create(count: Int) -> Self {
+    let base = UnsafeMutablePointer<Storage>.allocate(capacity: count)
+    base.initialize(repeating: Storage(), count: count)
+    return Self(at: base, count: count)
+  }
+
+  /// Disposes of the current values of all elements, resetting them to
+  /// nil.
+  ///
+  /// Note: This is not an atomic operation.
+  ///
+  /// - Returns: The number of elements that were initialized.
+  @inlinable
+  @discardableResult
+  public func disposeAll() -> Int {
+    var initialized = 0
+    for index in 0 ..< count where _base[index].dispose() != nil {
+      initialized += 1
+    }
+    return initialized
+  }
+
+  /// Disposes of the current values of all elements, then deinitializes and
+  /// deallocates the storage.
+  ///
+  /// Note: This is not an atomic operation.
+  @inlinable
+  public func destroy() {
+    disposeAll()
+    _base.deinitialize(count: count)
+    _base.deallocate()
+  }
+
+  /// Returns an atomic lazy reference view of the element at `index`.
+  @inlinable
+  public subscript(index: Int) -> UnsafeAtomicLazyReference<Instance> {
+    precondition(index >= 0 && index < count, "Index out of range")
+    return UnsafeAtomicLazyReference(at: _base + index)
+  }
+
+  /// Atomically initializes the element at `index` if its current value is
+  /// nil, then returns the initialized value. If the element is already
+  /// initialized, then this discards its supplied argument and returns the
+  /// current value without updating it.
+  ///
+  /// This operation uses acquiring-and-releasing memory ordering.
+  @inlinable
+  public func storeIfNilThenLoad(
+    _ desired: __owned Instance,
+    at index: Int
+  ) -> Instance {
+    self[index].storeIfNilThenLoad(desired)
+  }
+
+  /// Atomically loads and returns the current value of the element at
+  /// `index`.
+  ///
+  /// The load operation is performed with the memory ordering
+  /// `AtomicLoadOrdering.acquiring`.
+  @inlinable
+  public func load(at index: Int) -> Instance? {
+    self[index].load()
+  }
+}
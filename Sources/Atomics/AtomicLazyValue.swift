@@ -0,0 +1,208 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import _AtomicsShims
+
+/// An unsafe type holding a lazily initializable value of any type,
+/// requiring manual memory management of the underlying storage
+/// representation.
+///
+/// This is the counterpart of `UnsafeAtomicLazyReference` for values that
+/// aren't class instances. The value is stored inline, next to a state word
+/// that publishes it; once initialized, reading it only takes an acquiring
+/// load of the state word, and `withUnsafeLoadedValue(_:)` gives access to
+/// it without copying it (or retaining any references it contains).
+///
+/// These values can be set (initialized) exactly once, but read many
+/// times.
+@frozen
+public struct UnsafeAtomicLazyValue<Value> {
+  @usableFromInline
+  internal let _ptr: UnsafeMutablePointer<Storage>
+
+  /// Initialize an unsafe atomic lazy value that uses the supplied memory
+  /// location for storage. The storage location must already be initialized
+  /// to represent a valid atomic value.
+  ///
+  /// At the end of the lifetime of the atomic value, you must manually ensure
+  /// that the storage location is correctly `dispose()`d, deinitalized and
+  /// deallocated.
+  ///
+  /// Note: This is not an atomic operation.
+  @_transparent // Debug performance
+  public init(@_nonEphemeral at pointer: UnsafeMutablePointer<Storage>) {
+    _ptr = pointer
+  }
+}
+
+extension UnsafeAtomicLazyValue {
+  /// The storage representation for an atomic lazy value.
+  @frozen
+  public struct Storage {
+    // The state must be the first stored property.
+    @usableFromInline
+    internal var _state: Int.AtomicRepresentation
+
+    @usableFromInline
+    internal var _value: Value?
+
+    /// Initialize a new atomic lazy value storage value holding `nil`.
+    ///
+    /// Note: This is not an atomic operation.
+    @inlinable @inline(__always)
+    public init() {
+      _state = Int.AtomicRepresentation(UnsafeAtomicLazyValue._empty)
+      _value = nil
+    }
+
+    /// Prepare this atomic storage value for deinitialization, extracting the
+    /// logical value it represents. This invalidates this atomic storage; you
+    /// must not perform any operations on it after this call (except for
+    /// deinitialization).
+    ///
+    /// Note: This is not an atomic operation. Logically, it implements a
+    /// custom destructor for the underlying non-copiable value.
+    @inlinable @inline(__always)
+    @discardableResult
+    public mutating func dispose() -> Value? {
+      _ = _state.dispose()
+      _state = Int.AtomicRepresentation(UnsafeAtomicLazyValue._empty)
+      defer { _value = nil }
+      return _value
+    }
+  }
+}
+
+extension UnsafeAtomicLazyValue {
+  @usableFromInline internal static var _empty: Int { 0 }
+  @usableFromInline internal static var _storing: Int { 1 }
+  @usableFromInline internal static var _ready: Int { 2 }
+
+  @_alwaysEmitIntoClient @inline(__always)
+  internal var _state: UnsafeAtomic<Int> {
+    // `_state` is the first stored property of `Storage`.
+    UnsafeAtomic(
+      at: UnsafeMutableRawPointer(_ptr)
+        .assumingMemoryBound(to: Int.AtomicRepresentation.self))
+  }
+
+  @_alwaysEmitIntoClient @inline(__always)
+  internal var _value: UnsafeMutablePointer<Value?> {
+    // `_value` follows `_state`, aligned as needed.
+    let alignment = MemoryLayout<Value?>.alignment
+    let size = MemoryLayout<Int.AtomicRepresentation>.size
+    let offset = (size + alignment - 1) / alignment * alignment
+    return (UnsafeMutableRawPointer(_ptr) + offset)
+      .assumingMemoryBound(to: Value?.self)
+  }
+}
+
+extension UnsafeAtomicLazyValue {
+  /// Create a new `UnsafeAtomicLazyValue` value by dynamically allocating
+  /// storage for it.
+  ///
+  /// This call is usually paired with `destroy` to get rid of the allocated
+  /// storage at the end of its lifetime.
+  ///
+  /// Note: This is not an atomic operation.
+  @inlinable
+  public static func create() -> Self {
+    let ptr = UnsafeMutablePointer<Storage>.allocate(capacity: 1)
+    ptr.initialize(to: Storage())
+    return Self(at: ptr)
+  }
+
+  /// Disposes of the current value of the storage location corresponding to
+  /// this unsafe atomic lazy value, then deinitializes and deallocates the
+  /// storage.
+  ///
+  /// Note: This is not an atomic operation.
+  ///
+  /// - Returns: The last value stored in the storage representation before it
+  ///   was destroyed.
+  @discardableResult
+  @inlinable
+  public func destroy() -> Value? {
+    defer {
+      _ptr.deinitialize(count: 1)
+      _ptr.deallocate()
+    }
+    return _ptr.pointee.dispose()
+  }
+}
+
+extension UnsafeAtomicLazyValue {
+  /// Atomically initializes this value if it hasn't been initialized yet,
+  /// then returns the initialized value. If it is already initialized, then
+  /// `storeIfNilThenLoad(_:)` discards its supplied argument and returns the
+  /// current value without updating it.
+  ///
+  /// If another thread is in the middle of storing its value, this waits
+  /// for it to finish (which only takes as long as copying the value).
+  ///
+  /// This operation uses acquiring-and-releasing memory ordering.
+  @inlinable
+  public func storeIfNilThenLoad(_ desired: __owned Value) -> Value {
+    let (exchanged, current) = _state.compareExchange(
+      expected: Self._empty,
+      desired: Self._storing,
+      ordering: .acquiring)
+    if exchanged {
+      _value.pointee = desired
+      _state.store(Self._ready, ordering: .releasing)
+      return desired
+    }
+    if current != Self._ready {
+      _waitUntilReady()
+    }
+    return _value.pointee!
+  }
+
+  @usableFromInline
+  internal func _waitUntilReady() {
+    while _state.load(ordering: .acquiring) != Self._ready {
+      _sa_thread_yield()
+    }
+  }
+
+  /// Atomically loads and returns the current value, or nil if it hasn't
+  /// been initialized yet.
+  ///
+  /// The load operation is performed with the memory ordering
+  /// `AtomicLoadOrdering.acquiring`.
+  @inlinable
+  public func load() -> Value? {
+    guard _state.load(ordering: .acquiring) == Self._ready else { return nil }
+    return _value.pointee
+  }
+
+  /// Calls `body` with a pointer to the current value, and returns its
+  /// result; or returns nil if the value hasn't been initialized yet.
+  ///
+  /// This gives access to the value in place, without copying it (and
+  /// retaining any references it holds). The pointer must not be used after
+  /// `body` returns.
+  ///
+  /// The load operation is performed with the memory ordering
+  /// `AtomicLoadOrdering.acquiring`.
+  @inlinable
+  public func withUnsafeLoadedValue<Result>(
+    _ body: (UnsafePointer<Value>) throws -> Result
+  ) rethrows -> Result? {
+    guard _state.load(ordering: .acquiring) == Self._ready else { return nil }
+    // The payload of a single-payload enum like `Optional` is stored at its
+    // start (this is part of Swift's stable ABI), and the value is known to
+    // be present.
+    return try body(
+      UnsafeRawPointer(_value).assumingMemoryBound(to: Value.self))
+  }
+}
@@ -310,6 +310,12 @@ extension AtomicUpdateOrdering: CustomStringConvertible {
 public func atomicMemoryFence(
   ordering: AtomicUpdateOrdering
 ) {
+#if ATOMICS_MODEL_CHECKING
+  if _AtomicModel.isActive {
+    _AtomicModel.fence(ordering: ordering)
+    return
+  }
+#endif
   switch ordering {
   case .relaxed: break
   case .acquiring: _sa_thread_fence_acquire()
@@ -0,0 +1,794 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#if ATOMICS_MODEL_CHECKING
+import _AtomicsShims
+
+/// A deterministic model checker for concurrent code built on this package's
+/// atomic operations.
+///
+/// The model checker is only available in builds that define the
+/// `ATOMICS_MODEL_CHECKING` compilation condition:
+///
+///     $ swift test -Xswiftc -DATOMICS_MODEL_CHECKING
+///
+/// In such builds, every atomic operation and memory fence executed by a
+/// thread started by `explore` is routed through a scheduler that runs one
+/// thread at a time, and switches between threads only at atomic operations.
+/// Each execution of the test makes a series of choices:
+///
+/// - which thread runs next after every atomic operation, and
+/// - which value a relaxed or acquiring load reads: any store that is not
+///   older than what the loading thread has already observed (by coherence
+///   or through happens-before relationships) is a possible result, not
+///   just the most recent one.
+///
+/// Happens-before relationships are tracked with vector clocks, following
+/// the release/acquire rules of the C11 memory model, including fences and
+/// release sequences continued by read-modify-write operations. Exploring
+/// stale loads lets tests find missing acquire/release orderings even on
+/// strongly ordered hardware like x86.
+///
+/// Sequentially consistent operations and fences follow the C++20 rules for
+/// the single total order `S`, taking `S` to be the order in which the
+/// execution performs them: a sequentially consistent load never reads a
+/// store older than the last one that a sequentially consistent operation
+/// on the same location wrote or read, and a sequentially consistent fence
+/// makes everything its thread observed before it visible to sequentially
+/// consistent operations after it (and everything observed before earlier
+/// fences visible to its thread).
+///
+/// Limitations:
+///
+/// - Weak compare-exchange operations never fail spuriously.
+/// - Non-atomic memory accesses are not tracked, so data races on regular
+///   variables are not detected, and code that blocks outside of atomic
+///   operations (for example, on a mutex) must not be used in tested threads.
+/// - Spin loops must call `AtomicModelChecker.yield()`; otherwise they may
+///   exhaust the step limit of an execution.
+public enum AtomicModelChecker {
+  /// The way executions are chosen.
+  public enum Strategy {
+    /// Run the given number of executions, making every choice at random.
+    /// Random exploration finds most bugs quickly, but it cannot prove their
+    /// absence.
+    case random(executions: Int, seed: UInt64? = nil)
+
+    /// Systematically run every possible execution, up to `maxExecutions`.
+    ///
+    /// If `preemptionBound` isn't nil, only executions that preempt running
+    /// threads at most that many times are explored. (Switching away from a
+    /// thread that finished or called `yield()` is not a preemption.) Most
+    /// concurrency bugs need only a couple of preemptions to manifest.
+    case exhaustive(preemptionBound: Int? = 2, maxExecutions: Int = 100_000)
+
+    /// Rerun the single execution described by a failure's `schedule`.
+    case replay([Int])
+  }
+
+  /// The outcome of exploring a test.
+  public struct Report {
+    /// The number of executions that were run.
+    public let executions: Int
+
+    /// True if the exhaustive strategy explored every execution within its
+    /// preemption bound.
+    public let isComplete: Bool
+
+    /// The first failing execution, or nil if none was found.
+    public let failure: Failure?
+  }
+
+  /// An execution that failed verification or exceeded its step limit.
+  public struct Failure: CustomStringConvertible {
+    /// The choices made during the execution. Pass this to the `.replay`
+    /// strategy to reproduce the failure.
+    public let schedule: [Int]
+
+    /// A log of the atomic operations in the execution, in the order they
+    /// were performed.
+    public let trace: [String]
+
+    /// A short explanation of the failure.
+    public let reason: String
+
+    public var description: String {
+      """
+      \(reason)
+      Schedule: \(schedule)
+      \(trace.joined(separator: "\n"))
+      """
+    }
+  }
+
+  /// Repeatedly runs a concurrent test under the model checker.
+  ///
+  /// Each execution calls `setUp` to create a fresh test state, then runs
+  /// `body` on `threads` separate threads (passing each its index), and
+  /// finally calls `verify` to check the result once all threads have
+  /// finished. Exploration stops at the first execution for which `verify`
+  /// returns false.
+  ///
+  /// Atomic operations in `setUp` and `verify` are not modeled; they are
+  /// simply performed on memory.
+  ///
+  /// `maxSteps` limits the number of atomic operations in a single execution,
+  /// to catch livelocks. An execution that exceeds it is reported as failed.
+  public static func explore<State>(
+    _ strategy: Strategy = .random(executions: 1000),
+    threads: Int,
+    maxSteps: Int = 10_000,
+    setUp: () -> State,
+    thread body: (State, Int) -> Void,
+    verify: (State) -> Bool
+  ) -> Report {
+    var sites: [UInt: _SiteUsage] = [:]
+    return _explore(
+      strategy,
+      threads: threads,
+      maxSteps: maxSteps,
+      overrides: [:],
+      sites: &sites,
+      setUp: setUp,
+      thread: body,
+      verify: verify)
+  }
+
+  /// Implements `explore`, replacing the orderings of the call sites in
+  /// `overrides`, and collecting the orderings used by each call site in
+  /// `sites`.
+  internal static func _explore<State>(
+    _ strategy: Strategy,
+    threads: Int,
+    maxSteps: Int,
+    overrides: [UInt: Int],
+    sites: inout [UInt: _SiteUsage],
+    setUp: () -> State,
+    thread body: (State, Int) -> Void,
+    verify: (State) -> Bool
+  ) -> Report {
+    precondition(threads > 0, "Need at least one thread")
+    var prefix: [_Choice] = []
+    var random: _Random? = nil
+    let limit: Int
+    let preemptionBound: Int?
+    switch strategy {
+    case let .random(executions: executions, seed: seed):
+      limit = executions
+      preemptionBound = nil
+      random = _Random(seed: seed ?? UInt64.random(in: 0 ... .max))
+    case let .exhaustive(preemptionBound: bound, maxExecutions: executions):
+      limit = executions
+      preemptionBound = bound
+    case let .replay(schedule):
+      limit = 1
+      preemptionBound = nil
+      prefix = schedule.map { _Choice(taken: $0, count: .max) }
+    }
+
+    var executions = 0
+    while executions < limit {
+      executions += 1
+      let execution = _Execution(
+        threads: threads,
+        maxSteps: maxSteps,
+        preemptionBound: preemptionBound,
+        prefix: prefix,
+        random: random,
+        overrides: overrides)
+      let state = setUp()
+      withoutActuallyEscaping(body) { body in
+        execution.run { body(state, $0) }
+      }
+      random = execution.chooser.random
+      for (site, usage) in execution.sites {
+        sites[site, default: usage].orderings.formUnion(usage.orderings)
+      }
+      let passed = !execution.aborted && verify(state)
+      if !passed {
+        let failure = Failure(
+          schedule: execution.chooser.trace.map { $0.taken },
+          trace: execution.log,
+          reason: execution.aborted
+            ? "Execution exceeded \(maxSteps) steps"
+            : "Verification failed")
+        return Report(
+          executions: executions,
+          isComplete: false,
+          failure: failure)
+      }
+      if random == nil {
+        // Backtrack to the most recent choice that has alternatives left.
+        prefix = execution.chooser.trace
+        while let last = prefix.last, last.taken + 1 >= last.count {
+          prefix.removeLast()
+        }
+        if prefix.isEmpty {
+          return Report(executions: executions, isComplete: true, failure: nil)
+        }
+        prefix[prefix.count - 1].taken += 1
+      }
+    }
+    return Report(executions: executions, isComplete: false, failure: nil)
+  }
+
+  /// Tells the model checker that the current thread cannot make progress
+  /// until another thread does something. Call this in every iteration of
+  /// a spin loop.
+  ///
+  /// Yielding lets other threads run without counting as a preemption, and
+  /// makes the current thread's subsequent loads observe the latest value
+  /// of every location, modeling the fact that stores eventually become
+  /// visible to all threads. (Otherwise a spinning thread could keep
+  /// reading a stale value forever.)
+  ///
+  /// Outside of model-checked threads, this does nothing.
+  public static func yield() {
+    guard
+      let (execution, index) = _AtomicModel._current,
+      execution.schedule(from: index, yielding: true)
+    else { return }
+    let thread = execution.threads[index]
+    for (address, stores) in execution.locations {
+      thread.observed[address] = stores.count - 1
+    }
+  }
+}
+
+internal struct _Choice {
+  var taken: Int
+  var count: Int
+}
+
+/// SplitMix64, so that random explorations are reproducible from their seed.
+internal struct _Random {
+  var state: UInt64
+
+  init(seed: UInt64) {
+    state = seed
+  }
+
+  mutating func next(below bound: Int) -> Int {
+    state &+= 0x9E3779B97F4A7C15
+    var z = state
+    z = (z ^ (z >> 30)) &* 0xBF58476D1CE4E5B9
+    z = (z ^ (z >> 27)) &* 0x94D049BB133111EB
+    z ^= z >> 31
+    return Int(z % UInt64(bound))
+  }
+}
+
+/// Makes and records the choices of a single execution.
+internal final class _Chooser {
+  let prefix: [_Choice]
+  var random: _Random?
+  var trace: [_Choice] = []
+
+  init(prefix: [_Choice], random: _Random?) {
+    self.prefix = prefix
+    self.random = random
+  }
+
+  /// Returns a number in `0 ..< count`. Choice 0 is the one that a sequential
+  /// execution would make.
+  func choose(_ count: Int) -> Int {
+    guard count > 1 else { return 0 }
+    let taken: Int
+    if trace.count < prefix.count {
+      taken = Swift.min(prefix[trace.count].taken, count - 1)
+    } else if random != nil {
+      taken = random!.next(below: count)
+    } else {
+      taken = 0
+    }
+    trace.append(_Choice(taken: taken, count: count))
+    return taken
+  }
+}
+
+/// A vector clock.
+internal struct _Clock {
+  var times: [Int]
+
+  init(threads: Int) {
+    times = Array(repeating: 0, count: threads)
+  }
+
+  mutating func join(_ other: _Clock?) {
+    guard let other = other else { return }
+    for i in times.indices {
+      times[i] = Swift.max(times[i], other.times[i])
+    }
+  }
+}
+
+/// A store in the modification order of an atomic location.
+internal struct _Store {
+  var value: Any
+  /// The storing thread, or -1 for the initial value of the location.
+  var thread: Int
+  /// The storing thread's own time when it performed the store.
+  var time: Int
+  /// The clock that acquiring loads reading this store synchronize with, if
+  /// the store heads (or continues) a release sequence.
+  var release: _Clock?
+}
+
+internal final class _ModelThread {
+  let index: Int
+  var clock: _Clock
+  /// The clock of the latest release fence.
+  var fenceRelease: _Clock? = nil
+  /// The release clocks of stores read by non-acquiring loads, which the
+  /// next acquiring fence synchronizes with.
+  var fenceAcquire: _Clock
+  /// The latest position in the modification order of each location that
+  /// this thread has observed.
+  var observed: [UnsafeRawPointer: Int] = [:]
+  var finished = false
+  var body: ((Int) -> Void)? = nil
+
+  init(index: Int, threads: Int) {
+    self.index = index
+    self.clock = _Clock(threads: threads)
+    self.fenceAcquire = _Clock(threads: threads)
+  }
+
+  func tick() {
+    clock.times[index] += 1
+  }
+}
+
+/// The orderings used by a call site, as raw values shared by all ordering
+/// types.
+internal struct _SiteUsage {
+  let kind: AtomicModelChecker.OperationKind
+  var orderings: Set<Int> = []
+
+  init(kind: AtomicModelChecker.OperationKind) {
+    self.kind = kind
+  }
+}
+
+/// The state of a single execution.
+internal final class _Execution {
+  let chooser: _Chooser
+  let maxSteps: Int
+  let preemptionBound: Int?
+  var threads: [_ModelThread]
+  var locations: [UnsafeRawPointer: [_Store]] = [:]
+  /// The latest position in the modification order of each location that
+  /// was written or read by a sequentially consistent operation, or
+  /// observed by a thread before a sequentially consistent fence. No
+  /// sequentially consistent operation may read an older store.
+  var sequentiallyConsistent: [UnsafeRawPointer: Int] = [:]
+  var log: [String] = []
+  let overrides: [UInt: Int]
+  var sites: [UInt: _SiteUsage] = [:]
+
+  /// Protects the scheduling state; its condition is broadcast whenever
+  /// `current` changes.
+  private let lock = _sa_lock_create()!
+  /// The index of the thread that is allowed to run.
+  private var current = -1
+  private var steps = 0
+  private var preemptions = 0
+  private(set) var aborted = false
+
+  init(
+    threads count: Int,
+    maxSteps: Int,
+    preemptionBound: Int?,
+    prefix: [_Choice],
+    random: _Random?,
+    overrides: [UInt: Int] = [:]
+  ) {
+    self.chooser = _Chooser(prefix: prefix, random: random)
+    self.overrides = overrides
+    self.maxSteps = maxSteps
+    self.preemptionBound = preemptionBound
+    self.threads = (0 ..< count).map { _ModelThread(index: $0, threads: count) }
+  }
+
+  deinit {
+    _sa_lock_destroy(lock)
+  }
+
+  /// Runs `body` on one OS thread per model thread, and waits until all of
+  /// them finish.
+  func run(_ body: @escaping (Int) -> Void) {
+    var handles: [_ThreadHandle] = []
+    _sa_lock_acquire(lock)
+    for thread in threads {
+      thread.body = body
+      handles.append(_spawn(Unmanaged.passRetained(_Start(self, thread))))
+    }
+    current = chooser.choose(threads.count)
+    _sa_lock_broadcast(lock)
+    while threads.contains(where: { !$0.finished }) {
+      _sa_lock_wait(lock)
+    }
+    _sa_lock_release(lock)
+    handles.forEach(_join)
+    for thread in threads { thread.body = nil }
+  }
+
+  fileprivate func start(_ thread: _ModelThread) {
+    _sa_lock_acquire(lock)
+    while current != thread.index && !aborted {
+      _sa_lock_wait(lock)
+    }
+    _sa_lock_release(lock)
+    _AtomicModel._setCurrent(self, thread.index)
+    thread.body!(thread.index)
+    _AtomicModel._setCurrent(nil, 0)
+    _sa_lock_acquire(lock)
+    thread.finished = true
+    if current == thread.index && !aborted {
+      switchThreads(from: thread.index, yielding: true)
+    }
+    _sa_lock_broadcast(lock)
+    _sa_lock_release(lock)
+  }
+
+  /// Called before each atomic operation; lets the scheduler switch to
+  /// another thread. Returns false if the execution was aborted, in which
+  /// case the operation must be performed directly on memory.
+  @discardableResult
+  func schedule(from thread: Int, yielding: Bool = false) -> Bool {
+    _sa_lock_acquire(lock)
+    defer { _sa_lock_release(lock) }
+    guard !aborted else { return false }
+    steps += 1
+    if steps > maxSteps {
+      // Let all threads run freely, so that they can finish.
+      aborted = true
+      _sa_lock_broadcast(lock)
+      return false
+    }
+    switchThreads(from: thread, yielding: yielding)
+    while current != thread && !aborted {
+      _sa_lock_wait(lock)
+    }
+    return !aborted
+  }
+
+  /// Chooses the next thread to run. Must be called with the lock held.
+  private func switchThreads(from thread: Int, yielding: Bool) {
+    var candidates = threads.indices.filter {
+      $0 != thread && !threads[$0].finished
+    }
+    if !threads[thread].finished {
+      if yielding {
+        candidates.append(thread)
+      } else if let bound = preemptionBound, preemptions >= bound {
+        candidates = [thread]
+      } else {
+        candidates.insert(thread, at: 0)
+      }
+    }
+    guard !candidates.isEmpty else {
+      current = -1
+      return
+    }
+    let next = candidates[chooser.choose(candidates.count)]
+    if next != thread && !yielding && !threads[thread].finished {
+      preemptions += 1
+    }
+    if next != current {
+      current = next
+      _sa_lock_broadcast(lock)
+    }
+  }
+
+  /// Returns the modification order of the location at `address`, creating
+  /// it with the current value in memory if necessary.
+  func stores<Value>(
+    at address: UnsafeRawPointer,
+    initial: () -> Value
+  ) -> [_Store] {
+    if let stores = locations[address] { return stores }
+    let stores = [_Store(value: initial(), thread: -1, time: 0, release: nil)]
+    locations[address] = stores
+    return stores
+  }
+
+  /// Records that the atomic operation at `site` was called with the
+  /// ordering `rawValue`, and returns the ordering to simulate for it.
+  func ordering(
+    at site: UInt,
+    _ kind: AtomicModelChecker.OperationKind,
+    _ rawValue: Int
+  ) -> Int {
+    sites[site, default: _SiteUsage(kind: kind)].orderings.insert(rawValue)
+    return overrides[site] ?? rawValue
+  }
+
+  /// Records that a sequentially consistent operation observed the store
+  /// at `position` in the modification order of the location at `address`.
+  func observeSequentiallyConsistent(
+    _ address: UnsafeRawPointer,
+    _ position: Int
+  ) {
+    sequentiallyConsistent[address] = Swift.max(
+      sequentiallyConsistent[address] ?? 0,
+      position)
+  }
+
+  func trace(_ thread: Int, _ message: String) {
+    log.append("thread \(thread): \(message)")
+  }
+}
+
+private final class _Start {
+  let execution: _Execution
+  let thread: _ModelThread
+
+  init(_ execution: _Execution, _ thread: _ModelThread) {
+    self.execution = execution
+    self.thread = thread
+  }
+}
+
+private typealias _ThreadHandle = OpaquePointer
+
+private func _spawn(_ start: Unmanaged<_Start>) -> _ThreadHandle {
+  let handle = _sa_thread_create({ context in
+    let start = Unmanaged<_Start>.fromOpaque(context!).takeRetainedValue()
+    start.execution.start(start.thread)
+  }, start.toOpaque())
+  guard let result = handle else {
+    preconditionFailure("Cannot create model checker thread")
+  }
+  return result
+}
+
+private func _join(_ handle: _ThreadHandle) {
+  _sa_thread_join(handle)
+}
+
+/// The execution running a model checker thread, and the index of the
+/// thread within it. This is the thread's entry in its per-thread registry.
+private final class _ModelContext: _ThreadLocalEntry {
+  let execution: _Execution
+  let index: Int
+
+  init(_ execution: _Execution, _ index: Int) {
+    self.execution = execution
+    self.index = index
+  }
+
+  func threadDidExit() {}
+}
+
+/// The entry points that atomic operations call in model checking builds.
+@usableFromInline
+internal enum _AtomicModel {
+  internal static func _setCurrent(_ execution: _Execution?, _ thread: Int) {
+    _ThreadLocalRegistry.removeEntry(_ModelContext.self)
+    guard let execution = execution else { return }
+    _ = _ThreadLocalRegistry.entry(
+      _ModelContext.self,
+      orInsert: { _ModelContext(execution, thread) })
+  }
+
+  internal static var _current: (_Execution, Int)? {
+    guard let context = _ThreadLocalRegistry.entry(_ModelContext.self)
+    else { return nil }
+    return (context.execution, context.index)
+  }
+
+  /// Returns the address of the code that performed the current atomic
+  /// operation. This must be called directly from one of the entry points
+  /// below, which are never inlined; atomic operations themselves are
+  /// always inlined into their callers, so the return address of the entry
+  /// point identifies the call site.
+  @inline(never)
+  internal static func _callSite() -> UInt {
+    var frames = [UnsafeMutableRawPointer?](repeating: nil, count: 3)
+    let count = frames.withUnsafeMutableBufferPointer {
+      _sa_backtrace($0.baseAddress, 3)
+    }
+    guard count == 3, let frame = frames[2] else { return 0 }
+    return UInt(bitPattern: frame)
+  }
+
+  /// True if the current thread is being run by the model checker.
+  @usableFromInline
+  internal static var isActive: Bool {
+    _ThreadLocalRegistry.entry(_ModelContext.self) != nil
+  }
+
+  @usableFromInline @inline(never)
+  internal static func load<Value>(
+    at address: UnsafeRawPointer,
+    ordering: AtomicLoadOrdering,
+    current: () -> Value
+  ) -> Value {
+    guard
+      let (execution, index) = _current,
+      execution.schedule(from: index)
+    else { return current() }
+    let ordering = AtomicLoadOrdering(_rawValue: execution.ordering(
+        at: _callSite(), .load, ordering._rawValue))
+    let thread = execution.threads[index]
+    let stores = execution.stores(at: address, initial: current)
+
+    // Find the oldest store that this load may read.
+    var oldest = thread.observed[address] ?? 0
+    if ordering == .sequentiallyConsistent {
+      oldest = Swift.max(
+        oldest,
+        execution.sequentiallyConsistent[address] ?? 0)
+    }
+    for i in stride(from: stores.count - 1, to: oldest, by: -1) {
+      let store = stores[i]
+      if store.thread >= 0 && store.time <= thread.clock.times[store.thread] {
+        oldest = i
+        break
+      }
+    }
+    let position = stores.count - 1
+      - execution.chooser.choose(stores.count - oldest)
+    let store = stores[position]
+    thread.observed[address] = position
+    if ordering == .sequentiallyConsistent {
+      execution.observeSequentiallyConsistent(address, position)
+    }
+    if ordering == .relaxed {
+      thread.fenceAcquire.join(store.release)
+    } else {
+      thread.clock.join(store.release)
+    }
+    thread.tick()
+    execution.trace(
+      index,
+      "load(\(ordering)) \(address) -> \(store.value)" +
+      (position < stores.count - 1 ? " (stale)" : ""))
+    return store.value as! Value
+  }
+
+  @usableFromInline @inline(never)
+  internal static func store<Value>(
+    _ desired: Value,
+    at address: UnsafeRawPointer,
+    ordering: AtomicStoreOrdering,
+    current: () -> Value,
+    _ body: () -> Void
+  ) {
+    guard
+      let (execution, index) = _current,
+      execution.schedule(from: index)
+    else { return body() }
+    let ordering = AtomicStoreOrdering(_rawValue: execution.ordering(
+        at: _callSite(), .store, ordering._rawValue))
+    let thread = execution.threads[index]
+    var stores = execution.stores(at: address, initial: current)
+    body()
+    thread.tick()
+    stores.append(_Store(
+        value: desired,
+        thread: index,
+        time: thread.clock.times[index],
+        release: ordering == .relaxed ? thread.fenceRelease : thread.clock))
+    execution.locations[address] = stores
+    thread.observed[address] = stores.count - 1
+    if ordering == .sequentiallyConsistent {
+      execution.observeSequentiallyConsistent(address, stores.count - 1)
+    }
+    execution.trace(index, "store(\(ordering)) \(address) <- \(desired)")
+  }
+
+  /// Performs a read-modify-write operation. `body` performs the operation
+  /// on memory, and returns its result and whether it stored a new value.
+  /// (Failed compare-exchange operations act as loads with
+  /// `failureOrdering`.)
+  @usableFromInline @inline(never)
+  internal static func update<Value, Result>(
+    at address: UnsafeRawPointer,
+    ordering: AtomicUpdateOrdering,
+    failureOrdering: AtomicLoadOrdering? = nil,
+    current: () -> Value,
+    _ body: () -> (result: Result, stored: Bool)
+  ) -> Result {
+    guard
+      let (execution, index) = _current,
+      execution.schedule(from: index)
+    else { return body().result }
+    let rawValue = execution.ordering(
+      at: _callSite(), .readModifyWrite, ordering._rawValue)
+    // An overridden ordering also governs the failure case.
+    let failureOrdering = rawValue == ordering._rawValue
+      ? failureOrdering
+      : nil
+    let ordering = AtomicUpdateOrdering(_rawValue: rawValue)
+    let thread = execution.threads[index]
+    var stores = execution.stores(at: address, initial: current)
+    let previous = stores[stores.count - 1]
+    let (result, stored) = body()
+
+    let acquiring: Bool
+    if !stored, let failureOrdering = failureOrdering {
+      acquiring = failureOrdering != .relaxed
+    } else {
+      acquiring = ordering != .relaxed && ordering != .releasing
+    }
+    if acquiring {
+      thread.clock.join(previous.release)
+    } else {
+      thread.fenceAcquire.join(previous.release)
+    }
+    thread.tick()
+    if stored {
+      // Read-modify-write operations continue the release sequence of the
+      // store they read.
+      var release = ordering == .releasing
+        || ordering == .acquiringAndReleasing
+        || ordering == .sequentiallyConsistent
+        ? thread.clock
+        : thread.fenceRelease
+      if release == nil {
+        release = previous.release
+      } else {
+        release!.join(previous.release)
+      }
+      stores.append(_Store(
+          value: current(),
+          thread: index,
+          time: thread.clock.times[index],
+          release: release))
+      execution.locations[address] = stores
+    }
+    thread.observed[address] = stores.count - 1
+    let sequentiallyConsistent = stored || failureOrdering == nil
+      ? ordering == .sequentiallyConsistent
+      : failureOrdering == .sequentiallyConsistent
+    if sequentiallyConsistent {
+      execution.observeSequentiallyConsistent(address, stores.count - 1)
+    }
+    execution.trace(
+      index,
+      "update(\(ordering)) \(address): \(previous.value)" +
+      (stored ? " -> \(stores[stores.count - 1].value)" : " (unchanged)"))
+    return result
+  }
+
+  @usableFromInline @inline(never)
+  internal static func fence(ordering: AtomicUpdateOrdering) {
+    guard
+      let (execution, index) = _current,
+      execution.schedule(from: index)
+    else { return }
+    let ordering = AtomicUpdateOrdering(_rawValue: execution.ordering(
+        at: _callSite(), .fence, ordering._rawValue))
+    let thread = execution.threads[index]
+    if ordering != .relaxed && ordering != .releasing {
+      thread.clock.join(thread.fenceAcquire)
+    }
+    thread.tick()
+    if ordering != .relaxed && ordering != .acquiring {
+      thread.fenceRelease = thread.clock
+    }
+    if ordering == .sequentiallyConsistent {
+      // Fences are ordered with each other and with sequentially consistent
+      // operations by `S`: operations after this fence must not read older
+      // stores than anything observed before it, or before any fence or
+      // sequentially consistent operation that precedes it in `S`.
+      for (address, position) in thread.observed {
+        execution.observeSequentiallyConsistent(address, position)
+      }
+      thread.observed = execution.sequentiallyConsistent
+    }
+    execution.trace(index, "fence(\(ordering))")
+  }
+}
+#endif // ATOMICS_MODEL_CHECKING
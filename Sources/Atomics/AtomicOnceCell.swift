@@ -0,0 +1,159 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+/// A reference type holding a value that is computed at most once, on first
+/// use, even when several threads race to compute it.
+///
+/// Unlike `ManagedAtomicLazyReference.storeIfNilThenLoad(_:)`, which lets
+/// every racing thread build an instance and keeps only one of them, a once
+/// cell only ever runs a single initializer at a time. Threads that need the
+/// value while it is being computed go to sleep until it is ready. This is
+/// the right choice when initialization is expensive.
+///
+///     let table = AtomicOnceCell<[Int]>()
+///
+///     // This is safe to call concurrently from multiple threads.
+///     func lookup(_ index: Int) -> Int {
+///       table.get { computeTable() }[index]
+///     }
+///
+/// Once the value is initialized, reading it takes a single acquiring load
+/// of the cell's state.
+///
+/// If an initializer throws, the cell goes back to its uninitialized state,
+/// and the next caller (possibly one of the waiting threads) runs its own
+/// initializer. An initializer must not access the cell it is initializing.
+public final class AtomicOnceCell<Value> {
+  // The state must be the first stored property.
+  @usableFromInline
+  internal var _state: Int.AtomicRepresentation
+
+  @usableFromInline
+  internal var _value: Value?
+
+  /// Waiting threads sleep on this word, which changes whenever a running
+  /// initializer that has waiters finishes.
+  private let _parking = ManagedAtomic<UInt32>(0)
+
+  /// The states of the cell. Waiters mark a running cell so that the
+  /// initializer knows to wake them up.
+  @usableFromInline internal static var _uninitialized: Int { 0 }
+  @usableFromInline internal static var _running: Int { 1 }
+  @usableFromInline internal static var _runningWithWaiters: Int { 2 }
+  @usableFromInline internal static var _initialized: Int { 3 }
+
+  /// Creates an uninitialized cell.
+  public init() {
+    _state = Int.AtomicRepresentation(AtomicOnceCell._uninitialized)
+    _value = nil
+  }
+
+  /// Creates a cell that is already initialized with `value`.
+  public init(_ value: Value) {
+    _state = Int.AtomicRepresentation(AtomicOnceCell._initialized)
+    _value = value
+  }
+
+  deinit {
+    _ = _state.dispose()
+  }
+
+  @usableFromInline
+  internal var _stateAtomic: UnsafeAtomic<Int> {
+    UnsafeAtomic(
+      at: _getUnsafePointerToStoredProperties(self)
+        .assumingMemoryBound(to: Int.AtomicRepresentation.self))
+  }
+
+  /// Returns true if the value has been initialized.
+  @inlinable
+  public var isInitialized: Bool {
+    _stateAtomic.load(ordering: .acquiring) == AtomicOnceCell._initialized
+  }
+
+  /// Returns the value if it has been initialized, or nil otherwise. This
+  /// never waits.
+  @inlinable
+  public func load() -> Value? {
+    guard isInitialized else { return nil }
+    return _value
+  }
+
+  /// Returns the value, initializing it by calling `initializer` if needed.
+  ///
+  /// If another thread is running its initializer, this waits until that
+  /// finishes.
+  @inlinable
+  public func get(
+    orInitialize initializer: () throws -> Value
+  ) rethrows -> Value {
+    if isInitialized { return _value! }
+    return try _initialize(initializer)
+  }
+
+  @usableFromInline
+  internal func _initialize(
+    _ initializer: () throws -> Value
+  ) rethrows -> Value {
+    typealias Cell = AtomicOnceCell
+    let state = _stateAtomic
+    while true {
+      let (exchanged, current) = state.compareExchange(
+        expected: Cell._uninitialized,
+        desired: Cell._running,
+        ordering: .acquiring)
+      if exchanged {
+        do {
+          _value = try initializer()
+        } catch {
+          _finish(Cell._uninitialized)
+          throw error
+        }
+        _finish(Cell._initialized)
+        return _value!
+      }
+      if current == Cell._initialized {
+        return _value!
+      }
+      _wait(whileRunning: current)
+    }
+  }
+
+  private func _finish(_ newState: Int) {
+    let old = _stateAtomic.exchange(newState, ordering: .releasing)
+    if old == AtomicOnceCell._runningWithWaiters {
+      _parking.wrappingIncrement(ordering: .sequentiallyConsistent)
+      _parking.wakeAll()
+    }
+  }
+
+  private func _wait(whileRunning current: Int) {
+    typealias Cell = AtomicOnceCell
+    let state = _stateAtomic
+    if current == Cell._running {
+      guard state.compareExchange(
+        expected: Cell._running,
+        desired: Cell._runningWithWaiters,
+        ordering: .relaxed
+      ).exchanged else {
+        return
+      }
+    }
+    // Loading the parking word before checking the state again ensures that
+    // we either see the initializer finish, or it wakes us up.
+    let parking = _parking.load(ordering: .sequentiallyConsistent)
+    if state.load(ordering: .sequentiallyConsistent)
+      == Cell._runningWithWaiters {
+      _parking.wait(whileEqualTo: parking)
+    }
+  }
+}
@@ -0,0 +1,208 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#if ATOMICS_MODEL_CHECKING
+import _AtomicsShims
+
+extension AtomicModelChecker {
+  /// The kinds of atomic operations.
+  public enum OperationKind {
+    case load
+    case store
+    case readModifyWrite
+    case fence
+  }
+
+  /// A location in code that performs an atomic operation.
+  public struct CallSite: Hashable, CustomStringConvertible {
+    /// The address of the machine code that performed the operation.
+    public let address: UInt
+
+    /// The (mangled) name of the function containing the call site, if it
+    /// can be determined.
+    public var symbol: String? {
+      _symbolize()?.name
+    }
+
+    public var description: String {
+      guard let (name, offset) = _symbolize() else {
+        return "0x" + String(address, radix: 16)
+      }
+      return "\(name) + \(offset)"
+    }
+
+    private func _symbolize() -> (name: String, offset: UInt)? {
+      var start: UnsafeRawPointer? = nil
+      guard
+        let pointer = UnsafeRawPointer(bitPattern: address),
+        let name = _sa_symbol_name(pointer, &start)
+      else { return nil }
+      return (String(cString: name), address - UInt(bitPattern: start))
+    }
+  }
+
+  /// The result of trying to weaken the memory ordering of a call site.
+  public struct OrderingAdvice: CustomStringConvertible {
+    /// The code that performs the atomic operation.
+    public let site: CallSite
+
+    /// The kind of atomic operation performed at `site`.
+    public let kind: OperationKind
+
+    /// The ordering used by the call site. (Load and store orderings are
+    /// expressed as their `AtomicUpdateOrdering` counterparts.)
+    public let current: AtomicUpdateOrdering
+
+    /// The weakest ordering that the call site could use without making
+    /// any explored execution fail verification, or nil if the ordering
+    /// can't be weakened. This is also nil if the site was called with
+    /// several different orderings.
+    public let suggested: AtomicUpdateOrdering?
+
+    public var description: String {
+      guard let suggested = suggested else {
+        return "\(site): \(kind) keeps \(current)"
+      }
+      return "\(site): \(kind) can use \(suggested) instead of \(current)"
+    }
+  }
+
+  /// The outcome of `adviseOrderings`.
+  public struct OrderingAdvisorReport {
+    /// The exploration of the test with its original orderings. Advice is
+    /// only given if this exploration found no failures.
+    public let baseline: Report
+
+    /// Advice for every call site that performed an atomic operation with
+    /// an ordering other than `.relaxed`, ordered by address.
+    public let advice: [OrderingAdvice]
+
+    /// The call sites whose ordering can be weakened.
+    public var weakenable: [OrderingAdvice] {
+      advice.filter { $0.suggested != nil }
+    }
+  }
+
+  /// Finds atomic operations whose memory ordering is stronger than a test
+  /// needs.
+  ///
+  /// This first explores the test with its original orderings, collecting
+  /// the atomic operations it performs and the orderings they use, keyed by
+  /// call site. Then, for each call site, it explores the test again while
+  /// weakening the ordering of that site one step at a time
+  /// (`.sequentiallyConsistent` → `.acquiringAndReleasing` → `.acquiring`
+  /// or `.releasing` → `.relaxed`), stopping at the first step for which
+  /// some explored execution fails verification. It reports the weakest
+  /// ordering reached.
+  ///
+  /// Each call site is weakened in isolation; weakening several of them at
+  /// the same time may break the test. The advice is only as good as the
+  /// test: use the `.exhaustive` strategy with a `verify` closure that
+  /// checks everything that matters, and treat suggestions from incomplete
+  /// explorations as hints, not proofs.
+  ///
+  /// Call sites are identified by the address of the code that performs
+  /// the operation. Operations performed inside generic code that isn't
+  /// specialized, or inside this package (for example, by atomic strong
+  /// references), are attributed to the enclosing function.
+  public static func adviseOrderings<State>(
+    _ strategy: Strategy = .exhaustive(),
+    threads: Int,
+    maxSteps: Int = 10_000,
+    setUp: () -> State,
+    thread body: (State, Int) -> Void,
+    verify: (State) -> Bool
+  ) -> OrderingAdvisorReport {
+    var sites: [UInt: _SiteUsage] = [:]
+    let baseline = _explore(
+      strategy,
+      threads: threads,
+      maxSteps: maxSteps,
+      overrides: [:],
+      sites: &sites,
+      setUp: setUp,
+      thread: body,
+      verify: verify)
+    guard baseline.failure == nil else {
+      return OrderingAdvisorReport(baseline: baseline, advice: [])
+    }
+
+    var advice: [OrderingAdvice] = []
+    for (address, usage) in sites.sorted(by: { $0.key < $1.key }) {
+      guard let strongest = usage.orderings.max(), strongest != 0 else {
+        continue
+      }
+      var suggested: Int? = nil
+      if usage.orderings.count == 1 {
+        steps: for step in _weakeningSteps(from: strongest, kind: usage.kind) {
+          for candidate in step {
+            var ignored: [UInt: _SiteUsage] = [:]
+            let report = _explore(
+              strategy,
+              threads: threads,
+              maxSteps: maxSteps,
+              overrides: [address: candidate],
+              sites: &ignored,
+              setUp: setUp,
+              thread: body,
+              verify: verify)
+            if report.failure == nil {
+              suggested = candidate
+              continue steps
+            }
+          }
+          break
+        }
+      }
+      advice.append(OrderingAdvice(
+          site: CallSite(address: address),
+          kind: usage.kind,
+          current: AtomicUpdateOrdering(_rawValue: strongest),
+          suggested: suggested.map { AtomicUpdateOrdering(_rawValue: $0) }))
+    }
+    return OrderingAdvisorReport(baseline: baseline, advice: advice)
+  }
+
+  /// Returns the raw values of the orderings that are weaker than the given
+  /// one and valid for the given kind of operation, grouped into steps from
+  /// strongest to weakest. The orderings within a step are incomparable.
+  internal static func _weakeningSteps(
+    from rawValue: Int,
+    kind: OperationKind
+  ) -> [[Int]] {
+    let relaxed = AtomicUpdateOrdering.relaxed._rawValue
+    let acquiring = AtomicUpdateOrdering.acquiring._rawValue
+    let releasing = AtomicUpdateOrdering.releasing._rawValue
+    let acquiringAndReleasing =
+      AtomicUpdateOrdering.acquiringAndReleasing._rawValue
+    let sequentiallyConsistent =
+      AtomicUpdateOrdering.sequentiallyConsistent._rawValue
+    let steps: [[Int]]
+    switch kind {
+    case .load:
+      steps = [[sequentiallyConsistent], [acquiring], [relaxed]]
+    case .store:
+      steps = [[sequentiallyConsistent], [releasing], [relaxed]]
+    case .readModifyWrite, .fence:
+      steps = [
+        [sequentiallyConsistent],
+        [acquiringAndReleasing],
+        [acquiring, releasing],
+        [relaxed],
+      ]
+    }
+    guard let start = steps.firstIndex(where: { $0.contains(rawValue) })
+    else { return [] }
+    return Array(steps[(start + 1)...])
+  }
+}
+#endif // ATOMICS_MODEL_CHECKING
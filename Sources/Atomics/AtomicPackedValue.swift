@@ -0,0 +1,109 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+/// An atomic value that packs several small unsigned integer fields into a
+/// single atomic integer, so that they can be updated together.
+///
+/// Conforming types wrap an unsigned integer raw value, and describe their
+/// fields with `AtomicBitField` values. Fields are declared one after the
+/// other, so they can't accidentally overlap:
+///
+///     struct State: AtomicPackedValue {
+///       var rawValue: UInt64
+///       init(rawValue: UInt64) { self.rawValue = rawValue }
+///
+///       static let phase = AtomicBitField<State>(width: 2)
+///       static let count = AtomicBitField.after(phase, width: 30)
+///       static let generation = AtomicBitField.after(count, width: 32)
+///
+///       var phase: UInt64 {
+///         get { self[State.phase] }
+///         set { self[State.phase] = newValue }
+///       }
+///     }
+///
+/// Besides the regular atomic operations on the whole value, `UnsafeAtomic`
+/// and `ManagedAtomic` provide operations on individual fields: increments
+/// and decrements, which map to a single atomic integer operation, and
+/// compare-exchanges that only look at one field.
+public protocol AtomicPackedValue: AtomicValue, RawRepresentable
+where
+  RawValue: AtomicInteger & UnsignedInteger,
+  AtomicRepresentation == AtomicRawRepresentableStorage<Self>
+{}
+
+extension AtomicPackedValue {
+  /// Accesses the value of `field`.
+  ///
+  /// Setting a value that doesn't fit in the field is a precondition
+  /// failure.
+  @inlinable
+  public subscript(field: AtomicBitField<Self>) -> RawValue {
+    get { field.extract(from: rawValue) }
+    set { self = Self(rawValue: field.inserting(newValue, into: rawValue))! }
+  }
+}
+
+/// A field of consecutive bits in the raw value of an `AtomicPackedValue`.
+@frozen
+public struct AtomicBitField<Packed: AtomicPackedValue> {
+  public typealias RawValue = Packed.RawValue
+
+  /// The position of the field's least significant bit.
+  public let offset: Int
+
+  /// The number of bits in the field.
+  public let width: Int
+
+  /// Creates a field of `width` bits, starting at bit `offset`.
+  @inlinable
+  public init(offset: Int = 0, width: Int) {
+    precondition(width > 0, "Invalid field width")
+    precondition(
+      offset >= 0 && offset + width <= RawValue.bitWidth,
+      "Field doesn't fit in the packed value")
+    self.offset = offset
+    self.width = width
+  }
+
+  /// Creates a field of `width` bits, starting right after `previous`.
+  @inlinable
+  public static func after(_ previous: Self, width: Int) -> Self {
+    Self(offset: previous.offset + previous.width, width: width)
+  }
+
+  /// The largest value that the field can hold.
+  @inlinable
+  public var maximum: RawValue {
+    width == RawValue.bitWidth ? ~0 : (1 &<< RawValue(width)) &- 1
+  }
+
+  /// The bits of the packed raw value that belong to this field.
+  @inlinable
+  public var mask: RawValue {
+    maximum &<< RawValue(offset)
+  }
+
+  /// Returns the value of this field in the packed raw value `raw`.
+  @inlinable
+  public func extract(from raw: RawValue) -> RawValue {
+    (raw &>> RawValue(offset)) & maximum
+  }
+
+  /// Returns `raw` with this field set to `value`, and the other fields left
+  /// intact.
+  @inlinable
+  public func inserting(_ value: RawValue, into raw: RawValue) -> RawValue {
+    precondition(value <= maximum, "Value doesn't fit in the field")
+    return (raw & ~mask) | (value &<< RawValue(offset))
+  }
+}
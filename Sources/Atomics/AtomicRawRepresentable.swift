@@ -124,3 +124,48 @@ where Value: RawRepresentable, Value.RawValue: AtomicValue {
     return (raw.exchanged, Value(rawValue: raw.original)!)
   }
 }
+
+extension AtomicRawRepresentableStorage {
+  /// Atomically replaces the current raw value with `desired(raw)`, as long
+  /// as `predicate(raw)` holds for it, applying the specified memory
+  /// ordering. If the value changes concurrently, this tries again with the
+  /// new raw value.
+  ///
+  /// When the predicate doesn't hold, this returns without writing to the
+  /// value; the raw value it was evaluated on is then loaded with the
+  /// ordering that a failed compare-exchange with `ordering` would have.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  internal static func _atomicCompareExchange(
+    at pointer: UnsafeMutablePointer<Self>,
+    ordering: AtomicUpdateOrdering,
+    while predicate: (Value.RawValue) -> Bool,
+    desired: (Value.RawValue) -> Value.RawValue
+  ) -> (exchanged: Bool, original: Value) {
+    var raw: Value.RawValue
+    switch ordering {
+    case .relaxed, .releasing:
+      raw = Storage.atomicLoad(at: _extract(pointer), ordering: .relaxed)
+    case .acquiring, .acquiringAndReleasing:
+      raw = Storage.atomicLoad(at: _extract(pointer), ordering: .acquiring)
+    case .sequentiallyConsistent:
+      raw = Storage.atomicLoad(
+        at: _extract(pointer),
+        ordering: .sequentiallyConsistent)
+    default:
+      fatalError("Unsupported ordering")
+    }
+    while predicate(raw) {
+      let (exchanged, original) = Storage.atomicCompareExchange(
+        expected: raw,
+        desired: desired(raw),
+        at: _extract(pointer),
+        ordering: ordering)
+      if exchanged {
+        return (true, Value(rawValue: raw)!)
+      }
+      raw = original
+    }
+    return (false, Value(rawValue: raw)!)
+  }
+}
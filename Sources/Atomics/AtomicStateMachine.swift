@@ -0,0 +1,106 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+/// An atomic state, typically an enum, whose legal state changes are
+/// described by a transition table.
+///
+///     enum Phase: UInt8, AtomicStateMachine {
+///       case idle, running, finished, cancelled
+///
+///       static let transitions: AtomicTransitionTable<Phase> = [
+///         .idle: [.running, .cancelled],
+///         .running: [.finished, .cancelled],
+///       ]
+///     }
+///
+///     let phase = ManagedAtomic(Phase.idle)
+///     if phase.transition(to: .cancelled, ordering: .acquiringAndReleasing)
+///       .exchanged {
+///       // We cancelled the task before it finished.
+///     }
+///
+/// `UnsafeAtomic` and `ManagedAtomic` provide `transition` operations for
+/// state machines, which validate the requested transition against the
+/// table, and update the state with a compare-exchange of its raw value.
+public protocol AtomicStateMachine: AtomicValue, RawRepresentable
+where
+  RawValue: AtomicInteger,
+  AtomicRepresentation == AtomicRawRepresentableStorage<Self>
+{
+  /// The legal transitions between states.
+  static var transitions: AtomicTransitionTable<Self> { get }
+}
+
+/// The set of legal transitions of an `AtomicStateMachine`.
+///
+/// The table is a bit matrix indexed by the raw values of the source and
+/// target states, so looking up a transition doesn't need to decode any
+/// raw values. Raw values must be between 0 and 255.
+public struct AtomicTransitionTable<State: AtomicStateMachine> {
+  @usableFromInline
+  internal let _stateCount: Int
+
+  @usableFromInline
+  internal let _bits: [UInt64]
+
+  /// Creates a table that allows the given transitions, and no others.
+  public init<S: Sequence>(_ transitions: S)
+  where S.Element == (from: State, to: State) {
+    let pairs = transitions.map {
+      (AtomicTransitionTable._index($0.from), AtomicTransitionTable._index($0.to))
+    }
+    let count = pairs.reduce(0) { Swift.max($0, $1.0 + 1, $1.1 + 1) }
+    var bits = [UInt64](repeating: 0, count: (count * count + 63) / 64)
+    for (from, to) in pairs {
+      let bit = from * count + to
+      bits[bit / 64] |= 1 &<< UInt64(bit % 64)
+    }
+    self._stateCount = count
+    self._bits = bits
+  }
+
+  private static func _index(_ state: State) -> Int {
+    guard let index = Int(exactly: state.rawValue), index >= 0, index < 256
+    else {
+      preconditionFailure("State raw values must be between 0 and 255")
+    }
+    return index
+  }
+
+  /// Returns true if the table allows going from `source` to `target`.
+  @inlinable
+  public func allows(from source: State, to target: State) -> Bool {
+    _allows(from: source.rawValue, to: target.rawValue)
+  }
+
+  @inlinable @inline(__always)
+  internal func _allows(from source: State.RawValue, to target: State.RawValue) -> Bool {
+    guard
+      let from = Int(exactly: source), from >= 0, from < _stateCount,
+      let to = Int(exactly: target), to >= 0, to < _stateCount
+    else {
+      return false
+    }
+    let bit = from * _stateCount + to
+    return _bits[bit &>> 6] & (1 &<< UInt64(bit & 63)) != 0
+  }
+}
+
+extension AtomicTransitionTable: ExpressibleByDictionaryLiteral {
+  /// Creates a table from a dictionary literal that maps each source state
+  /// to the states it can go to.
+  public init(dictionaryLiteral elements: (State, [State])...) {
+    self.init(elements.lazy.flatMap { element in
+      element.1.lazy.map { (from: element.0, to: $0) }
+    })
+  }
+}
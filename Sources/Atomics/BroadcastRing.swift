@@ -0,0 +1,403 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import _AtomicsShims
+
+// A single-producer, multi-consumer broadcast ring buffer in the style of
+// the LMAX Disruptor. Every consumer sees every element; elements are
+// written into the ring once and read in place by all consumers.
+//
+// The ring is coordinated by sequence numbers. The producer's cursor holds
+// the last published sequence number, and each consumer's cursor holds the
+// last sequence number it has finished reading. The element with sequence
+// number `s` lives in slot `s & mask`; the producer may only reuse a slot
+// once every consumer cursor has moved past the sequence number that used it
+// before. All cursors start at -1.
+//
+// Each cursor lives on its own cache line, together with the private state
+// of the thread that advances it, so that consumers don't slow each other
+// down:
+//
+//   - line 0: published cursor, closed flag
+//   - line 1: next sequence to claim, cached minimum of consumer cursors
+//   - line 2 + i: consumer i's cursor, its cached copy of the published cursor
+
+/// A strategy for waiting until a ring buffer's cursors advance.
+///
+/// Waiting threads call `wait(until:)`; threads that advance a cursor call
+/// `signal()` afterwards. Strategies trade latency for CPU usage:
+/// `BusySpinWaitStrategy` has the lowest latency but keeps a core busy,
+/// `YieldingWaitStrategy` gives up the processor between checks, and
+/// `BlockingWaitStrategy` puts waiting threads to sleep.
+public protocol RingWaitStrategy: AnyObject {
+  /// Returns when `isReady` returns true.
+  func wait(until isReady: () -> Bool)
+
+  /// Notifies waiting threads that a cursor has advanced.
+  func signal()
+}
+
+/// A wait strategy that checks the condition in a tight loop.
+public final class BusySpinWaitStrategy: RingWaitStrategy {
+  public init() {}
+
+  public func wait(until isReady: () -> Bool) {
+    while !isReady() {}
+  }
+
+  public func signal() {}
+}
+
+/// A wait strategy that spins for a short while, then yields the processor
+/// between checks.
+public final class YieldingWaitStrategy: RingWaitStrategy {
+  public let spinCount: Int
+
+  public init(spinCount: Int = 100) {
+    self.spinCount = spinCount
+  }
+
+  public func wait(until isReady: () -> Bool) {
+    var spins = 0
+    while !isReady() {
+      if spins < spinCount {
+        spins += 1
+      } else {
+        _sa_thread_yield()
+      }
+    }
+  }
+
+  public func signal() {}
+}
+
+/// A wait strategy that puts waiting threads to sleep on an atomic wait
+/// (a futex, on Linux).
+///
+/// `signal()` only touches the shared epoch, and only makes a system call,
+/// when there are sleeping threads.
+public final class BlockingWaitStrategy: RingWaitStrategy {
+  private let _epoch = ManagedAtomic<UInt32>(0)
+  private let _waiters = ManagedAtomic<Int>(0)
+
+  public init() {}
+
+  public func wait(until isReady: () -> Bool) {
+    while !isReady() {
+      _waiters.wrappingIncrement(ordering: .sequentiallyConsistent)
+      // Paired with the fence in `signal()`: either the signaling thread
+      // sees us registered as a waiter, or we see the progress it made
+      // before signaling and don't go to sleep.
+      atomicMemoryFence(ordering: .sequentiallyConsistent)
+      let epoch = _epoch.load(ordering: .sequentiallyConsistent)
+      if !isReady() {
+        _epoch.wait(whileEqualTo: epoch)
+      }
+      _waiters.wrappingDecrement(ordering: .relaxed)
+    }
+  }
+
+  public func signal() {
+    atomicMemoryFence(ordering: .sequentiallyConsistent)
+    if _waiters.load(ordering: .relaxed) > 0 {
+      _epoch.wrappingIncrement(ordering: .sequentiallyConsistent)
+      _epoch.wakeAll()
+    }
+  }
+}
+
+/// A bounded, lock-free ring buffer that broadcasts every element written by
+/// a single producer to a fixed set of consumers.
+///
+/// Elements are stored in the ring once; each consumer reads them in place,
+/// at its own pace, through its own `Consumer` handle. The producer blocks
+/// (according to the ring's wait strategy) when the slowest consumer is a
+/// full ring behind.
+///
+///     let ring = BroadcastRing<Tick>(capacity: 1024, consumers: 2)
+///
+///     // Producer thread:
+///     ring.publish(tick)
+///     ring.close()
+///
+///     // Consumer thread `i`:
+///     let consumer = ring.consumer(i)
+///     while consumer.consume({ tick, _ in process(tick) }) > 0 {}
+///
+/// Only one thread may act as the producer, and each consumer handle may
+/// only be used by one thread at a time.
+public final class BroadcastRing<Element> {
+  private static var _lineSize: Int { 64 }
+
+  /// The number of elements the ring can hold.
+  public let capacity: Int
+
+  /// The number of consumers.
+  public let consumerCount: Int
+
+  /// The strategy used by the producer and consumers to wait for each other.
+  public let waitStrategy: RingWaitStrategy
+
+  private let _mask: Int
+  private let _elements: UnsafeMutablePointer<Element?>
+  private let _lines: UnsafeMutableRawPointer
+
+  /// Creates a ring buffer.
+  ///
+  /// - Parameter capacity: The number of elements the ring can hold. This
+  ///   must be a power of two.
+  /// - Parameter consumers: The number of consumers that read every element.
+  /// - Parameter waitStrategy: How the producer and consumers wait for each
+  ///   other.
+  public init(
+    capacity: Int,
+    consumers: Int,
+    waitStrategy: RingWaitStrategy = YieldingWaitStrategy()
+  ) {
+    precondition(
+      capacity > 0 && capacity & (capacity - 1) == 0,
+      "Capacity must be a power of two")
+    precondition(consumers > 0, "There must be at least one consumer")
+    self.capacity = capacity
+    self.consumerCount = consumers
+    self.waitStrategy = waitStrategy
+    self._mask = capacity - 1
+    self._elements = .allocate(capacity: capacity)
+    self._elements.initialize(repeating: nil, count: capacity)
+
+    let lineSize = BroadcastRing._lineSize
+    self._lines = .allocate(
+      byteCount: (consumers + 2) * lineSize,
+      alignment: lineSize)
+    _cursor(0).initialize(to: Int.AtomicRepresentation(-1))
+    (_lines + MemoryLayout<Int.AtomicRepresentation>.stride)
+      .bindMemory(to: Bool.AtomicRepresentation.self, capacity: 1)
+      .initialize(to: Bool.AtomicRepresentation(false))
+    _producerState.initialize(repeating: -1, count: 2)
+    _producerState[0] = 0
+    for consumer in 0 ..< consumers {
+      _cursor(consumer + 2).initialize(to: Int.AtomicRepresentation(-1))
+      _cachedPublished(consumer).initialize(to: -1)
+    }
+  }
+
+  deinit {
+    _elements.deinitialize(count: capacity)
+    _elements.deallocate()
+    _lines.deallocate()
+  }
+
+  private func _cursor(_ line: Int) -> UnsafeMutablePointer<Int.AtomicRepresentation> {
+    (_lines + line * BroadcastRing._lineSize)
+      .bindMemory(to: Int.AtomicRepresentation.self, capacity: 1)
+  }
+
+  private func _cachedPublished(_ consumer: Int) -> UnsafeMutablePointer<Int> {
+    (_lines
+      + (consumer + 2) * BroadcastRing._lineSize
+      + MemoryLayout<Int.AtomicRepresentation>.stride)
+      .bindMemory(to: Int.self, capacity: 1)
+  }
+
+  /// The next sequence number to claim, followed by the cached minimum of
+  /// the consumer cursors.
+  private var _producerState: UnsafeMutablePointer<Int> {
+    (_lines + BroadcastRing._lineSize).bindMemory(to: Int.self, capacity: 2)
+  }
+
+  private var _published: UnsafeAtomic<Int> {
+    UnsafeAtomic(at: _cursor(0))
+  }
+
+  private var _closed: UnsafeAtomic<Bool> {
+    UnsafeAtomic(
+      at: (_lines + MemoryLayout<Int.AtomicRepresentation>.stride)
+        .assumingMemoryBound(to: Bool.AtomicRepresentation.self))
+  }
+
+  private func _consumed(_ consumer: Int) -> UnsafeAtomic<Int> {
+    UnsafeAtomic(at: _cursor(consumer + 2))
+  }
+
+  private func _minimumConsumed() -> Int {
+    var result = Int.max
+    for consumer in 0 ..< consumerCount {
+      result = Swift.min(result, _consumed(consumer).load(ordering: .acquiring))
+    }
+    return result
+  }
+}
+
+extension BroadcastRing {
+  /// Claims the next `count` slots of the ring for writing, waiting for
+  /// consumers to free them up if necessary, and returns their sequence
+  /// numbers.
+  ///
+  /// Write elements into the claimed slots with `write(_:at:)`, then make
+  /// them visible to consumers with `publish(through:)`. Claiming slots in
+  /// batches amortizes the cost of checking consumer cursors.
+  ///
+  /// This must only be called by the producer.
+  public func claim(_ count: Int = 1) -> Range<Int> {
+    precondition(count > 0 && count <= capacity, "Invalid count")
+    let state = _producerState
+    let start = state[0]
+    let end = start + count
+    // The slot of sequence number `end - 1` was last used by
+    // `end - 1 - capacity`, which every consumer must have finished with.
+    let wrapPoint = end - 1 - capacity
+    if wrapPoint > state[1] {
+      var minimum = state[1]
+      waitStrategy.wait(until: {
+        minimum = _minimumConsumed()
+        return wrapPoint <= minimum
+      })
+      state[1] = minimum
+    }
+    state[0] = end
+    return start ..< end
+  }
+
+  /// Stores an element in a claimed slot.
+  ///
+  /// This must only be called by the producer.
+  public func write(_ element: Element, at sequence: Int) {
+    _elements[sequence & _mask] = element
+  }
+
+  /// Makes all elements up to and including `sequence` visible to
+  /// consumers.
+  ///
+  /// This must only be called by the producer, with the last sequence
+  /// number of a batch of claimed and written slots.
+  public func publish(through sequence: Int) {
+    precondition(sequence < _producerState[0], "Unclaimed sequence number")
+    _published.store(sequence, ordering: .releasing)
+    waitStrategy.signal()
+  }
+
+  /// Writes `element` to the ring and publishes it.
+  ///
+  /// This must only be called by the producer.
+  public func publish(_ element: Element) {
+    let sequence = claim().lowerBound
+    write(element, at: sequence)
+    publish(through: sequence)
+  }
+
+  /// Writes the elements of `batch` to the ring, and publishes them in
+  /// groups of at most `capacity` elements.
+  ///
+  /// This must only be called by the producer.
+  public func publish<S: Sequence>(
+    contentsOf batch: S
+  ) where S.Element == Element {
+    var iterator = batch.makeIterator()
+    var next = iterator.next()
+    while next != nil {
+      let count = Swift.max(1, Swift.min(capacity, batch.underestimatedCount))
+      let range = claim(count)
+      var last = range.lowerBound - 1
+      for sequence in range {
+        guard let element = next else { break }
+        write(element, at: sequence)
+        last = sequence
+        next = iterator.next()
+      }
+      // Any claimed slots left over are simply reclaimed by the next batch.
+      _producerState[0] = last + 1
+      publish(through: last)
+    }
+  }
+
+  /// Marks the end of the stream. Consumers stop waiting once they have read
+  /// every published element.
+  ///
+  /// This must only be called by the producer.
+  public func close() {
+    _closed.store(true, ordering: .releasing)
+    waitStrategy.signal()
+  }
+
+  /// Returns the handle of the consumer with the given index.
+  public func consumer(_ index: Int) -> Consumer {
+    precondition(index >= 0 && index < consumerCount, "Invalid consumer")
+    return Consumer(ring: self, index: index)
+  }
+
+  /// A handle for reading the elements of a ring buffer.
+  public struct Consumer {
+    /// The ring buffer this consumer reads.
+    public let ring: BroadcastRing
+
+    /// The index of the consumer.
+    public let index: Int
+
+    /// The sequence number of the last element this consumer has read.
+    public var sequence: Int {
+      ring._consumed(index).load(ordering: .relaxed)
+    }
+
+    /// Reads the elements that have been published since the last call,
+    /// without waiting, up to `maxCount` elements at a time.
+    ///
+    /// The consumer's cursor is only advanced once `body` has been called on
+    /// the whole batch; the producer can't overwrite the elements in the
+    /// meantime.
+    ///
+    /// - Parameter body: A closure that's called with each element and its
+    ///   sequence number, in order.
+    /// - Returns: The number of elements read.
+    @discardableResult
+    public func poll(
+      maxCount: Int = Int.max,
+      _ body: (Element, Int) throws -> Void
+    ) rethrows -> Int {
+      precondition(maxCount > 0, "Invalid count")
+      let cursor = ring._consumed(index)
+      let cached = ring._cachedPublished(index)
+      let first = cursor.load(ordering: .relaxed) + 1
+      if cached.pointee < first {
+        cached.pointee = ring._published.load(ordering: .acquiring)
+        if cached.pointee < first { return 0 }
+      }
+      let last = first + Swift.min(cached.pointee - first, maxCount - 1)
+      for sequence in first ... last {
+        try body(ring._elements[sequence & ring._mask]!, sequence)
+      }
+      cursor.store(last, ordering: .releasing)
+      ring.waitStrategy.signal()
+      return last - first + 1
+    }
+
+    /// Waits until new elements are published, then reads them like
+    /// `poll(maxCount:_:)`.
+    ///
+    /// - Returns: The number of elements read. This is zero only when the
+    ///   ring has been closed and every element has been read.
+    @discardableResult
+    public func consume(
+      maxCount: Int = Int.max,
+      _ body: (Element, Int) throws -> Void
+    ) rethrows -> Int {
+      let next = ring._consumed(index).load(ordering: .relaxed) + 1
+      ring.waitStrategy.wait(until: {
+        ring._published.load(ordering: .relaxed) >= next
+          || ring._closed.load(ordering: .relaxed)
+      })
+      // The producer publishes every element before closing the ring, so
+      // once we've seen the closed flag, the final poll sees everything.
+      _ = ring._closed.load(ordering: .acquiring)
+      return try poll(maxCount: maxCount, body)
+    }
+  }
+}
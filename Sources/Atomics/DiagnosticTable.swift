@@ -0,0 +1,36 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#if ATOMICS_INSTRUMENTATION || ATOMICS_CONTENTION_PROFILING
+/// Formats the per-location tables printed by the `dump(top:)` methods of
+/// `AtomicInstrumentation` and `AtomicContentionProfiler`: an address column
+/// followed by the named counters, with one line per location. Locations
+/// without an address are listed as `(other)`.
+internal func _diagnosticTable(
+  _ counters: [String],
+  _ rows: [(address: UnsafeRawPointer?, counts: [Int])]
+) -> String {
+  func line(_ columns: [String]) -> String {
+    let widths = [18] + repeatElement(12, count: counters.count)
+    return zip(columns, widths).map { column, width in
+      column + String(repeating: " ", count: max(0, width - column.count))
+    }.joined(separator: " ")
+  }
+  let header = line(["address"] + counters)
+  let lines = rows.map { row in
+    line(
+      [row.address.map { "\($0)" } ?? "(other)"]
+        + row.counts.map { "\($0)" })
+  }
+  return ([header] + lines).joined(separator: "\n")
+}
+#endif // ATOMICS_INSTRUMENTATION || ATOMICS_CONTENTION_PROFILING
@@ -110,6 +110,43 @@ extension DoubleWord: Hashable {
   }
 }
 
+// Wrapping arithmetic and bitwise operations, treating a double word as a
+// single unsigned integer. These match the semantics of the atomic integer
+// operations on `DoubleWord` values.
+extension DoubleWord {
+  /// Returns the sum of the two values, wrapping around on overflow.
+  @inlinable @inline(__always)
+  public static func &+(left: Self, right: Self) -> Self {
+    let (low, carry) = left.low.addingReportingOverflow(right.low)
+    return Self(high: left.high &+ right.high &+ (carry ? 1 : 0), low: low)
+  }
+
+  /// Returns the difference of the two values, wrapping around on overflow.
+  @inlinable @inline(__always)
+  public static func &-(left: Self, right: Self) -> Self {
+    let (low, borrow) = left.low.subtractingReportingOverflow(right.low)
+    return Self(high: left.high &- right.high &- (borrow ? 1 : 0), low: low)
+  }
+
+  /// Returns the bitwise AND of the two values.
+  @inlinable @inline(__always)
+  public static func &(left: Self, right: Self) -> Self {
+    Self(high: left.high & right.high, low: left.low & right.low)
+  }
+
+  /// Returns the bitwise OR of the two values.
+  @inlinable @inline(__always)
+  public static func |(left: Self, right: Self) -> Self {
+    Self(high: left.high | right.high, low: left.low | right.low)
+  }
+
+  /// Returns the bitwise XOR of the two values.
+  @inlinable @inline(__always)
+  public static func ^(left: Self, right: Self) -> Self {
+    Self(high: left.high ^ right.high, low: left.low ^ right.low)
+  }
+}
+
 extension DoubleWord: CustomStringConvertible {
   public var description: String {
     "DoubleWord(high: \(high), low: \(low))"
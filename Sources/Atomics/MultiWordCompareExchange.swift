@@ -0,0 +1,658 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import _AtomicsShims
+
+// A lock-free multi-word compare-and-exchange operation, following the
+// descriptor-based algorithm in T. Harris, K. Fraser and I. Pratt's 2002 paper
+// "A Practical Multi-word Compare-and-Swap Operation" [Harris 2002].
+//
+// Participating locations temporarily hold references to operation
+// descriptors; any thread that runs into such a reference helps the
+// corresponding operation complete before proceeding, so no thread ever
+// waits on another. Descriptors are installed using a restricted
+// double-compare single-swap (RDCSS) operation, which prevents them from
+// lingering in locations after their operation has been decided.
+//
+// Rather than allocating a new descriptor for each operation (which would
+// need a safe memory reclamation scheme), we reuse a fixed pool of
+// descriptors that are never deallocated, and we tag references to them with
+// sequence numbers, as described in M. Arbel-Raviv and T. Brown's 2017 paper
+// "Reuse, Don't Recycle: Transforming Lock-Free Algorithms That Throw Away
+// Descriptors" [Arbel-Raviv 2017]. Helpers read descriptor fields
+// speculatively, then validate that the descriptor hasn't been reused in the
+// meantime, like in a seqlock.
+//
+// Words in participating locations have the following format:
+//
+//   - values: encoded by `MultiWordAtomicValue`, with the low two bits clear
+//     (`value << 2` for integers, the bit pattern itself for pointers)
+//   - operation descriptors: `seq << (slotBits + 2) | slot << 2 | 0b01`
+//   - RDCSS descriptors: `seq << (slotBits + 2) | slot << 2 | 0b10`
+//
+// The pool has 128 slots. Each operation holds a slot while it runs, so
+// the algorithm is only lock-free as long as no more than 128 operations
+// are in flight at the same time; beyond that, threads wait (yielding the
+// processor) until a slot is released. Threads start searching for a free
+// slot at a position derived from their identity, so that uncontended
+// threads usually find the same slot free every time, without touching any
+// shared counter.
+//
+// Sequence numbers have `Int.bitWidth - slotBits - 3` bits. On 32-bit
+// platforms, this only leaves 22 bits, so a thread that gets suspended for
+// millions of operations while holding a stale descriptor reference could
+// in theory confuse it with a newer one.
+
+/// Namespace for the internals of `atomicMultiWordCompareExchange(_:)`.
+internal enum _MultiWord {
+  /// The maximum number of locations in a single multi-word operation.
+  internal static var maxCount: Int { 8 }
+
+  internal static var slotBits: Int { 7 }
+  internal static var slotCount: Int { 1 &<< slotBits }
+  internal static var seqBits: Int { Int.bitWidth - slotBits - 3 }
+  internal static var seqMask: Int { (1 &<< seqBits) - 1 }
+
+  // Descriptor slot layout, in words. Each slot is 32 words long, and it
+  // holds both an operation descriptor and an RDCSS descriptor.
+  internal static var slotStride: Int { 32 }
+  internal static var ownerField: Int { 0 }
+  internal static var statusField: Int { 1 }
+  internal static var countField: Int { 2 }
+  internal static var entriesField: Int { 3 } // (address, expected, desired)
+  internal static var rdcssSeqField: Int { 27 }
+  internal static var rdcssAddressField: Int { 28 }
+  internal static var rdcssExpectedField: Int { 29 }
+  internal static var rdcssDescriptorField: Int { 30 }
+
+  internal static var valueTag: Int { 0 }
+  internal static var descriptorTag: Int { 1 }
+  internal static var rdcssTag: Int { 2 }
+
+  internal static var undecided: Int { 0 }
+  internal static var succeeded: Int { 1 }
+  internal static var failed: Int { 2 }
+}
+
+/// The pool of descriptor slots. These are allocated on first use and are
+/// never deallocated.
+private let _multiWordSlots: UnsafeMutablePointer<Int.AtomicRepresentation> = {
+  let count = _MultiWord.slotCount * _MultiWord.slotStride
+  let raw = UnsafeMutableRawPointer.allocate(
+    byteCount: count * MemoryLayout<Int.AtomicRepresentation>.stride,
+    alignment: 128)
+  let slots = raw.bindMemory(to: Int.AtomicRepresentation.self, capacity: count)
+  slots.initialize(repeating: Int.AtomicRepresentation(0), count: count)
+  return slots
+}()
+
+extension _MultiWord {
+  internal static func encode<Value: MultiWordAtomicValue>(
+    _ value: Value
+  ) -> Int {
+    let word = Value.encodeMultiWordValue(value)
+    assert(tag(of: word) == valueTag)
+    return word
+  }
+
+  internal static func decode<Value: MultiWordAtomicValue>(
+    _ word: Int
+  ) -> Value {
+    assert(tag(of: word) == valueTag)
+    return Value.decodeMultiWordValue(word)
+  }
+
+  internal static func tag(of word: Int) -> Int { word & 3 }
+  internal static func slot(of word: Int) -> Int {
+    (word &>> 2) & (slotCount - 1)
+  }
+  internal static func seq(of word: Int) -> Int {
+    (word &>> (slotBits + 2)) & seqMask
+  }
+
+  internal static func reference(tag: Int, slot: Int, seq: Int) -> Int {
+    (seq &<< (slotBits + 2)) | (slot &<< 2) | tag
+  }
+
+  internal static func status(seq: Int, state: Int) -> Int {
+    (seq &<< 2) | state
+  }
+
+  internal static func field(_ slot: Int, _ field: Int) -> UnsafeAtomic<Int> {
+    UnsafeAtomic(at: _multiWordSlots + slot * slotStride + field)
+  }
+
+  internal static func location(_ address: Int) -> UnsafeAtomic<Int> {
+    UnsafeAtomic(
+      at: UnsafeMutablePointer<Int.AtomicRepresentation>(bitPattern: address)!)
+  }
+}
+
+extension _MultiWord {
+  /// Claim a descriptor slot for the exclusive use of the current thread.
+  ///
+  /// Note: If there are more in-flight operations than there are slots, then
+  /// this waits until one of them finishes.
+  internal static func acquireSlot() -> Int {
+    let thread = UInt(_sa_thread_id())
+    // Thread identifiers are aligned addresses; mix the bits.
+    let hash = (thread >> 4) &* 0x9E3779B9
+    let start = Int(truncatingIfNeeded: hash >> 8)
+    while true {
+      for i in 0 ..< slotCount {
+        let slot = (start &+ i) & (slotCount - 1)
+        let owner = field(slot, ownerField)
+        if owner.load(ordering: .relaxed) == 0,
+           owner.compareExchange(
+             expected: 0,
+             desired: 1,
+             ordering: .acquiring).exchanged {
+          return slot
+        }
+      }
+      _sa_thread_yield()
+    }
+  }
+
+  internal static func releaseSlot(_ slot: Int) {
+    field(slot, ownerField).store(0, ordering: .releasing)
+  }
+}
+
+extension _MultiWord {
+  /// Set the location at `address` to `descriptor`, but only if it currently
+  /// holds `expected` and the status of `descriptor` is still undecided.
+  /// Returns the original value of the location.
+  ///
+  /// `slot` must be owned by the current thread.
+  internal static func rdcss(
+    slot: Int,
+    address: Int,
+    expected: Int,
+    descriptor: Int
+  ) -> Int {
+    // Invalidate old references to our RDCSS descriptor before updating it.
+    let seqField = field(slot, rdcssSeqField)
+    let seq = (seqField.load(ordering: .relaxed) &+ 1) & seqMask
+    seqField.store(seq, ordering: .relaxed)
+    atomicMemoryFence(ordering: .releasing)
+    field(slot, rdcssAddressField).store(address, ordering: .relaxed)
+    field(slot, rdcssExpectedField).store(expected, ordering: .relaxed)
+    field(slot, rdcssDescriptorField).store(descriptor, ordering: .relaxed)
+
+    let rdcss = reference(tag: rdcssTag, slot: slot, seq: seq)
+    let target = location(address)
+    while true {
+      let (exchanged, current) = target.compareExchange(
+        expected: expected,
+        desired: rdcss,
+        ordering: .acquiringAndReleasing)
+      if exchanged {
+        completeRDCSS(rdcss)
+        return expected
+      }
+      guard tag(of: current) == rdcssTag else { return current }
+      completeRDCSS(current)
+    }
+  }
+
+  /// Finish the RDCSS operation referenced by `rdcss`, replacing it either
+  /// with its descriptor or with its original value.
+  internal static func completeRDCSS(_ rdcss: Int) {
+    let slot = self.slot(of: rdcss)
+    let address = field(slot, rdcssAddressField).load(ordering: .relaxed)
+    let expected = field(slot, rdcssExpectedField).load(ordering: .relaxed)
+    let descriptor = field(slot, rdcssDescriptorField).load(ordering: .relaxed)
+    atomicMemoryFence(ordering: .acquiring)
+    guard field(slot, rdcssSeqField).load(ordering: .relaxed) == seq(of: rdcss)
+    else {
+      // The RDCSS descriptor has been reused, so the operation we're looking
+      // for must have already completed.
+      return
+    }
+    let undecided = status(seq: seq(of: descriptor), state: self.undecided)
+    let current = field(self.slot(of: descriptor), statusField)
+      .load(ordering: .acquiring)
+    _ = location(address).compareExchange(
+      expected: rdcss,
+      desired: current == undecided ? descriptor : expected,
+      ordering: .acquiringAndReleasing)
+  }
+
+  /// Help the multi-word operation referenced by `descriptor` to complete.
+  /// Returns true if the operation succeeded, or false if it failed or if it
+  /// has already been completed by someone else.
+  ///
+  /// `slot` must be owned by the current thread.
+  @discardableResult
+  internal static func help(slot: Int, descriptor: Int) -> Bool {
+    let owner = self.slot(of: descriptor)
+    let seq = self.seq(of: descriptor)
+    let statusField = field(owner, self.statusField)
+    let undecided = status(seq: seq, state: self.undecided)
+
+    var count = field(owner, countField).load(ordering: .relaxed)
+    atomicMemoryFence(ordering: .acquiring)
+    var current = statusField.load(ordering: .acquiring)
+    guard current &>> 2 == seq else { return false }
+    count = Swift.min(count, maxCount)
+
+    if current == undecided {
+      // Phase 1: Install the descriptor in every location, in address order.
+      var state = succeeded
+      var i = 0
+      while i < count && state == succeeded {
+        let entry = entriesField + 3 * i
+        let address = field(owner, entry).load(ordering: .relaxed)
+        let expected = field(owner, entry + 1).load(ordering: .relaxed)
+        atomicMemoryFence(ordering: .acquiring)
+        guard statusField.load(ordering: .relaxed) == undecided else { break }
+        let original = rdcss(
+          slot: slot,
+          address: address,
+          expected: expected,
+          descriptor: descriptor)
+        if tag(of: original) == descriptorTag {
+          if original != descriptor {
+            // Another operation is in the way; help it finish, then retry.
+            help(slot: slot, descriptor: original)
+            continue
+          }
+        } else if original != expected {
+          state = failed
+        }
+        i += 1
+      }
+      _ = statusField.compareExchange(
+        expected: undecided,
+        desired: status(seq: seq, state: state),
+        ordering: .acquiringAndReleasing)
+      current = statusField.load(ordering: .acquiring)
+      guard current &>> 2 == seq else { return false }
+    }
+
+    // Phase 2: Replace the descriptor with the final values.
+    let success = current & 3 == succeeded
+    for i in 0 ..< count {
+      let entry = entriesField + 3 * i
+      let address = field(owner, entry).load(ordering: .relaxed)
+      let value = field(owner, success ? entry + 2 : entry + 1)
+        .load(ordering: .relaxed)
+      atomicMemoryFence(ordering: .acquiring)
+      guard statusField.load(ordering: .relaxed) == current else { break }
+      _ = location(address).compareExchange(
+        expected: descriptor,
+        desired: value,
+        ordering: .acquiringAndReleasing)
+    }
+    return success
+  }
+
+  /// Return the logical value of the location at `address`.
+  internal static func read(_ address: Int) -> Int {
+    while true {
+      let word = location(address).load(ordering: .acquiring)
+      let tag = self.tag(of: word)
+      if tag == valueTag { return word }
+      let slot = self.slot(of: word)
+      if tag == rdcssTag {
+        // The location logically still holds its original value.
+        let expected = field(slot, rdcssExpectedField).load(ordering: .relaxed)
+        atomicMemoryFence(ordering: .acquiring)
+        let seq = field(slot, rdcssSeqField).load(ordering: .relaxed)
+        if seq == self.seq(of: word) { return expected }
+        continue
+      }
+      // The location holds an operation descriptor; its logical value depends
+      // on whether the operation has succeeded.
+      let count = Swift.min(
+        field(slot, countField).load(ordering: .relaxed), maxCount)
+      var old = 0
+      var new = 0
+      var found = false
+      for i in 0 ..< count {
+        let entry = entriesField + 3 * i
+        if field(slot, entry).load(ordering: .relaxed) == address {
+          old = field(slot, entry + 1).load(ordering: .relaxed)
+          new = field(slot, entry + 2).load(ordering: .relaxed)
+          found = true
+          break
+        }
+      }
+      atomicMemoryFence(ordering: .acquiring)
+      let status = field(slot, statusField).load(ordering: .acquiring)
+      guard found, status &>> 2 == self.seq(of: word) else { continue }
+      return status & 3 == succeeded ? new : old
+    }
+  }
+
+  /// Perform a multi-word compare and exchange on the supplied
+  /// `(address, expected, desired)` entries, which must be sorted by address.
+  /// Expected and desired values must already be encoded.
+  internal static func compareExchange(
+    _ entries: [(address: Int, expected: Int, desired: Int)]
+  ) -> Bool {
+    let slot = acquireSlot()
+    defer { releaseSlot(slot) }
+
+    // Invalidate old references to our descriptor before updating it.
+    let statusField = field(slot, self.statusField)
+    let seq = ((statusField.load(ordering: .relaxed) &>> 2) &+ 1) & seqMask
+    statusField.store(status(seq: seq, state: undecided), ordering: .relaxed)
+    atomicMemoryFence(ordering: .releasing)
+    field(slot, countField).store(entries.count, ordering: .relaxed)
+    for i in 0 ..< entries.count {
+      let entry = entriesField + 3 * i
+      field(slot, entry).store(entries[i].address, ordering: .relaxed)
+      field(slot, entry + 1).store(entries[i].expected, ordering: .relaxed)
+      field(slot, entry + 2).store(entries[i].desired, ordering: .relaxed)
+    }
+    let descriptor = reference(tag: descriptorTag, slot: slot, seq: seq)
+    return help(slot: slot, descriptor: descriptor)
+  }
+}
+
+/// A type whose values can be stored in multi-word atomic locations.
+///
+/// Locations taking part in a multi-word operation temporarily hold tagged
+/// references to its descriptor, so every value must be encoded as a word
+/// whose two least significant bits are clear.
+public protocol MultiWordAtomicValue {
+  /// Encode `value` into a word whose two least significant bits are clear.
+  static func encodeMultiWordValue(_ value: Self) -> Int
+
+  /// Decode a word produced by `encodeMultiWordValue(_:)`.
+  static func decodeMultiWordValue(_ word: Int) -> Self
+}
+
+extension Int: MultiWordAtomicValue {
+  /// Integers are shifted to make room for descriptor tags, so they must fit
+  /// in `Int.bitWidth - 2` bits.
+  public static func encodeMultiWordValue(_ value: Int) -> Int {
+    let word = value &<< 2
+    precondition(word >> 2 == value,
+      "Value \(value) doesn't fit in a multi-word atomic location")
+    return word
+  }
+
+  public static func decodeMultiWordValue(_ word: Int) -> Int {
+    word >> 2
+  }
+}
+
+extension UnsafeMutableRawPointer: MultiWordAtomicValue {
+  /// Pointers are stored as they are, with descriptor tags in their low
+  /// alignment bits, so they must be aligned to at least 4 bytes. Their high
+  /// bits are unrestricted, so signed or tagged pointers round-trip intact.
+  public static func encodeMultiWordValue(
+    _ value: UnsafeMutableRawPointer
+  ) -> Int {
+    Optional<UnsafeMutableRawPointer>.encodeMultiWordValue(value)
+  }
+
+  public static func decodeMultiWordValue(
+    _ word: Int
+  ) -> UnsafeMutableRawPointer {
+    UnsafeMutableRawPointer(bitPattern: word)!
+  }
+}
+
+extension Optional: MultiWordAtomicValue
+where Wrapped == UnsafeMutableRawPointer {
+  /// Pointers are stored as they are, with descriptor tags in their low
+  /// alignment bits, so they must be aligned to at least 4 bytes. `nil` is
+  /// stored as zero.
+  public static func encodeMultiWordValue(
+    _ value: UnsafeMutableRawPointer?
+  ) -> Int {
+    let word = Int(bitPattern: value)
+    precondition(word & 3 == 0,
+      "Pointer \(value!) isn't aligned for a multi-word atomic location")
+    return word
+  }
+
+  public static func decodeMultiWordValue(
+    _ word: Int
+  ) -> UnsafeMutableRawPointer? {
+    UnsafeMutableRawPointer(bitPattern: word)
+  }
+}
+
+/// An unsafe reference to a location that supports lock-free multi-word
+/// compare and exchange operations through
+/// `atomicMultiWordCompareExchange(_:)`, requiring manual memory management
+/// of the underlying storage representation.
+///
+/// Locations taking part in a multi-word operation temporarily hold
+/// references to its descriptor, so they must only be accessed through the
+/// operations provided by this type. To make room for descriptor tags,
+/// values are encoded with `MultiWordAtomicValue`: integers must fit in
+/// `Int.bitWidth - 2` bits, and pointers must be aligned to at least 4 bytes.
+///
+/// All operations on multi-word atomic locations use acquiring-and-releasing
+/// memory ordering.
+@frozen
+public struct UnsafeMultiWordAtomic<Value: MultiWordAtomicValue> {
+  /// The storage representation for a multi-word atomic location.
+  @frozen
+  public struct Storage {
+    @usableFromInline
+    internal var _storage: Int.AtomicRepresentation
+
+    /// Encode the supplied value into its storage representation.
+    ///
+    /// Note: This is not an atomic operation.
+    public init(_ value: Value) {
+      _storage = Int.AtomicRepresentation(_MultiWord.encode(value))
+    }
+
+    /// Prepare this storage value for deinitialization, extracting the value
+    /// it represents.
+    ///
+    /// Note: This is not an atomic operation. The location must not be taking
+    /// part in any in-flight multi-word operation.
+    public func dispose() -> Value {
+      _MultiWord.decode(_storage.dispose())
+    }
+  }
+
+  @usableFromInline
+  internal let _ptr: UnsafeMutablePointer<Storage>
+
+  /// Initialize a multi-word atomic location that uses the supplied memory
+  /// location for storage. The storage location must already be initialized
+  /// to represent a valid value.
+  ///
+  /// Note: This is not an atomic operation.
+  @_transparent // Debug performance
+  public init(@_nonEphemeral at pointer: UnsafeMutablePointer<Storage>) {
+    self._ptr = pointer
+  }
+
+  /// Create a new multi-word atomic location with the supplied initial value
+  /// by dynamically allocating storage for it.
+  ///
+  /// This call is usually paired with `destroy` to get rid of the allocated
+  /// storage at the end of its lifetime.
+  ///
+  /// Note: This is not an atomic operation.
+  public static func create(_ initialValue: Value) -> Self {
+    let ptr = UnsafeMutablePointer<Storage>.allocate(capacity: 1)
+    ptr.initialize(to: Storage(initialValue))
+    return Self(at: ptr)
+  }
+
+  /// Disposes of the current value of the storage location, then
+  /// deinitializes and deallocates the storage.
+  ///
+  /// Note: This is not an atomic operation.
+  ///
+  /// - Returns: The last value stored in the storage representation before it
+  ///   was destroyed.
+  @discardableResult
+  public func destroy() -> Value {
+    let result = _ptr.pointee.dispose()
+    _ptr.deinitialize(count: 1)
+    _ptr.deallocate()
+    return result
+  }
+
+  internal var _address: Int {
+    Int(bitPattern: UnsafeMutableRawPointer(_ptr))
+  }
+}
+
+extension UnsafeMultiWordAtomic {
+  /// Atomically loads and returns the current value.
+  public func load() -> Value {
+    _MultiWord.decode(_MultiWord.read(_address))
+  }
+
+  /// Atomically sets the current value to `desired`.
+  public func store(_ desired: Value) {
+    let d = _MultiWord.encode(desired)
+    var e = _MultiWord.read(_address)
+    while true {
+      let (exchanged, original) = _compareExchange(expected: e, desired: d)
+      if exchanged { return }
+      e = original
+    }
+  }
+
+  /// Perform an atomic compare and exchange operation on the current value.
+  ///
+  /// - Parameter expected: The expected current value.
+  /// - Parameter desired: The desired new value.
+  /// - Returns: A tuple `(exchanged, original)`, where `exchanged` is true if
+  ///   the exchange was successful, and `original` is the original value.
+  public func compareExchange(
+    expected: Value,
+    desired: Value
+  ) -> (exchanged: Bool, original: Value) {
+    let (exchanged, original) = _compareExchange(
+      expected: _MultiWord.encode(expected),
+      desired: _MultiWord.encode(desired))
+    return (exchanged, _MultiWord.decode(original))
+  }
+
+  /// Compare and exchange on encoded words, returning the original word.
+  internal func _compareExchange(
+    expected e: Int,
+    desired d: Int
+  ) -> (exchanged: Bool, original: Int) {
+    let location = _MultiWord.location(_address)
+    while true {
+      // Try the fast path first; this only fails to decide the outcome if
+      // the location is busy with a multi-word operation.
+      let (exchanged, current) = location.compareExchange(
+        expected: e,
+        desired: d,
+        ordering: .acquiringAndReleasing)
+      if exchanged { return (true, e) }
+      if _MultiWord.tag(of: current) == _MultiWord.valueTag {
+        return (false, current)
+      }
+      if _MultiWord.compareExchange([(_address, e, d)]) {
+        return (true, e)
+      }
+      let original = _MultiWord.read(_address)
+      if original != e { return (false, original) }
+    }
+  }
+}
+
+/// One of the updates performed by `atomicMultiWordCompareExchange(_:)`.
+///
+/// Updates of locations holding different types of values can be combined
+/// in a single operation:
+///
+///     atomicMultiWordCompareExchange([
+///       MultiWordAtomicUpdate(head, expected: node, desired: next),
+///       MultiWordAtomicUpdate(count, expected: n, desired: n - 1),
+///     ])
+@frozen
+public struct MultiWordAtomicUpdate {
+  @usableFromInline
+  internal let _address: Int
+  @usableFromInline
+  internal let _expected: Int
+  @usableFromInline
+  internal let _desired: Int
+
+  /// Update `location` from `expected` to `desired`.
+  public init<Value>(
+    _ location: UnsafeMultiWordAtomic<Value>,
+    expected: Value,
+    desired: Value
+  ) {
+    _address = location._address
+    _expected = _MultiWord.encode(expected)
+    _desired = _MultiWord.encode(desired)
+  }
+}
+
+/// Atomically updates each of the supplied locations from its `expected`
+/// value to its `desired` value, but only if all of them hold their expected
+/// values. Otherwise none of the locations are updated.
+///
+/// Threads that run into an in-flight multi-word operation help it complete
+/// instead of waiting for it, so the operation is lock-free as long as no
+/// more than 128 of them are in flight at the same time. (Each one needs a
+/// descriptor from a fixed pool; additional threads wait until one becomes
+/// available.) Up to 8 locations may take part in a single operation, and
+/// each location may only appear once.
+///
+/// This operation uses acquiring-and-releasing memory ordering.
+///
+/// - Parameter updates: The updates to perform.
+/// - Returns: True if the locations were updated, false otherwise.
+public func atomicMultiWordCompareExchange(
+  _ updates: [MultiWordAtomicUpdate]
+) -> Bool {
+  precondition(updates.count <= _MultiWord.maxCount,
+    "Too many locations in multi-word compare and exchange")
+  // Installing descriptors in a global order guarantees progress.
+  let entries = updates
+    .map { (
+      address: $0._address,
+      expected: $0._expected,
+      desired: $0._desired) }
+    .sorted { $0.address < $1.address }
+  for i in entries.indices.dropFirst() {
+    precondition(entries[i - 1].address != entries[i].address,
+      "Duplicate location in multi-word compare and exchange")
+  }
+  return _MultiWord.compareExchange(entries)
+}
+
+/// Atomically updates each of the supplied locations from its `expected`
+/// value to its `desired` value, but only if all of them hold their expected
+/// values. Otherwise none of the locations are updated.
+///
+/// This is a shorthand for `atomicMultiWordCompareExchange(_:)` on
+/// `MultiWordAtomicUpdate`s, for locations that all hold the same type.
+///
+/// - Parameter updates: An array of `(location, expected, desired)` tuples.
+/// - Returns: True if the locations were updated, false otherwise.
+public func atomicMultiWordCompareExchange<Value>(
+  _ updates: [(
+    location: UnsafeMultiWordAtomic<Value>,
+    expected: Value,
+    desired: Value)]
+) -> Bool {
+  atomicMultiWordCompareExchange(updates.map {
+    MultiWordAtomicUpdate(
+      $0.location,
+      expected: $0.expected,
+      desired: $0.desired)
+  })
+}
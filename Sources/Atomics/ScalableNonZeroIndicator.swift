@@ -0,0 +1,214 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import _AtomicsShims
+
+// A scalable non-zero indicator, following F. Ellen, Y. Lev, V. Luchangco and
+// M. Moir's 2007 paper "SNZI: Scalable NonZero Indicators" [Ellen 2007].
+//
+// The indicator is a binary tree of counters, stored in heap order (node 0
+// is the root, the parent of node `i` is `(i - 1) / 2`), each on its own
+// cache line. Threads arrive at and depart from leaves; a node only arrives
+// at its parent when its own count goes from zero to nonzero, and only
+// departs from it when its count goes back to zero. Threads that arrive at
+// and depart from a busy leaf therefore never touch the upper levels of the
+// tree.
+//
+// Non-root nodes hold a count and a version number. Counts are encoded in
+// units of `one`; a count of `half` marks a node whose first arrival is in
+// the process of arriving at the parent, so that concurrent arrivals can
+// help it complete. The version number is bumped whenever a node leaves
+// zero, which prevents an arrival from confusing an old `half` state with a
+// new one.
+//
+// The paper's root also maintains a separate indicator bit, so that queries
+// don't need to read the root counter. We use a plain counter as the root
+// instead, and query it directly: it only changes when a child goes between
+// zero and nonzero, which is rare when the indicator is busy.
+
+/// A scalable nonzero indicator (SNZI): a counter that only supports
+/// incrementing, decrementing, and checking whether it is nonzero, with
+/// increments and decrements that scale with the number of cores.
+///
+/// A typical use is tracking the readers of a read-mostly data structure:
+/// readers call `arrive()` before reading and `depart(_:)` afterwards, and
+/// writers wait until `isNonZero` becomes false.
+///
+///     let ticket = readers.arrive()
+///     defer { readers.depart(ticket) }
+///     // read...
+///
+/// Each arrival returns a ticket that identifies the leaf it arrived at;
+/// the corresponding departure must use the same ticket.
+public final class ScalableNonZeroIndicator {
+  /// Identifies the leaf an arrival was counted at.
+  public struct Ticket {
+    internal let _leaf: Int
+  }
+
+  /// The number of leaves in the tree.
+  public let leafCount: Int
+
+  private let _nodes: UnsafeMutablePointer<Int.AtomicRepresentation>
+
+  private static var _nodeStride: Int {
+    64 / MemoryLayout<Int.AtomicRepresentation>.stride
+  }
+  private static var _versionShift: Int { Int.bitWidth / 2 }
+  private static var _countMask: Int { (1 &<< _versionShift) - 1 }
+  private static var _half: Int { 1 }
+  private static var _one: Int { 2 }
+
+  private var _nodeCount: Int { 2 * leafCount - 1 }
+
+  /// Creates a new indicator with a count of zero.
+  ///
+  /// - Parameter leafCount: The number of leaves in the tree, rounded up to
+  ///   a power of two. Arrivals from different threads are spread across
+  ///   the leaves. The default is the number of online processors.
+  public init(leafCount: Int? = nil) {
+    let requested = leafCount
+      ?? Int(_sa_processor_count())
+    precondition(requested > 0, "Invalid leaf count")
+    var count = 1
+    while count < requested { count *= 2 }
+    self.leafCount = count
+
+    let nodeCount = 2 * count - 1
+    let words = nodeCount * ScalableNonZeroIndicator._nodeStride
+    _nodes = UnsafeMutableRawPointer.allocate(
+      byteCount: words * MemoryLayout<Int.AtomicRepresentation>.stride,
+      alignment: 64
+    ).bindMemory(to: Int.AtomicRepresentation.self, capacity: words)
+    _nodes.initialize(repeating: Int.AtomicRepresentation(0), count: words)
+  }
+
+  deinit {
+    let words = _nodeCount * ScalableNonZeroIndicator._nodeStride
+    _nodes.deinitialize(count: words)
+    _nodes.deallocate()
+  }
+
+  private func _node(_ index: Int) -> UnsafeAtomic<Int> {
+    UnsafeAtomic(at: _nodes + index * ScalableNonZeroIndicator._nodeStride)
+  }
+
+  /// Returns true if there are more arrivals than departures.
+  public var isNonZero: Bool {
+    _node(0).load(ordering: .acquiring) != 0
+  }
+
+  /// Increments the indicator, at a leaf chosen by the calling thread's
+  /// identity.
+  @discardableResult
+  public func arrive() -> Ticket {
+    let thread = UInt(_sa_thread_id())
+    // Thread identifiers are aligned addresses; mix the bits.
+    let hash = (thread >> 4) &* 0x9E3779B9
+    return arrive(hint: Int(truncatingIfNeeded: hash >> 8))
+  }
+
+  /// Increments the indicator at the leaf selected by `hint`. Threads that
+  /// use different hints (modulo `leafCount`) don't contend with each other
+  /// while the indicator stays nonzero.
+  @discardableResult
+  public func arrive(hint: Int) -> Ticket {
+    let offset = UInt(bitPattern: hint) % UInt(leafCount)
+    let leaf = leafCount - 1 + Int(bitPattern: offset)
+    _arrive(leaf)
+    return Ticket(_leaf: leaf)
+  }
+
+  /// Decrements the indicator, undoing the arrival that returned `ticket`.
+  public func depart(_ ticket: Ticket) {
+    precondition(
+      ticket._leaf >= leafCount - 1 && ticket._leaf < _nodeCount,
+      "Invalid ticket")
+    _depart(ticket._leaf)
+  }
+
+  private func _arrive(_ index: Int) {
+    typealias SNZI = ScalableNonZeroIndicator
+    let node = _node(index)
+    if index == 0 {
+      node.wrappingIncrement(by: SNZI._one, ordering: .acquiringAndReleasing)
+      return
+    }
+    let parent = (index - 1) / 2
+    var undo = 0
+    while true {
+      var x = node.load(ordering: .acquiring)
+      let count = x & SNZI._countMask
+      if count >= SNZI._one {
+        if node.compareExchange(
+          expected: x,
+          desired: x + SNZI._one,
+          ordering: .acquiringAndReleasing
+        ).exchanged {
+          break
+        }
+        continue
+      }
+      if count == 0 {
+        let version = x >> SNZI._versionShift
+        let y = (version &+ 1) &<< SNZI._versionShift | SNZI._half
+        if !node.compareExchange(
+          expected: x,
+          desired: y,
+          ordering: .acquiringAndReleasing
+        ).exchanged {
+          continue
+        }
+        x = y
+      }
+      // The count is one half: help the first arrival complete.
+      _arrive(parent)
+      if node.compareExchange(
+        expected: x,
+        desired: x & ~SNZI._countMask | SNZI._one,
+        ordering: .acquiringAndReleasing
+      ).exchanged {
+        break
+      }
+      undo += 1
+    }
+    // Arrivals at the parent that didn't end up completing a half state
+    // must be undone.
+    while undo > 0 {
+      _depart(parent)
+      undo -= 1
+    }
+  }
+
+  private func _depart(_ index: Int) {
+    typealias SNZI = ScalableNonZeroIndicator
+    let node = _node(index)
+    if index == 0 {
+      node.wrappingDecrement(by: SNZI._one, ordering: .acquiringAndReleasing)
+      return
+    }
+    while true {
+      let x = node.load(ordering: .relaxed)
+      precondition(x & SNZI._countMask >= SNZI._one, "Unbalanced departure")
+      if node.compareExchange(
+        expected: x,
+        desired: x - SNZI._one,
+        ordering: .acquiringAndReleasing
+      ).exchanged {
+        if x & SNZI._countMask == SNZI._one {
+          _depart((index - 1) / 2)
+        }
+        return
+      }
+    }
+  }
+}
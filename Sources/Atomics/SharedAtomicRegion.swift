@@ -0,0 +1,349 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#if canImport(Darwin)
+import Darwin
+#elseif canImport(Glibc)
+import Glibc
+#elseif canImport(Musl)
+import Musl
+#endif
+
+/// An atomic value type whose atomic representation can be shared between
+/// processes.
+///
+/// Atomic operations on conforming types are lock-free, and therefore
+/// address-free: they work correctly when the same memory is mapped at
+/// different addresses in different processes. Their atomic representations
+/// have the same size, alignment and bit pattern as the values themselves,
+/// and they don't refer to any process-local state (such as pointers or
+/// object references). In particular, zero-filled memory is a valid
+/// representation of zero (or `false`).
+///
+/// Do not declare conformances to this protocol outside of this package.
+public protocol AtomicProcessSharedValue: AtomicValue {}
+
+extension Int: AtomicProcessSharedValue {}
+extension Int64: AtomicProcessSharedValue {}
+extension Int32: AtomicProcessSharedValue {}
+extension Int16: AtomicProcessSharedValue {}
+extension Int8: AtomicProcessSharedValue {}
+extension UInt: AtomicProcessSharedValue {}
+extension UInt64: AtomicProcessSharedValue {}
+extension UInt32: AtomicProcessSharedValue {}
+extension UInt16: AtomicProcessSharedValue {}
+extension UInt8: AtomicProcessSharedValue {}
+extension Bool: AtomicProcessSharedValue {}
+extension DoubleWord: AtomicProcessSharedValue {}
+
+/// A description of the atomic values stored in a `SharedAtomicRegion`.
+///
+/// Layouts are built by allocating slots in a fixed order. The offset of each
+/// slot only depends on the slots allocated before it, and on the size and
+/// alignment of their atomic representations, so processes that build the
+/// same layout (on the same architecture) agree on where every value lives.
+///
+///     var layout = SharedAtomicLayout()
+///     let head = layout.allocate(UInt64.self, cacheLineAligned: true)
+///     let tail = layout.allocate(UInt64.self, cacheLineAligned: true)
+///     let slots = layout.allocate(UInt64.self, count: 1024)
+///
+/// The region starts with a small header that identifies the layout, so
+/// that processes built with different layouts can't accidentally share a
+/// region.
+public struct SharedAtomicLayout {
+  /// A range of atomic values of the same type within a shared region.
+  public struct Slot<Value: AtomicProcessSharedValue> {
+    /// The offset of the first value from the start of the region.
+    public let offset: Int
+
+    /// The number of values in the slot.
+    public let count: Int
+  }
+
+  /// The size of a cache line, for `cacheLineAligned` slots.
+  public static var cacheLineSize: Int { 64 }
+
+  /// The size of the region header. Slots start after it.
+  internal static var _headerSize: Int { 64 }
+
+  /// The size of the region required to hold every slot.
+  public private(set) var size: Int = SharedAtomicLayout._headerSize
+
+  /// An FNV-1a hash of the layout's slots, including their types.
+  internal var _fingerprint: UInt64 = 0xcbf29ce484222325
+
+  internal var _initializers: [(UnsafeMutableRawPointer) -> Void] = []
+
+  public init() {}
+
+  private mutating func _mix(_ value: UInt64) {
+    for shift in stride(from: 0, to: 64, by: 8) {
+      _fingerprint = (_fingerprint ^ (value >> UInt64(shift) & 0xff))
+        &* 0x100000001b3
+    }
+  }
+
+  /// Allocates a slot of `count` consecutive atomic values.
+  ///
+  /// - Parameter type: The type of the values.
+  /// - Parameter count: The number of values in the slot.
+  /// - Parameter initialValue: The value that the process that creates the
+  ///   region stores in each element of the slot.
+  /// - Parameter cacheLineAligned: If true, the slot starts at a cache line
+  ///   boundary and no other slot shares its last cache line, preventing
+  ///   false sharing with neighboring slots.
+  public mutating func allocate<Value: AtomicProcessSharedValue>(
+    _ type: Value.Type,
+    count: Int = 1,
+    initialValue: Value,
+    cacheLineAligned: Bool = false
+  ) -> Slot<Value> {
+    precondition(count > 0, "Invalid count")
+    typealias Storage = Value.AtomicRepresentation
+    var alignment = MemoryLayout<Storage>.alignment
+    if cacheLineAligned {
+      alignment = Swift.max(alignment, SharedAtomicLayout.cacheLineSize)
+    }
+    let offset = (size + alignment - 1) / alignment * alignment
+    size = offset + count * MemoryLayout<Storage>.stride
+    if cacheLineAligned {
+      let line = SharedAtomicLayout.cacheLineSize
+      size = (size + line - 1) / line * line
+    }
+
+    _mix(UInt64(offset))
+    _mix(UInt64(count))
+    _mix(UInt64(MemoryLayout<Storage>.stride))
+    for byte in String(reflecting: Value.self).utf8 {
+      _mix(UInt64(byte))
+    }
+
+    _initializers.append { base in
+      (base + offset)
+        .bindMemory(to: Storage.self, capacity: count)
+        .initialize(repeating: Storage(initialValue), count: count)
+    }
+    return Slot(offset: offset, count: count)
+  }
+}
+
+extension SharedAtomicLayout {
+  /// Allocates a slot of `count` consecutive atomic integers, initially zero.
+  public mutating func allocate<Value: AtomicProcessSharedValue>(
+    _ type: Value.Type,
+    count: Int = 1,
+    cacheLineAligned: Bool = false
+  ) -> Slot<Value> where Value: FixedWidthInteger {
+    allocate(
+      type,
+      count: count,
+      initialValue: 0,
+      cacheLineAligned: cacheLineAligned)
+  }
+}
+
+// Shared regions map files with `mmap`, so they aren't available on Windows.
+#if !os(Windows)
+/// An error creating or opening a shared atomic region.
+public enum SharedAtomicRegionError: Error {
+  /// A system call failed.
+  case systemCall(String, errno: Int32)
+  /// The existing file is smaller than the layout requires.
+  case regionTooSmall(size: Int, required: Int)
+  /// The region was created with a different layout.
+  case layoutMismatch
+}
+
+/// A memory-mapped region that holds atomic values shared between
+/// processes.
+///
+/// Each process maps the same file (for example, one in `/dev/shm` on
+/// Linux) with the same `SharedAtomicLayout`, then accesses the values in
+/// the layout's slots through `UnsafeAtomic` views:
+///
+///     let region = try SharedAtomicRegion(path: "/dev/shm/counters", layout: layout)
+///     region[head].wrappingIncrement(ordering: .relaxed)
+///
+/// The first process to map a new (zero-filled) file initializes its slots;
+/// other processes wait until that is done, then verify that the region was
+/// created with the same layout.
+///
+/// Atomic `UInt32` values in shared regions support `wait` and `wake` across
+/// processes (on Linux), which is sufficient to build blocking primitives
+/// such as cross-process channels.
+///
+/// A region unmaps its memory when it is deinitialized; `UnsafeAtomic`
+/// views of its values must not be used after that.
+public final class SharedAtomicRegion {
+  /// The start of the mapped memory.
+  public let baseAddress: UnsafeMutableRawPointer
+
+  /// The size of the mapped memory, in bytes.
+  public let size: Int
+
+  private let _ownsMapping: Bool
+
+  private enum _State: UInt32 {
+    case uninitialized = 0
+    case initializing = 1
+    case ready = 2
+  }
+
+  private static let _formatVersion: UInt64 = 1
+
+  /// Maps the file at `path` into memory, and attaches to it using `layout`.
+  ///
+  /// - Parameter path: The path of the file that backs the region.
+  /// - Parameter layout: The layout of the atomic values in the region.
+  /// - Parameter create: If true, the file is created if necessary, and
+  ///   extended to the size of the layout.
+  public convenience init(
+    path: String,
+    layout: SharedAtomicLayout,
+    create: Bool = true
+  ) throws {
+    let fd = create
+      ? open(path, O_RDWR | O_CREAT, 0o600)
+      : open(path, O_RDWR)
+    guard fd >= 0 else {
+      throw SharedAtomicRegionError.systemCall("open", errno: errno)
+    }
+    defer { close(fd) }
+
+    var info = stat()
+    guard fstat(fd, &info) == 0 else {
+      throw SharedAtomicRegionError.systemCall("fstat", errno: errno)
+    }
+    var size = Int(info.st_size)
+    if size < layout.size {
+      guard create else {
+        throw SharedAtomicRegionError.regionTooSmall(
+          size: size,
+          required: layout.size)
+      }
+      guard ftruncate(fd, off_t(layout.size)) == 0 else {
+        throw SharedAtomicRegionError.systemCall("ftruncate", errno: errno)
+      }
+      size = layout.size
+    }
+
+    let address = mmap(nil, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+    guard
+      let base = address,
+      base != UnsafeMutableRawPointer(bitPattern: -1)
+    else {
+      throw SharedAtomicRegionError.systemCall("mmap", errno: errno)
+    }
+    do {
+      try self.init(_base: base, size: size, layout: layout, owned: true)
+    } catch {
+      munmap(base, size)
+      throw error
+    }
+  }
+
+  /// Attaches to shared memory that the caller has already mapped, using
+  /// `layout`. The caller is responsible for unmapping the memory after the
+  /// region is deinitialized.
+  ///
+  /// The memory must be zero-filled when it is first attached to.
+  public convenience init(
+    mapping baseAddress: UnsafeMutableRawPointer,
+    size: Int,
+    layout: SharedAtomicLayout
+  ) throws {
+    try self.init(_base: baseAddress, size: size, layout: layout, owned: false)
+  }
+
+  private init(
+    _base base: UnsafeMutableRawPointer,
+    size: Int,
+    layout: SharedAtomicLayout,
+    owned: Bool
+  ) throws {
+    guard size >= layout.size else {
+      throw SharedAtomicRegionError.regionTooSmall(
+        size: size,
+        required: layout.size)
+    }
+    precondition(
+      Int(bitPattern: base) % SharedAtomicLayout.cacheLineSize == 0,
+      "Shared region must be aligned to a cache line")
+
+    // Header: state (UInt32), padding, format version (UInt64),
+    // fingerprint (UInt64), size (UInt64).
+    let state = UnsafeAtomic<UInt32>(
+      at: base.assumingMemoryBound(to: UInt32.AtomicRepresentation.self))
+    let fields = (base + 8).assumingMemoryBound(to: UInt64.self)
+
+    if state.compareExchange(
+      expected: _State.uninitialized.rawValue,
+      desired: _State.initializing.rawValue,
+      ordering: .acquiring
+    ).exchanged {
+      fields[0] = SharedAtomicRegion._formatVersion
+      fields[1] = layout._fingerprint
+      fields[2] = UInt64(layout.size)
+      for initializer in layout._initializers {
+        initializer(base)
+      }
+      state.store(_State.ready.rawValue, ordering: .releasing)
+      state.wakeAll()
+    } else {
+      while true {
+        let current = state.load(ordering: .acquiring)
+        if current == _State.ready.rawValue { break }
+        state.wait(whileEqualTo: current)
+      }
+      guard
+        fields[0] == SharedAtomicRegion._formatVersion,
+        fields[1] == layout._fingerprint,
+        fields[2] == UInt64(layout.size)
+      else {
+        throw SharedAtomicRegionError.layoutMismatch
+      }
+    }
+    self.baseAddress = base
+    self.size = size
+    self._ownsMapping = owned
+  }
+
+  deinit {
+    if _ownsMapping {
+      munmap(baseAddress, size)
+    }
+  }
+
+  /// Returns an atomic view of the first value in `slot`.
+  public subscript<Value>(
+    slot: SharedAtomicLayout.Slot<Value>
+  ) -> UnsafeAtomic<Value> {
+    self[slot, 0]
+  }
+
+  /// Returns an atomic view of the value at `index` in `slot`.
+  public subscript<Value>(
+    slot: SharedAtomicLayout.Slot<Value>,
+    index: Int
+  ) -> UnsafeAtomic<Value> {
+    precondition(index >= 0 && index < slot.count, "Index out of range")
+    precondition(
+      slot.offset + slot.count * MemoryLayout<Value.AtomicRepresentation>.stride
+        <= size,
+      "Slot doesn't belong to this region")
+    let storage = (baseAddress + slot.offset)
+      .assumingMemoryBound(to: Value.AtomicRepresentation.self)
+    return UnsafeAtomic(at: storage + index)
+  }
+}
+#endif // !os(Windows)
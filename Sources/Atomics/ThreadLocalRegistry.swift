@@ -0,0 +1,103 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import _AtomicsShims
+
+/// A piece of per-thread state that one of the modules in this package keeps
+/// in `_ThreadLocalRegistry`.
+///
+/// This is an implementation detail of this package; do not declare
+/// conformances to it outside of the package.
+public protocol _ThreadLocalEntry: AnyObject {
+  /// Called on the owning thread when it exits, after the entry has been
+  /// removed from the thread's registry.
+  func threadDidExit()
+}
+
+/// The per-thread state of every module in this package.
+///
+/// `_AtomicsShims` provides a single thread-local pointer for the whole
+/// process; it points to the current thread's registry, which holds at most
+/// one entry of each `_ThreadLocalEntry` type. This keeps the number of
+/// platform thread-specific data keys the package uses down to one, no
+/// matter how many features keep per-thread state.
+///
+/// When a thread exits, its entries are removed and notified in the order
+/// they were inserted. Entries that are inserted while that happens end up
+/// in a new registry, which is torn down the same way.
+///
+/// This is an implementation detail of this package; do not use it outside
+/// of the package.
+public final class _ThreadLocalRegistry {
+  private var _entries: [(key: ObjectIdentifier, entry: _ThreadLocalEntry)] = []
+
+  private init() {}
+
+  /// The calling thread's registry, if it has one.
+  private static var _current: _ThreadLocalRegistry? {
+    guard let registry = _sa_thread_local_get() else { return nil }
+    return Unmanaged<_ThreadLocalRegistry>.fromOpaque(registry)
+      .takeUnretainedValue()
+  }
+
+  /// Returns the calling thread's registry, creating it if necessary.
+  private static func _forCurrentThread() -> _ThreadLocalRegistry {
+    if let registry = _current { return registry }
+    let registry = _ThreadLocalRegistry()
+    _sa_thread_local_set(Unmanaged.passRetained(registry).toOpaque()) {
+      Unmanaged<_ThreadLocalRegistry>.fromOpaque($0!)
+        .takeRetainedValue()
+        ._threadDidExit()
+    }
+    return registry
+  }
+
+  private func _threadDidExit() {
+    while !_entries.isEmpty {
+      _entries.removeFirst().entry.threadDidExit()
+    }
+  }
+
+  /// Returns the calling thread's entry of type `Entry`, if it has one.
+  public static func entry<Entry: _ThreadLocalEntry>(
+    _ type: Entry.Type
+  ) -> Entry? {
+    guard let registry = _current else { return nil }
+    let key = ObjectIdentifier(type)
+    for item in registry._entries where item.key == key {
+      return unsafeDowncast(item.entry, to: Entry.self)
+    }
+    return nil
+  }
+
+  /// Returns the calling thread's entry of type `Entry`, inserting the
+  /// result of `create` if it doesn't have one.
+  public static func entry<Entry: _ThreadLocalEntry>(
+    _ type: Entry.Type,
+    orInsert create: () -> Entry
+  ) -> Entry {
+    if let entry = self.entry(type) { return entry }
+    let entry = create()
+    _forCurrentThread()._entries.append((ObjectIdentifier(type), entry))
+    return entry
+  }
+
+  /// Removes the calling thread's entry of type `Entry`, if it has one,
+  /// without notifying it.
+  public static func removeEntry<Entry: _ThreadLocalEntry>(
+    _ type: Entry.Type
+  ) {
+    guard let registry = _current else { return }
+    let key = ObjectIdentifier(type)
+    registry._entries.removeAll { $0.key == key }
+  }
+}
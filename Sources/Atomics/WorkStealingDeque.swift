@@ -0,0 +1,334 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// A growable work-stealing deque, following D. Chase and Y. Lev's 2005 paper
+// "Dynamic Circular Work-Stealing Deque" [Chase 2005], with the memory
+// orderings of N. M. Lê, A. Pop, A. Cohen and F. Zappa Nardelli's 2013 paper
+// "Correct and Efficient Work-Stealing for Weak Memory Models" [Lê 2013].
+//
+// The deque holds the elements with indices in `top ..< bottom` in a
+// circular buffer. The owner pushes and pops at the bottom; thieves steal
+// from the top. Only the top is ever updated by a read-modify-write
+// operation: the owner only races with thieves for the last element.
+//
+// Elements are stored as retained object references in `Int` words, so that
+// a thief that speculatively reads a slot (and then loses the race for it)
+// never touches an object it doesn't own.
+//
+// When the buffer is full, the owner copies the elements into a buffer twice
+// as large. Thieves may still be reading the old buffer, so it is retired
+// rather than deallocated. Thieves register themselves in a scalable nonzero
+// indicator for the duration of each steal; the owner deallocates retired
+// buffers once it sees the indicator at zero after publishing the new
+// buffer, since any later thief is guaranteed to see the new one.
+
+/// A double-ended queue for work-stealing task schedulers.
+///
+/// Each deque has a single owner thread that pushes and pops elements at
+/// one end (in last-in, first-out order), without read-modify-write
+/// operations in the common case. Any number of other threads may steal
+/// elements from the other end (in first-in, first-out order) using
+/// compare-exchange operations.
+///
+///     // Worker `i`:
+///     while let task = deques[i].pop() ?? deques[victim].steal() {
+///       task.run()
+///     }
+///
+/// The deque grows as needed, and never shrinks.
+public final class WorkStealingDeque<Element: AnyObject> {
+  private static var _lineSize: Int { 64 }
+
+  // Line 0: top. Line 1: bottom, buffer.
+  private let _indices: UnsafeMutableRawPointer
+  private let _thieves: ScalableNonZeroIndicator
+
+  // Owner-private state.
+  private var _retired: [_WorkStealingBuffer] = []
+
+  /// Creates an empty deque.
+  ///
+  /// - Parameter capacity: The initial capacity of the deque, rounded up to
+  ///   a power of two.
+  public init(capacity: Int = 64) {
+    precondition(capacity > 0, "Invalid capacity")
+    var rounded = 1
+    while rounded < capacity { rounded *= 2 }
+
+    let lineSize = WorkStealingDeque._lineSize
+    _indices = .allocate(byteCount: 2 * lineSize, alignment: lineSize)
+    _thieves = ScalableNonZeroIndicator()
+    _word(0).initialize(to: Int.AtomicRepresentation(0))
+    _word(1).initialize(to: Int.AtomicRepresentation(0))
+    let buffer = _WorkStealingBuffer.allocate(capacity: rounded)
+    _word(1, offset: 1)
+      .initialize(to: Int.AtomicRepresentation(buffer.rawValue))
+  }
+
+  deinit {
+    let buffer = _loadBuffer(ordering: .relaxed)
+    let top = _top.load(ordering: .relaxed)
+    let bottom = _bottom.load(ordering: .relaxed)
+    for index in top ..< Swift.max(top, bottom) {
+      _ = buffer.take(at: index) as Element
+    }
+    buffer.deallocate()
+    _retired.forEach { $0.deallocate() }
+    _indices.deallocate()
+  }
+
+  private func _word(
+    _ line: Int,
+    offset: Int = 0
+  ) -> UnsafeMutablePointer<Int.AtomicRepresentation> {
+    (_indices + line * WorkStealingDeque._lineSize)
+      .assumingMemoryBound(to: Int.AtomicRepresentation.self) + offset
+  }
+
+  private var _top: UnsafeAtomic<Int> { UnsafeAtomic(at: _word(0)) }
+  private var _bottom: UnsafeAtomic<Int> { UnsafeAtomic(at: _word(1)) }
+  private var _buffer: UnsafeAtomic<Int> {
+    UnsafeAtomic(at: _word(1, offset: 1))
+  }
+
+  private func _loadBuffer(
+    ordering: AtomicLoadOrdering
+  ) -> _WorkStealingBuffer {
+    _WorkStealingBuffer(rawValue: _buffer.load(ordering: ordering))
+  }
+
+  /// The number of elements in the deque. This is only a snapshot when
+  /// other threads are stealing elements.
+  public var count: Int {
+    let top = _top.load(ordering: .relaxed)
+    let bottom = _bottom.load(ordering: .relaxed)
+    return Swift.max(0, bottom - top)
+  }
+
+  /// Returns true if the deque contained no elements at the time of the
+  /// call.
+  public var isEmpty: Bool { count == 0 }
+}
+
+extension WorkStealingDeque {
+  /// Adds an element to the bottom of the deque.
+  ///
+  /// This must only be called by the owner.
+  public func push(_ element: Element) {
+    let bottom = _bottom.load(ordering: .relaxed)
+    let top = _top.load(ordering: .acquiring)
+    var buffer = _loadBuffer(ordering: .relaxed)
+    if bottom - top > buffer.capacity - 1 {
+      buffer = _grow(buffer, top: top, bottom: bottom)
+    } else if !_retired.isEmpty {
+      _reclaim()
+    }
+    buffer.put(element, at: bottom)
+    atomicMemoryFence(ordering: .releasing)
+    _bottom.store(bottom + 1, ordering: .relaxed)
+  }
+
+  /// Removes and returns the element at the bottom of the deque (the one
+  /// most recently pushed), or returns nil if the deque is empty.
+  ///
+  /// This must only be called by the owner.
+  public func pop() -> Element? {
+    let bottom = _bottom.load(ordering: .relaxed) - 1
+    let buffer = _loadBuffer(ordering: .relaxed)
+    _bottom.store(bottom, ordering: .relaxed)
+    atomicMemoryFence(ordering: .sequentiallyConsistent)
+    let top = _top.load(ordering: .relaxed)
+    guard top <= bottom else {
+      // Empty.
+      _bottom.store(bottom + 1, ordering: .relaxed)
+      return nil
+    }
+    guard top == bottom else {
+      // No thief can reach this element.
+      return buffer.take(at: bottom) as Element
+    }
+    // This is the last element; race thieves for it.
+    let won = _top.compareExchange(
+      expected: top,
+      desired: top + 1,
+      successOrdering: .sequentiallyConsistent,
+      failureOrdering: .relaxed
+    ).exchanged
+    _bottom.store(bottom + 1, ordering: .relaxed)
+    return won ? buffer.take(at: bottom) as Element : nil
+  }
+
+  /// Removes and returns the element at the top of the deque (the one
+  /// least recently pushed), or returns nil if the deque is empty.
+  ///
+  /// This may be called from any thread.
+  public func steal() -> Element? {
+    let ticket = _thieves.arrive()
+    defer { _thieves.depart(ticket) }
+    while true {
+      switch _steal() {
+      case .success(let element): return element
+      case .empty: return nil
+      case .lostRace: continue
+      }
+    }
+  }
+
+  /// Steals up to `maxCount` elements (but no more than half of the
+  /// deque's elements, rounded up) from the top of this deque. The first
+  /// stolen element is returned; the rest are pushed to `destination`,
+  /// which must be owned by the calling thread.
+  ///
+  /// Moving a batch of elements at a time reduces how often idle workers
+  /// need to go looking for work. Each element is still claimed with its
+  /// own compare-exchange: the owner pops elements without synchronizing
+  /// with thieves unless it reaches the last one, so a thief can't safely
+  /// claim several elements at once.
+  public func steal(
+    maxCount: Int,
+    into destination: WorkStealingDeque
+  ) -> Element? {
+    precondition(maxCount > 0, "Invalid count")
+    precondition(destination !== self, "Can't steal into the same deque")
+    let ticket = _thieves.arrive()
+    defer { _thieves.depart(ticket) }
+    let limit = Swift.min(maxCount, (count + 1) / 2)
+    var first: Element? = nil
+    var stolen = 0
+    while stolen < Swift.max(1, limit) {
+      switch _steal() {
+      case .success(let element):
+        if first == nil {
+          first = element
+        } else {
+          destination.push(element)
+        }
+        stolen += 1
+      case .empty:
+        return first
+      case .lostRace:
+        continue
+      }
+    }
+    return first
+  }
+
+  private enum _StealResult {
+    case success(Element)
+    case empty
+    case lostRace
+  }
+
+  private func _steal() -> _StealResult {
+    let top = _top.load(ordering: .acquiring)
+    atomicMemoryFence(ordering: .sequentiallyConsistent)
+    let bottom = _bottom.load(ordering: .acquiring)
+    guard top < bottom else { return .empty }
+    let buffer = _loadBuffer(ordering: .acquiring)
+    let word = buffer.peek(at: top)
+    guard _top.compareExchange(
+      expected: top,
+      desired: top + 1,
+      successOrdering: .sequentiallyConsistent,
+      failureOrdering: .relaxed
+    ).exchanged else {
+      return .lostRace
+    }
+    return .success(_WorkStealingBuffer.unwrap(word))
+  }
+
+  private func _grow(
+    _ buffer: _WorkStealingBuffer,
+    top: Int,
+    bottom: Int
+  ) -> _WorkStealingBuffer {
+    let new = _WorkStealingBuffer.allocate(capacity: 2 * buffer.capacity)
+    for index in top ..< bottom {
+      new.copy(from: buffer, at: index)
+    }
+    _buffer.store(new.rawValue, ordering: .releasing)
+    _retired.append(buffer)
+    _reclaim()
+    return new
+  }
+
+  private func _reclaim() {
+    // Thieves that arrive after this point will see the current buffer.
+    atomicMemoryFence(ordering: .sequentiallyConsistent)
+    if !_thieves.isNonZero {
+      _retired.forEach { $0.deallocate() }
+      _retired.removeAll()
+    }
+  }
+}
+
+/// A circular buffer of retained object references, stored as `Int` words.
+/// The first word holds the capacity, which is a power of two.
+internal struct _WorkStealingBuffer {
+  let words: UnsafeMutablePointer<Int.AtomicRepresentation>
+
+  init(rawValue: Int) {
+    words = UnsafeMutablePointer(bitPattern: rawValue)!
+  }
+
+  private init(words: UnsafeMutablePointer<Int.AtomicRepresentation>) {
+    self.words = words
+  }
+
+  var rawValue: Int { Int(bitPattern: words) }
+
+  static func allocate(capacity: Int) -> _WorkStealingBuffer {
+    let words = UnsafeMutablePointer<Int.AtomicRepresentation>
+      .allocate(capacity: capacity + 1)
+    words.initialize(
+      repeating: Int.AtomicRepresentation(0),
+      count: capacity + 1)
+    UnsafeAtomic(at: words).store(capacity, ordering: .relaxed)
+    return _WorkStealingBuffer(words: words)
+  }
+
+  func deallocate() {
+    words.deinitialize(count: capacity + 1)
+    words.deallocate()
+  }
+
+  var capacity: Int {
+    UnsafeAtomic(at: words).load(ordering: .relaxed)
+  }
+
+  private func slot(_ index: Int) -> UnsafeAtomic<Int> {
+    UnsafeAtomic(at: words + 1 + (index & (capacity - 1)))
+  }
+
+  func put<Element: AnyObject>(_ element: Element, at index: Int) {
+    let word = Int(bitPattern: Unmanaged.passRetained(element).toOpaque())
+    slot(index).store(word, ordering: .relaxed)
+  }
+
+  func peek(at index: Int) -> Int {
+    slot(index).load(ordering: .relaxed)
+  }
+
+  func take<Element: AnyObject>(at index: Int) -> Element {
+    _WorkStealingBuffer.unwrap(peek(at: index))
+  }
+
+  func copy(from other: _WorkStealingBuffer, at index: Int) {
+    slot(index).store(other.peek(at: index), ordering: .relaxed)
+  }
+
+  static func unwrap<Element: AnyObject>(_ word: Int) -> Element {
+    Unmanaged<Element>
+      .fromOpaque(UnsafeRawPointer(bitPattern: word)!)
+      .takeRetainedValue()
+  }
+}
@@ -57,6 +57,16 @@ extension Bool.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Bool.AtomicRepresentation>,
     ordering: AtomicLoadOrdering
   ) -> Bool {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.load(at: pointer, ordering: ordering) {
+        _sa_load_relaxed_Bool(_extract(pointer))
+      }
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.load, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_load_relaxed_Bool(_extract(pointer))
@@ -76,6 +86,20 @@ extension Bool.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Bool.AtomicRepresentation>,
     ordering: AtomicStoreOrdering
   ) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      _AtomicModel.store(
+        desired,
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Bool(_extract(pointer)) },
+        { _sa_store_relaxed_Bool(_extract(pointer), desired) })
+      return
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.store, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       _sa_store_relaxed_Bool(_extract(pointer), desired)
@@ -95,6 +119,27 @@ extension Bool.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Bool.AtomicRepresentation>,
     ordering: AtomicUpdateOrdering
   ) -> Bool {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Bool(_extract(pointer)) },
+        { (_sa_exchange_relaxed_Bool(_extract(pointer), desired), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       return _sa_exchange_relaxed_Bool(_extract(pointer), desired)
@@ -119,8 +164,34 @@ extension Bool.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Bool.AtomicRepresentation>,
     ordering: AtomicUpdateOrdering
   ) -> (exchanged: Bool, original: Bool) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Bool(_extract(pointer)) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_Bool(
+            _extract(pointer),
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       exchanged = _sa_cmpxchg_strong_relaxed_relaxed_Bool(
@@ -145,6 +216,11 @@ extension Bool.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -157,8 +233,35 @@ extension Bool.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Bool) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: successOrdering,
+        failureOrdering: failureOrdering,
+        current: { _sa_load_relaxed_Bool(_extract(pointer)) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_Bool(
+            _extract(pointer),
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -242,6 +345,11 @@ extension Bool.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -254,8 +362,28 @@ extension Bool.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Bool) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      // The model checker doesn't simulate spurious failures.
+      return atomicCompareExchange(
+        expected: expected,
+        desired: desired,
+        at: pointer,
+        successOrdering: successOrdering,
+        failureOrdering: failureOrdering)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -339,6 +467,11 @@ extension Bool.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 }
@@ -363,6 +496,18 @@ extension Bool.AtomicRepresentation {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Bool(_extract(pointer)) },
+        { (_sa_fetch_and_relaxed_Bool(_extract(pointer), operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_and_relaxed_Bool(
@@ -404,6 +549,18 @@ extension Bool.AtomicRepresentation {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Bool(_extract(pointer)) },
+        { (_sa_fetch_or_relaxed_Bool(_extract(pointer), operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_or_relaxed_Bool(
@@ -445,6 +602,18 @@ extension Bool.AtomicRepresentation {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Bool(_extract(pointer)) },
+        { (_sa_fetch_xor_relaxed_Bool(_extract(pointer), operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_xor_relaxed_Bool(
@@ -0,0 +1,161 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// #############################################################################
+// #                                                                           #
+// #            DO NOT EDIT THIS FILE; IT IS AUTOGENERATED.                    #
+// #                                                                           #
+// #############################################################################
+
+import _AtomicsShims
+
+/// The outcome of waiting for an atomic value to change.
+public enum AtomicWaitResult {
+  /// The thread was woken up by a call to `wake`, or spuriously. The value
+  /// may or may not have changed.
+  case woken
+  /// The value did not equal the expected value.
+  case valueChanged
+  /// The timeout expired before the thread was woken up.
+  case timedOut
+}
+
+@usableFromInline
+internal func _atomicWait(
+  _ address: UnsafeRawPointer,
+  whileEqualTo expected: UInt32,
+  timeoutNanoseconds timeout: Int?
+) -> AtomicWaitResult {
+  precondition(timeout ?? 0 >= 0, "Negative timeout")
+  switch _sa_wait(address, expected, Int64(timeout ?? -1)) {
+  case SWIFTATOMIC_WAIT_WOKEN: return .woken
+  case SWIFTATOMIC_WAIT_TIMED_OUT: return .timedOut
+  default: return .valueChanged
+  }
+}
+
+@usableFromInline @discardableResult
+internal func _atomicWake(_ address: UnsafeRawPointer, count: Int) -> Int {
+  precondition(count >= 0, "Negative count")
+  return Int(_sa_wake(address, Int32(clamping: count)))
+}
+
+extension UnsafeAtomic where Value == UInt32 {
+  /// Blocks the current thread as long as this atomic value equals
+  /// `expected`, until another thread calls `wake` on it, or until the
+  /// (optional) timeout expires.
+  ///
+  /// The comparison and the decision to sleep happen atomically with respect
+  /// to `wake`: a wake-up that follows a store of a different value can't be
+  /// missed. However, waits may end spuriously, so callers must check the
+  /// value again in a loop:
+  ///
+  ///     while state.load(ordering: .acquiring) == locked {
+  ///       state.wait(whileEqualTo: locked)
+  ///     }
+  ///
+  /// On Linux, this is a futex wait that also works across processes, when
+  /// the value is in memory shared between them (see `SharedAtomicRegion`).
+  /// On Windows, it uses `WaitOnAddress`, which only works within a process.
+  /// On other platforms, it falls back to polling the value.
+  ///
+  /// - Parameter expected: The value to wait on.
+  /// - Parameter timeoutNanoseconds: The maximum time to wait, or nil to wait
+  ///   indefinitely.
+  /// - Returns: Whether the thread was woken up, didn't need to wait, or
+  ///   timed out.
+  @inlinable @discardableResult
+  public func wait(
+    whileEqualTo expected: UInt32,
+    timeoutNanoseconds: Int? = nil
+  ) -> AtomicWaitResult {
+    _atomicWait(
+      UnsafeRawPointer(_ptr),
+      whileEqualTo: expected,
+      timeoutNanoseconds: timeoutNanoseconds)
+  }
+
+  /// Wakes up at most `count` threads that are waiting on this atomic value.
+  ///
+  /// Call this after changing the value; waking doesn't imply any memory
+  /// ordering by itself.
+  ///
+  /// - Parameter count: The maximum number of threads to wake up.
+  /// - Returns: The number of threads that were woken up, if known. (On
+  ///   platforms other than Linux, this is always zero.)
+  @inlinable @discardableResult
+  public func wake(count: Int = 1) -> Int {
+    _atomicWake(UnsafeRawPointer(_ptr), count: count)
+  }
+
+  /// Wakes up all threads that are waiting on this atomic value.
+  @inlinable
+  public func wakeAll() {
+    _atomicWake(UnsafeRawPointer(_ptr), count: Int(Int32.max))
+  }
+}
+
+extension ManagedAtomic where Value == UInt32 {
+  /// Blocks the current thread as long as this atomic value equals
+  /// `expected`, until another thread calls `wake` on it, or until the
+  /// (optional) timeout expires.
+  ///
+  /// The comparison and the decision to sleep happen atomically with respect
+  /// to `wake`: a wake-up that follows a store of a different value can't be
+  /// missed. However, waits may end spuriously, so callers must check the
+  /// value again in a loop:
+  ///
+  ///     while state.load(ordering: .acquiring) == locked {
+  ///       state.wait(whileEqualTo: locked)
+  ///     }
+  ///
+  /// On Linux, this is a futex wait that also works across processes, when
+  /// the value is in memory shared between them (see `SharedAtomicRegion`).
+  /// On Windows, it uses `WaitOnAddress`, which only works within a process.
+  /// On other platforms, it falls back to polling the value.
+  ///
+  /// - Parameter expected: The value to wait on.
+  /// - Parameter timeoutNanoseconds: The maximum time to wait, or nil to wait
+  ///   indefinitely.
+  /// - Returns: Whether the thread was woken up, didn't need to wait, or
+  ///   timed out.
+  @inlinable @discardableResult
+  public func wait(
+    whileEqualTo expected: UInt32,
+    timeoutNanoseconds: Int? = nil
+  ) -> AtomicWaitResult {
+    _atomicWait(
+      UnsafeRawPointer(_ptr),
+      whileEqualTo: expected,
+      timeoutNanoseconds: timeoutNanoseconds)
+  }
+
+  /// Wakes up at most `count` threads that are waiting on this atomic value.
+  ///
+  /// Call this after changing the value; waking doesn't imply any memory
+  /// ordering by itself.
+  ///
+  /// - Parameter count: The maximum number of threads to wake up.
+  /// - Returns: The number of threads that were woken up, if known. (On
+  ///   platforms other than Linux, this is always zero.)
+  @inlinable @discardableResult
+  public func wake(count: Int = 1) -> Int {
+    _atomicWake(UnsafeRawPointer(_ptr), count: count)
+  }
+
+  /// Wakes up all threads that are waiting on this atomic value.
+  @inlinable
+  public func wakeAll() {
+    _atomicWake(UnsafeRawPointer(_ptr), count: Int(Int32.max))
+  }
+}
+
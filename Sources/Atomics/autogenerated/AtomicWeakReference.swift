@@ -0,0 +1,440 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// #############################################################################
+// #                                                                           #
+// #            DO NOT EDIT THIS FILE; IT IS AUTOGENERATED.                    #
+// #                                                                           #
+// #############################################################################
+
+
+/// An immutable box holding a weak reference to an object.
+///
+/// Atomic weak references are represented by atomic strong references to
+/// instances of this class. Boxes are never mutated after their creation, so
+/// replacing the target of a weak reference always allocates a new box. A nil
+/// reference is represented by a nil box.
+@usableFromInline
+internal final class _AtomicWeakBox {
+  @usableFromInline
+  internal weak var _value: AnyObject?
+
+  @usableFromInline
+  internal init(_ value: AnyObject) {
+    self._value = value
+  }
+
+  @usableFromInline
+  internal static func _box(_ value: __owned AnyObject?) -> _AtomicWeakBox? {
+    guard let value = value else { return nil }
+    return _AtomicWeakBox(value)
+  }
+
+  @usableFromInline
+  internal static func _unbox(_ box: AnyObject?) -> AnyObject? {
+    guard let box = box else { return nil }
+    return unsafeDowncast(box, to: _AtomicWeakBox.self)._value
+  }
+}
+
+extension _AtomicWeakBox {
+  @usableFromInline
+  internal static func atomicLoad(
+    at pointer: UnsafeMutablePointer<_AtomicReferenceStorage>
+  ) -> AnyObject? {
+    // Loading the box gives us a strong reference to it, which keeps it alive
+    // while we upgrade its contents to a strong reference.
+    _unbox(_AtomicReferenceStorage.atomicLoad(at: pointer))
+  }
+
+  @usableFromInline
+  internal static func atomicExchange(
+    _ desired: __owned AnyObject?,
+    at pointer: UnsafeMutablePointer<_AtomicReferenceStorage>
+  ) -> AnyObject? {
+    let original = _AtomicReferenceStorage.atomicExchange(
+      _box(desired),
+      at: pointer)
+    return _unbox(original)
+  }
+
+  @usableFromInline
+  internal static func atomicCompareExchange(
+    expected: AnyObject?,
+    desired: __owned AnyObject?,
+    at pointer: UnsafeMutablePointer<_AtomicReferenceStorage>
+  ) -> (exchanged: Bool, original: AnyObject?) {
+    let new = _box(desired)
+    var box = _AtomicReferenceStorage.atomicLoad(at: pointer)
+    while true {
+      // Holding on to a strong reference to the current value prevents it
+      // from getting deallocated until we're done; so if the box doesn't
+      // change, then neither does its contents.
+      let current = _unbox(box)
+      guard current === expected else { return (false, current) }
+      let (exchanged, original) = _AtomicReferenceStorage.atomicCompareExchange(
+        expected: box,
+        desired: new,
+        at: pointer)
+      if exchanged { return (true, current) }
+      // Someone else replaced the box. It may still refer to the expected
+      // instance (or to a deallocated one when `expected` is nil), so check
+      // again.
+      box = original
+    }
+  }
+}
+
+/// The storage representation for an atomic weak reference.
+///
+/// Atomic weak references do not keep their target instance alive; once the
+/// last strong reference to it goes away, the atomic weak reference reads as
+/// nil. Loading an atomic weak reference returns a strong reference to its
+/// target, if it still exists.
+///
+/// This type provides the same pointer-based operations as
+/// `AtomicOptionalReferenceStorage`. Instead of directly handling it, it is
+/// usually better to use the `UnsafeAtomicWeakReference` or
+/// `ManagedAtomicWeakReference` types.
+public struct AtomicWeakReferenceStorage<Instance: AnyObject> {
+  @usableFromInline
+  internal var _storage: _AtomicReferenceStorage
+
+  @inlinable
+  public init(_ value: __owned Instance?) {
+    _storage = .init(_AtomicWeakBox._box(value))
+  }
+
+  @inlinable
+  public func dispose() -> Instance? {
+    guard let value = _AtomicWeakBox._unbox(_storage.dispose()) else {
+      return nil
+    }
+    return unsafeDowncast(value, to: Instance.self)
+  }
+}
+
+extension AtomicWeakReferenceStorage {
+  @inlinable @inline(__always)
+  @_alwaysEmitIntoClient
+  static func _extract(
+    _ ptr: UnsafeMutablePointer<Self>
+  ) -> UnsafeMutablePointer<_AtomicReferenceStorage> {
+    // `Self` is layout-compatible with its only stored property.
+    return UnsafeMutableRawPointer(ptr)
+      .assumingMemoryBound(to: _AtomicReferenceStorage.self)
+  }
+}
+
+extension AtomicWeakReferenceStorage: AtomicStorage {
+  public typealias Value = Instance?
+
+  @inlinable @inline(__always)
+  @_alwaysEmitIntoClient
+  @_semantics("atomics.requires_constant_orderings")
+  public static func atomicLoad(
+    at pointer: UnsafeMutablePointer<Self>,
+    ordering: AtomicLoadOrdering
+  ) -> Instance? {
+    // FIXME: All orderings are treated as acquiring-and-releasing.
+    let result = _AtomicWeakBox.atomicLoad(at: _extract(pointer))
+    guard let r = result else { return nil }
+    return unsafeDowncast(r, to: Instance.self)
+  }
+
+  @inlinable @inline(__always)
+  @_alwaysEmitIntoClient
+  @_semantics("atomics.requires_constant_orderings")
+  public static func atomicStore(
+    _ desired: __owned Instance?,
+    at pointer: UnsafeMutablePointer<Self>,
+    ordering: AtomicStoreOrdering
+  ) {
+    // FIXME: All orderings are treated as acquiring-and-releasing.
+    _ = _AtomicWeakBox.atomicExchange(desired, at: _extract(pointer))
+  }
+
+  @inlinable @inline(__always)
+  @_alwaysEmitIntoClient
+  @_semantics("atomics.requires_constant_orderings")
+  public static func atomicExchange(
+    _ desired: __owned Instance?,
+    at pointer: UnsafeMutablePointer<Self>,
+    ordering: AtomicUpdateOrdering
+  ) -> Instance? {
+    // FIXME: All orderings are treated as acquiring-and-releasing.
+    let result = _AtomicWeakBox.atomicExchange(desired, at: _extract(pointer))
+    guard let r = result else { return nil }
+    return unsafeDowncast(r, to: Instance.self)
+  }
+
+  @inlinable @inline(__always)
+  @_alwaysEmitIntoClient
+  @_semantics("atomics.requires_constant_orderings")
+  public static func atomicCompareExchange(
+    expected: Instance?,
+    desired: __owned Instance?,
+    at pointer: UnsafeMutablePointer<Self>,
+    ordering: AtomicUpdateOrdering
+  ) -> (exchanged: Bool, original: Instance?) {
+    // FIXME: All orderings are treated as acquiring-and-releasing.
+    let result = _AtomicWeakBox.atomicCompareExchange(
+      expected: expected,
+      desired: desired,
+      at: _extract(pointer))
+    guard let original = result.original else { return (result.exchanged, nil) }
+    return (result.exchanged, unsafeDowncast(original, to: Instance.self))
+  }
+
+  @inlinable @inline(__always)
+  @_alwaysEmitIntoClient
+  @_semantics("atomics.requires_constant_orderings")
+  public static func atomicCompareExchange(
+    expected: Instance?,
+    desired: __owned Instance?,
+    at pointer: UnsafeMutablePointer<Self>,
+    successOrdering: AtomicUpdateOrdering,
+    failureOrdering: AtomicLoadOrdering
+  ) -> (exchanged: Bool, original: Instance?) {
+    // FIXME: All orderings are treated as acquiring-and-releasing.
+    let result = _AtomicWeakBox.atomicCompareExchange(
+      expected: expected,
+      desired: desired,
+      at: _extract(pointer))
+    guard let original = result.original else { return (result.exchanged, nil) }
+    return (result.exchanged, unsafeDowncast(original, to: Instance.self))
+  }
+
+  @inlinable @inline(__always)
+  @_alwaysEmitIntoClient
+  @_semantics("atomics.requires_constant_orderings")
+  public static func atomicWeakCompareExchange(
+    expected: Instance?,
+    desired: __owned Instance?,
+    at pointer: UnsafeMutablePointer<Self>,
+    successOrdering: AtomicUpdateOrdering,
+    failureOrdering: AtomicLoadOrdering
+  ) -> (exchanged: Bool, original: Instance?) {
+    // FIXME: All orderings are treated as acquiring-and-releasing.
+    let result = _AtomicWeakBox.atomicCompareExchange(
+      expected: expected,
+      desired: desired,
+      at: _extract(pointer))
+    guard let original = result.original else { return (result.exchanged, nil) }
+    return (result.exchanged, unsafeDowncast(original, to: Instance.self))
+  }
+}
+
+/// An unsafe reference type holding an atomic weak reference, requiring
+/// manual memory management of the underlying storage representation.
+///
+/// An atomic weak reference does not keep its target alive. Loading it
+/// returns a strong reference to its target if the target still exists, or
+/// nil otherwise.
+@frozen
+public struct UnsafeAtomicWeakReference<Instance: AnyObject> {
+  /// The value logically stored in an atomic weak reference value.
+  public typealias Value = Instance?
+
+  /// The storage representation for an atomic weak reference value.
+  public typealias Storage = AtomicWeakReferenceStorage<Instance>
+
+  @usableFromInline
+  internal let _ptr: UnsafeMutablePointer<Storage>
+
+  /// Initialize an unsafe atomic weak reference that uses the supplied memory
+  /// location for storage. The storage location must already be initialized
+  /// to represent a valid atomic value.
+  ///
+  /// At the end of the lifetime of the atomic value, you must manually ensure
+  /// that the storage location is correctly `dispose()`d, deinitalized and
+  /// deallocated.
+  ///
+  /// Note: This is not an atomic operation.
+  @_transparent // Debug performance
+  public init(@_nonEphemeral at pointer: UnsafeMutablePointer<Storage>) {
+    _ptr = pointer
+  }
+
+  /// Create a new `UnsafeAtomicWeakReference` value with the supplied initial
+  /// target by dynamically allocating storage for it.
+  ///
+  /// This call is usually paired with `destroy` to get rid of the allocated
+  /// storage at the end of its lifetime.
+  ///
+  /// Note: This is not an atomic operation.
+  @inlinable
+  public static func create(_ initialValue: Instance? = nil) -> Self {
+    let ptr = UnsafeMutablePointer<Storage>.allocate(capacity: 1)
+    ptr.initialize(to: Storage(initialValue))
+    return Self(at: ptr)
+  }
+
+  /// Disposes of the current value of the storage location corresponding to
+  /// this unsafe atomic weak reference, then deinitializes and deallocates
+  /// the storage.
+  ///
+  /// Note: This is not an atomic operation.
+  ///
+  /// - Returns: The last value stored in the storage representation before it
+  ///   was destroyed, if its target is still alive.
+  @discardableResult
+  @inlinable
+  public func destroy() -> Value {
+    let result = _ptr.pointee.dispose()
+    _ptr.deinitialize(count: 1)
+    _ptr.deallocate()
+    return result
+  }
+}
+
+/// A reference type holding an atomic weak reference, with automatic memory
+/// management.
+///
+/// An atomic weak reference does not keep its target alive. Loading it
+/// returns a strong reference to its target if the target still exists, or
+/// nil otherwise.
+public class ManagedAtomicWeakReference<Instance: AnyObject> {
+  /// The value logically stored in an atomic weak reference value.
+  public typealias Value = Instance?
+
+  @usableFromInline
+  internal typealias Storage = AtomicWeakReferenceStorage<Instance>
+
+  @usableFromInline
+  internal var _storage: Storage
+
+  /// Initializes a new managed atomic weak reference with the specified
+  /// initial target.
+  @inlinable
+  public init(_ value: Instance? = nil) {
+    _storage = Storage(value)
+  }
+
+  deinit {
+    _ = _storage.dispose()
+  }
+
+  @_alwaysEmitIntoClient @inline(__always)
+  internal var _ptr: UnsafeMutablePointer<Storage> {
+    _getUnsafePointerToStoredProperties(self).assumingMemoryBound(to: Storage.self)
+  }
+}
+
+extension UnsafeAtomicWeakReference {
+  /// Atomically loads the current target of this weak reference, and returns
+  /// a strong reference to it. If the target has already been deallocated,
+  /// then this returns nil.
+  ///
+  /// This operation uses acquiring-and-releasing memory ordering.
+  @inlinable
+  public func load() -> Instance? {
+    Storage.atomicLoad(at: _ptr, ordering: .acquiring)
+  }
+
+  /// Atomically replaces the target of this weak reference with `desired`.
+  ///
+  /// This operation uses acquiring-and-releasing memory ordering.
+  @inlinable
+  public func store(_ desired: Instance?) {
+    Storage.atomicStore(desired, at: _ptr, ordering: .releasing)
+  }
+
+  /// Atomically replaces the target of this weak reference with `desired`,
+  /// and returns a strong reference to its original target, if it still
+  /// exists.
+  ///
+  /// This operation uses acquiring-and-releasing memory ordering.
+  @inlinable
+  public func exchange(_ desired: Instance?) -> Instance? {
+    Storage.atomicExchange(desired, at: _ptr, ordering: .acquiringAndReleasing)
+  }
+
+  /// Atomically replaces the target of this weak reference with `desired`,
+  /// but only if its current target is identical to `expected`.
+  ///
+  /// A weak reference whose original target has been deallocated compares
+  /// equal to `nil`.
+  ///
+  /// This operation uses acquiring-and-releasing memory ordering.
+  ///
+  /// - Parameter expected: The expected current target.
+  /// - Parameter desired: The desired new target.
+  /// - Returns: A tuple `(exchanged, original)`, where `exchanged` is true if
+  ///   the exchange was successful, and `original` is a strong reference to
+  ///   the original target.
+  @inlinable
+  public func compareExchange(
+    expected: Instance?,
+    desired: Instance?
+  ) -> (exchanged: Bool, original: Instance?) {
+    Storage.atomicCompareExchange(
+      expected: expected,
+      desired: desired,
+      at: _ptr,
+      ordering: .acquiringAndReleasing)
+  }
+}
+extension ManagedAtomicWeakReference {
+  /// Atomically loads the current target of this weak reference, and returns
+  /// a strong reference to it. If the target has already been deallocated,
+  /// then this returns nil.
+  ///
+  /// This operation uses acquiring-and-releasing memory ordering.
+  @inlinable
+  public func load() -> Instance? {
+    Storage.atomicLoad(at: _ptr, ordering: .acquiring)
+  }
+
+  /// Atomically replaces the target of this weak reference with `desired`.
+  ///
+  /// This operation uses acquiring-and-releasing memory ordering.
+  @inlinable
+  public func store(_ desired: Instance?) {
+    Storage.atomicStore(desired, at: _ptr, ordering: .releasing)
+  }
+
+  /// Atomically replaces the target of this weak reference with `desired`,
+  /// and returns a strong reference to its original target, if it still
+  /// exists.
+  ///
+  /// This operation uses acquiring-and-releasing memory ordering.
+  @inlinable
+  public func exchange(_ desired: Instance?) -> Instance? {
+    Storage.atomicExchange(desired, at: _ptr, ordering: .acquiringAndReleasing)
+  }
+
+  /// Atomically replaces the target of this weak reference with `desired`,
+  /// but only if its current target is identical to `expected`.
+  ///
+  /// A weak reference whose original target has been deallocated compares
+  /// equal to `nil`.
+  ///
+  /// This operation uses acquiring-and-releasing memory ordering.
+  ///
+  /// - Parameter expected: The expected current target.
+  /// - Parameter desired: The desired new target.
+  /// - Returns: A tuple `(exchanged, original)`, where `exchanged` is true if
+  ///   the exchange was successful, and `original` is a strong reference to
+  ///   the original target.
+  @inlinable
+  public func compareExchange(
+    expected: Instance?,
+    desired: Instance?
+  ) -> (exchanged: Bool, original: Instance?) {
+    Storage.atomicCompareExchange(
+      expected: expected,
+      desired: desired,
+      at: _ptr,
+      ordering: .acquiringAndReleasing)
+  }
+}
@@ -503,51 +503,956 @@ extension UnsafeAtomic where Value: AtomicInteger {
       ordering: ordering)
   }
 }
+
+extension UnsafeAtomic where Value == DoubleWord {
+  /// Perform an atomic compare and exchange operation on the high
+  /// word of the current value, leaving the other word intact, and applying
+  /// the specified memory ordering.
+  ///
+  /// This operation performs the following algorithm as a single atomic
+  /// transaction:
+  ///
+  /// ```
+  /// atomic(self) { currentValue in
+  ///   let original = currentValue
+  ///   guard original.high == expected else { return (false, original) }
+  ///   currentValue.high = desired
+  ///   return (true, original)
+  /// }
+  /// ```
+  ///
+  /// - Parameter expected: The expected current value of the high word.
+  /// - Parameter desired: The desired new value of the high word.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: A tuple `(exchanged, original)`, where `exchanged` is true if
+  ///   the exchange was successful, and `original` is the original value.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func compareExchangeHigh(
+    expected: UInt,
+    desired: UInt,
+    ordering: AtomicUpdateOrdering
+  ) -> (exchanged: Bool, original: DoubleWord) {
+    Value.AtomicRepresentation.atomicCompareExchangeHigh(
+      expected: expected,
+      desired: desired,
+      at: _ptr,
+      ordering: ordering)
+  }
+
+  /// Perform an atomic wrapping increment operation on the high
+  /// word of the current value, leaving the other word intact, and return the
+  /// original value, applying the specified memory ordering.
+  ///
+  /// Note: This operation silently wraps around on overflow, like the
+  /// `&+=` operator does on `UInt` values. It never carries over into the
+  /// other word.
+  ///
+  /// - Parameter operand: The value to add to the high word.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  @discardableResult
+  public func loadThenWrappingIncrementHigh(
+    by operand: UInt = 1,
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+    Value.AtomicRepresentation.atomicLoadThenWrappingIncrementHigh(
+      by: operand,
+      at: _ptr,
+      ordering: ordering)
+  }
+  /// Perform an atomic compare and exchange operation on the low
+  /// word of the current value, leaving the other word intact, and applying
+  /// the specified memory ordering.
+  ///
+  /// This operation performs the following algorithm as a single atomic
+  /// transaction:
+  ///
+  /// ```
+  /// atomic(self) { currentValue in
+  ///   let original = currentValue
+  ///   guard original.low == expected else { return (false, original) }
+  ///   currentValue.low = desired
+  ///   return (true, original)
+  /// }
+  /// ```
+  ///
+  /// - Parameter expected: The expected current value of the low word.
+  /// - Parameter desired: The desired new value of the low word.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: A tuple `(exchanged, original)`, where `exchanged` is true if
+  ///   the exchange was successful, and `original` is the original value.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func compareExchangeLow(
+    expected: UInt,
+    desired: UInt,
+    ordering: AtomicUpdateOrdering
+  ) -> (exchanged: Bool, original: DoubleWord) {
+    Value.AtomicRepresentation.atomicCompareExchangeLow(
+      expected: expected,
+      desired: desired,
+      at: _ptr,
+      ordering: ordering)
+  }
+
+  /// Perform an atomic wrapping increment operation on the low
+  /// word of the current value, leaving the other word intact, and return the
+  /// original value, applying the specified memory ordering.
+  ///
+  /// Note: This operation silently wraps around on overflow, like the
+  /// `&+=` operator does on `UInt` values. It never carries over into the
+  /// other word.
+  ///
+  /// - Parameter operand: The value to add to the low word.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  @discardableResult
+  public func loadThenWrappingIncrementLow(
+    by operand: UInt = 1,
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+    Value.AtomicRepresentation.atomicLoadThenWrappingIncrementLow(
+      by: operand,
+      at: _ptr,
+      ordering: ordering)
+  }
+}
+
+extension UnsafeAtomic where Value == DoubleWord {
+  /// Perform an atomic wrapping add operation on the current value, treating it
+  /// as a single unsigned integer, and return the original value, applying
+  /// the specified memory ordering.
+  ///
+  /// Note: This operation silently wraps around on overflow, like the
+  /// `&+` operator does on `DoubleWord` values. It carries across the
+  /// two words.
+  ///
+  /// - Parameter operand: A double word value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func loadThenWrappingIncrement(
+    by operand: DoubleWord = DoubleWord(high: 0, low: 1),
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+    Value.AtomicRepresentation.atomicLoadThenWrappingIncrement(
+      by: operand,
+      at: _ptr,
+      ordering: ordering)
+  }
+  /// Perform an atomic wrapping subtract operation on the current value, treating it
+  /// as a single unsigned integer, and return the original value, applying
+  /// the specified memory ordering.
+  ///
+  /// Note: This operation silently wraps around on overflow, like the
+  /// `&-` operator does on `DoubleWord` values. It carries across the
+  /// two words.
+  ///
+  /// - Parameter operand: A double word value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func loadThenWrappingDecrement(
+    by operand: DoubleWord = DoubleWord(high: 0, low: 1),
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+    Value.AtomicRepresentation.atomicLoadThenWrappingDecrement(
+      by: operand,
+      at: _ptr,
+      ordering: ordering)
+  }
+  /// Perform an atomic bitwise AND operation on the current value, treating it
+  /// as a single unsigned integer, and return the original value, applying
+  /// the specified memory ordering.
+  ///
+  /// - Parameter operand: A double word value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func loadThenBitwiseAnd(
+    with operand: DoubleWord,
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+    Value.AtomicRepresentation.atomicLoadThenBitwiseAnd(
+      with: operand,
+      at: _ptr,
+      ordering: ordering)
+  }
+  /// Perform an atomic bitwise OR operation on the current value, treating it
+  /// as a single unsigned integer, and return the original value, applying
+  /// the specified memory ordering.
+  ///
+  /// - Parameter operand: A double word value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func loadThenBitwiseOr(
+    with operand: DoubleWord,
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+    Value.AtomicRepresentation.atomicLoadThenBitwiseOr(
+      with: operand,
+      at: _ptr,
+      ordering: ordering)
+  }
+  /// Perform an atomic bitwise XOR operation on the current value, treating it
+  /// as a single unsigned integer, and return the original value, applying
+  /// the specified memory ordering.
+  ///
+  /// - Parameter operand: A double word value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func loadThenBitwiseXor(
+    with operand: DoubleWord,
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+    Value.AtomicRepresentation.atomicLoadThenBitwiseXor(
+      with: operand,
+      at: _ptr,
+      ordering: ordering)
+  }
+
+  /// Perform an atomic wrapping add operation on the current value, treating it
+  /// as a single unsigned integer, and return the new value, applying the
+  /// specified memory ordering.
+  ///
+  /// Note: This operation silently wraps around on overflow, like the
+  /// `&+` operator does on `DoubleWord` values. It carries across the
+  /// two words.
+  ///
+  /// - Parameter operand: A double word value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The new value after the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func wrappingIncrementThenLoad(
+    by operand: DoubleWord = DoubleWord(high: 0, low: 1),
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+    let original = Value.AtomicRepresentation.atomicLoadThenWrappingIncrement(
+      by: operand,
+      at: _ptr,
+      ordering: ordering)
+    return original &+ operand
+  }
+  /// Perform an atomic wrapping subtract operation on the current value, treating it
+  /// as a single unsigned integer, and return the new value, applying the
+  /// specified memory ordering.
+  ///
+  /// Note: This operation silently wraps around on overflow, like the
+  /// `&-` operator does on `DoubleWord` values. It carries across the
+  /// two words.
+  ///
+  /// - Parameter operand: A double word value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The new value after the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func wrappingDecrementThenLoad(
+    by operand: DoubleWord = DoubleWord(high: 0, low: 1),
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+    let original = Value.AtomicRepresentation.atomicLoadThenWrappingDecrement(
+      by: operand,
+      at: _ptr,
+      ordering: ordering)
+    return original &- operand
+  }
+  /// Perform an atomic bitwise AND operation on the current value, treating it
+  /// as a single unsigned integer, and return the new value, applying the
+  /// specified memory ordering.
+  ///
+  /// - Parameter operand: A double word value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The new value after the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func bitwiseAndThenLoad(
+    with operand: DoubleWord,
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+    let original = Value.AtomicRepresentation.atomicLoadThenBitwiseAnd(
+      with: operand,
+      at: _ptr,
+      ordering: ordering)
+    return original & operand
+  }
+  /// Perform an atomic bitwise OR operation on the current value, treating it
+  /// as a single unsigned integer, and return the new value, applying the
+  /// specified memory ordering.
+  ///
+  /// - Parameter operand: A double word value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The new value after the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func bitwiseOrThenLoad(
+    with operand: DoubleWord,
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+    let original = Value.AtomicRepresentation.atomicLoadThenBitwiseOr(
+      with: operand,
+      at: _ptr,
+      ordering: ordering)
+    return original | operand
+  }
+  /// Perform an atomic bitwise XOR operation on the current value, treating it
+  /// as a single unsigned integer, and return the new value, applying the
+  /// specified memory ordering.
+  ///
+  /// - Parameter operand: A double word value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The new value after the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func bitwiseXorThenLoad(
+    with operand: DoubleWord,
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+    let original = Value.AtomicRepresentation.atomicLoadThenBitwiseXor(
+      with: operand,
+      at: _ptr,
+      ordering: ordering)
+    return original ^ operand
+  }
+
+  /// Perform an atomic wrapping add operation on the current value, treating it
+  /// as a single unsigned integer, applying the specified memory ordering.
+  ///
+  /// Note: This operation silently wraps around on overflow, like the
+  /// `&+` operator does on `DoubleWord` values. It carries across the
+  /// two words.
+  ///
+  /// - Parameter operand: A double word value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func wrappingIncrement(
+    by operand: DoubleWord = DoubleWord(high: 0, low: 1),
+    ordering: AtomicUpdateOrdering
+  ) {
+    _ = Value.AtomicRepresentation.atomicLoadThenWrappingIncrement(
+      by: operand,
+      at: _ptr,
+      ordering: ordering)
+  }
+  /// Perform an atomic wrapping subtract operation on the current value, treating it
+  /// as a single unsigned integer, applying the specified memory ordering.
+  ///
+  /// Note: This operation silently wraps around on overflow, like the
+  /// `&-` operator does on `DoubleWord` values. It carries across the
+  /// two words.
+  ///
+  /// - Parameter operand: A double word value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func wrappingDecrement(
+    by operand: DoubleWord = DoubleWord(high: 0, low: 1),
+    ordering: AtomicUpdateOrdering
+  ) {
+    _ = Value.AtomicRepresentation.atomicLoadThenWrappingDecrement(
+      by: operand,
+      at: _ptr,
+      ordering: ordering)
+  }
+}
+
+extension UnsafeAtomic
+where
+  Value: RawRepresentable,
+  Value.RawValue: AtomicValue,
+  Value.AtomicRepresentation == AtomicRawRepresentableStorage<Value>
+{
+  @_alwaysEmitIntoClient @inline(__always)
+  internal var _rawPtr: UnsafeMutablePointer<Value.RawValue.AtomicRepresentation> {
+    Value.AtomicRepresentation._extract(_ptr)
+  }
+}
+
+extension UnsafeAtomic where Value: AtomicPackedValue {
+  /// Atomically adds `operand` to the specified field of the current value,
+  /// leaving the other fields intact, and returns the original value,
+  /// applying the specified memory ordering.
+  ///
+  /// This is a single atomic integer addition on the packed raw value. The
+  /// field must not overflow: a carry out of the field would change the
+  /// fields above it. (This is checked in debug builds.)
+  ///
+  /// - Parameter field: A field of the packed value.
+  /// - Parameter operand: The value to add to the field.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  @discardableResult
+  public func loadThenIncrement(
+    _ field: AtomicBitField<Value>,
+    by operand: Value.RawValue = 1,
+    ordering: AtomicUpdateOrdering
+  ) -> Value {
+    let raw = Value.RawValue.AtomicRepresentation.atomicLoadThenWrappingIncrement(
+      by: operand &<< Value.RawValue(field.offset),
+      at: _rawPtr,
+      ordering: ordering)
+    assert(
+      field.maximum - field.extract(from: raw) >= operand,
+      "Packed field overflow")
+    return Value(rawValue: raw)!
+  }
+
+  /// Atomically subtracts `operand` from the specified field of the current
+  /// value, leaving the other fields intact, and returns the original value,
+  /// applying the specified memory ordering.
+  ///
+  /// This is a single atomic integer subtraction on the packed raw value.
+  /// The field must not underflow: a borrow out of the field would change
+  /// the fields above it. (This is checked in debug builds.)
+  ///
+  /// - Parameter field: A field of the packed value.
+  /// - Parameter operand: The value to subtract from the field.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  @discardableResult
+  public func loadThenDecrement(
+    _ field: AtomicBitField<Value>,
+    by operand: Value.RawValue = 1,
+    ordering: AtomicUpdateOrdering
+  ) -> Value {
+    let raw = Value.RawValue.AtomicRepresentation.atomicLoadThenWrappingDecrement(
+      by: operand &<< Value.RawValue(field.offset),
+      at: _rawPtr,
+      ordering: ordering)
+    assert(field.extract(from: raw) >= operand, "Packed field underflow")
+    return Value(rawValue: raw)!
+  }
+
+  /// Perform an atomic compare and exchange operation on the specified field
+  /// of the current value, leaving the other fields intact, and applying the
+  /// specified memory ordering.
+  ///
+  /// This operation performs the following algorithm as a single atomic
+  /// transaction:
+  ///
+  /// ```
+  /// atomic(self) { currentValue in
+  ///   let original = currentValue
+  ///   guard original[field] == expected else { return (false, original) }
+  ///   currentValue[field] = desired
+  ///   return (true, original)
+  /// }
+  /// ```
+  ///
+  /// Changes to other fields don't make the exchange fail; to update the
+  /// field only if the other fields also have particular values, use a
+  /// regular compare and exchange operation instead.
+  ///
+  /// - Parameter field: A field of the packed value.
+  /// - Parameter expected: The expected current value of the field.
+  /// - Parameter desired: The desired new value of the field.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: A tuple `(exchanged, original)`, where `exchanged` is true if
+  ///   the exchange was successful, and `original` is the original value.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func compareExchange(
+    _ field: AtomicBitField<Value>,
+    expected: Value.RawValue,
+    desired: Value.RawValue,
+    ordering: AtomicUpdateOrdering
+  ) -> (exchanged: Bool, original: Value) {
+    Value.AtomicRepresentation._atomicCompareExchange(
+      at: _ptr,
+      ordering: ordering,
+      while: { field.extract(from: $0) == expected },
+      desired: { field.inserting(desired, into: $0) })
+  }
+}
+
+extension UnsafeAtomic where Value: AtomicStateMachine {
+  /// Atomically changes the current state from `expected` to `desired`, if
+  /// the current state is `expected`, applying the specified memory
+  /// ordering.
+  ///
+  /// This is a single compare-exchange of the states' raw values. The
+  /// transition must be allowed by `Value.transitions`; requesting one that
+  /// isn't is a programming error, and traps without accessing the state.
+  ///
+  /// - Parameter expected: The expected current state.
+  /// - Parameter desired: The desired new state.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: A tuple `(exchanged, original)`, where `exchanged` is true if
+  ///   the transition happened, and `original` is the original state.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func transition(
+    from expected: Value,
+    to desired: Value,
+    ordering: AtomicUpdateOrdering
+  ) -> (exchanged: Bool, original: Value) {
+    precondition(
+      Value.transitions.allows(from: expected, to: desired),
+      "Invalid state transition")
+    let (exchanged, original) =
+      Value.RawValue.AtomicRepresentation.atomicCompareExchange(
+        expected: expected.rawValue,
+        desired: desired.rawValue,
+        at: _rawPtr,
+        ordering: ordering)
+    return (exchanged, exchanged ? expected : Value(rawValue: original)!)
+  }
+
+  /// Atomically changes the current state to `desired`, if
+  /// `Value.transitions` allows that from the current state, applying the
+  /// specified memory ordering.
+  ///
+  /// If the state changes concurrently, this tries again from the new state,
+  /// as long as the transition is still allowed. If it isn't, this returns
+  /// without writing to the state.
+  ///
+  /// - Parameter desired: The desired new state.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: A tuple `(exchanged, original)`, where `exchanged` is true if
+  ///   the transition happened, and `original` is the original state.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func transition(
+    to desired: Value,
+    ordering: AtomicUpdateOrdering
+  ) -> (exchanged: Bool, original: Value) {
+    let table = Value.transitions
+    let target = desired.rawValue
+    return Value.AtomicRepresentation._atomicCompareExchange(
+      at: _ptr,
+      ordering: ordering,
+      while: { table._allows(from: $0, to: target) },
+      desired: { _ in target })
+  }
+}
 extension ManagedAtomic {
   /// Atomically loads and returns the current value, applying the specified
   /// memory ordering.
   ///
   /// - Parameter ordering: The memory ordering to apply on this operation.
-  /// - Returns: The current value.
+  /// - Returns: The current value.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func load(
+    ordering: AtomicLoadOrdering
+  ) -> Value {
+    Value.AtomicRepresentation.atomicLoad(at: _ptr, ordering: ordering)
+  }
+
+  /// Atomically sets the current value to `desired`, applying the specified
+  /// memory ordering.
+  ///
+  /// - Parameter desired: The desired new value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func store(
+    _ desired: __owned Value,
+    ordering: AtomicStoreOrdering
+  ) {
+    Value.AtomicRepresentation.atomicStore(desired, at: _ptr, ordering: ordering)
+  }
+
+  /// Atomically sets the current value to `desired` and returns the original
+  /// value, applying the specified memory ordering.
+  ///
+  /// - Parameter desired: The desired new value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func exchange(
+    _ desired: __owned Value,
+    ordering: AtomicUpdateOrdering
+  ) -> Value {
+    Value.AtomicRepresentation.atomicExchange(desired, at: _ptr, ordering: ordering)
+  }
+
+  /// Perform an atomic compare and exchange operation on the current value,
+  /// applying the specified memory ordering.
+  ///
+  /// This operation performs the following algorithm as a single atomic
+  /// transaction:
+  ///
+  /// ```
+  /// atomic(self) { currentValue in
+  ///   let original = currentValue
+  ///   guard original == expected else { return (false, original) }
+  ///   currentValue = desired
+  ///   return (true, original)
+  /// }
+  /// ```
+  ///
+  /// This method implements a "strong" compare and exchange operation
+  /// that does not permit spurious failures.
+  ///
+  /// - Parameter expected: The expected current value.
+  /// - Parameter desired: The desired new value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: A tuple `(exchanged, original)`, where `exchanged` is true if
+  ///   the exchange was successful, and `original` is the original value.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func compareExchange(
+    expected: Value,
+    desired: __owned Value,
+    ordering: AtomicUpdateOrdering
+  ) -> (exchanged: Bool, original: Value) {
+    Value.AtomicRepresentation.atomicCompareExchange(
+      expected: expected,
+      desired: desired,
+      at: _ptr,
+      ordering: ordering)
+  }
+
+  /// Perform an atomic compare and exchange operation on the current value,
+  /// applying the specified success/failure memory orderings.
+  ///
+  /// This operation performs the following algorithm as a single atomic
+  /// transaction:
+  ///
+  /// ```
+  /// atomic(self) { currentValue in
+  ///   let original = currentValue
+  ///   guard original == expected else { return (false, original) }
+  ///   currentValue = desired
+  ///   return (true, original)
+  /// }
+  /// ```
+  ///
+  /// The `successOrdering` argument specifies the memory ordering to use when
+  /// the operation manages to update the current value, while `failureOrdering`
+  /// will be used when the operation leaves the value intact.
+  ///
+  /// This method implements a "strong" compare and exchange operation
+  /// that does not permit spurious failures.
+  ///
+  /// - Parameter expected: The expected current value.
+  /// - Parameter desired: The desired new value.
+  /// - Parameter successOrdering: The memory ordering to apply if this
+  ///    operation performs the exchange.
+  /// - Parameter failureOrdering: The memory ordering to apply on this
+  ///    operation does not perform the exchange.
+  /// - Returns: A tuple `(exchanged, original)`, where `exchanged` is true if
+  ///   the exchange was successful, and `original` is the original value.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func compareExchange(
+    expected: Value,
+    desired: __owned Value,
+    successOrdering: AtomicUpdateOrdering,
+    failureOrdering: AtomicLoadOrdering
+  ) -> (exchanged: Bool, original: Value) {
+    Value.AtomicRepresentation.atomicCompareExchange(
+      expected: expected,
+      desired: desired,
+      at: _ptr,
+      successOrdering: successOrdering,
+      failureOrdering: failureOrdering)
+  }
+
+  /// Perform an atomic weak compare and exchange operation on the current
+  /// value, applying the specified success/failure memory orderings. This
+  /// compare-exchange variant is allowed to spuriously fail; it is designed to
+  /// be called in a loop until it indicates a successful exchange has happened.
+  ///
+  /// This operation performs the following algorithm as a single atomic
+  /// transaction:
+  ///
+  /// ```
+  /// atomic(self) { currentValue in
+  ///   let original = currentValue
+  ///   guard original == expected else { return (false, original) }
+  ///   currentValue = desired
+  ///   return (true, original)
+  /// }
+  /// ```
+  ///
+  /// (In this weak form, transient conditions may cause the `original ==
+  /// expected` check to sometimes return false when the two values are in fact
+  /// the same.)
+  ///
+  /// The `ordering` argument specifies the memory ordering to use when the
+  /// operation manages to update the current value, while `failureOrdering`
+  /// will be used when the operation leaves the value intact.
+  ///
+  /// - Parameter expected: The expected current value.
+  /// - Parameter desired: The desired new value.
+  /// - Parameter successOrdering: The memory ordering to apply if this
+  ///    operation performs the exchange.
+  /// - Parameter failureOrdering: The memory ordering to apply on this
+  ///    operation does not perform the exchange.
+  /// - Returns: A tuple `(exchanged, original)`, where `exchanged` is true if
+  ///   the exchange was successful, and `original` is the original value.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func weakCompareExchange(
+    expected: Value,
+    desired: __owned Value,
+    successOrdering: AtomicUpdateOrdering,
+    failureOrdering: AtomicLoadOrdering
+  ) -> (exchanged: Bool, original: Value) {
+    Value.AtomicRepresentation.atomicWeakCompareExchange(
+      expected: expected,
+      desired: desired,
+      at: _ptr,
+      successOrdering: successOrdering,
+      failureOrdering: failureOrdering)
+  }
+}
+
+extension ManagedAtomic where Value: AtomicInteger {
+  /// Perform an atomic wrapping add operation and return the original value, applying
+  /// the specified memory ordering.
+  ///
+  /// Note: This operation silently wraps around on overflow, like the
+  /// `&+` operator does on `Int` values.
+  ///
+  /// - Parameter operand: An integer value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
   @_semantics("atomics.requires_constant_orderings")
   @_transparent @_alwaysEmitIntoClient
-  public func load(
-    ordering: AtomicLoadOrdering
+  public func loadThenWrappingIncrement(
+    by operand: Value = 1,
+    ordering: AtomicUpdateOrdering
   ) -> Value {
-    Value.AtomicRepresentation.atomicLoad(at: _ptr, ordering: ordering)
+    Value.AtomicRepresentation.atomicLoadThenWrappingIncrement(
+      by: operand,
+      at: _ptr,
+      ordering: ordering)
+  }
+  /// Perform an atomic wrapping subtract operation and return the original value, applying
+  /// the specified memory ordering.
+  ///
+  /// Note: This operation silently wraps around on overflow, like the
+  /// `&-` operator does on `Int` values.
+  ///
+  /// - Parameter operand: An integer value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func loadThenWrappingDecrement(
+    by operand: Value = 1,
+    ordering: AtomicUpdateOrdering
+  ) -> Value {
+    Value.AtomicRepresentation.atomicLoadThenWrappingDecrement(
+      by: operand,
+      at: _ptr,
+      ordering: ordering)
+  }
+  /// Perform an atomic bitwise AND operation and return the original value, applying
+  /// the specified memory ordering.
+  ///
+  /// - Parameter operand: An integer value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func loadThenBitwiseAnd(
+    with operand: Value,
+    ordering: AtomicUpdateOrdering
+  ) -> Value {
+    Value.AtomicRepresentation.atomicLoadThenBitwiseAnd(
+      with: operand,
+      at: _ptr,
+      ordering: ordering)
+  }
+  /// Perform an atomic bitwise OR operation and return the original value, applying
+  /// the specified memory ordering.
+  ///
+  /// - Parameter operand: An integer value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func loadThenBitwiseOr(
+    with operand: Value,
+    ordering: AtomicUpdateOrdering
+  ) -> Value {
+    Value.AtomicRepresentation.atomicLoadThenBitwiseOr(
+      with: operand,
+      at: _ptr,
+      ordering: ordering)
+  }
+  /// Perform an atomic bitwise XOR operation and return the original value, applying
+  /// the specified memory ordering.
+  ///
+  /// - Parameter operand: An integer value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func loadThenBitwiseXor(
+    with operand: Value,
+    ordering: AtomicUpdateOrdering
+  ) -> Value {
+    Value.AtomicRepresentation.atomicLoadThenBitwiseXor(
+      with: operand,
+      at: _ptr,
+      ordering: ordering)
   }
 
-  /// Atomically sets the current value to `desired`, applying the specified
-  /// memory ordering.
+  /// Perform an atomic wrapping add operation and return the new value, applying
+  /// the specified memory ordering.
   ///
-  /// - Parameter desired: The desired new value.
+  /// Note: This operation silently wraps around on overflow, like the
+  /// `&+` operator does on `Int` values.
+  ///
+  /// - Parameter operand: An integer value.
   /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The new value after the operation.
   @_semantics("atomics.requires_constant_orderings")
   @_transparent @_alwaysEmitIntoClient
-  public func store(
-    _ desired: __owned Value,
-    ordering: AtomicStoreOrdering
+  public func wrappingIncrementThenLoad(
+    by operand: Value = 1,
+    ordering: AtomicUpdateOrdering
+  ) -> Value {
+    let original = Value.AtomicRepresentation.atomicLoadThenWrappingIncrement(
+      by: operand,
+      at: _ptr,
+      ordering: ordering)
+    return original &+ operand
+  }
+  /// Perform an atomic wrapping subtract operation and return the new value, applying
+  /// the specified memory ordering.
+  ///
+  /// Note: This operation silently wraps around on overflow, like the
+  /// `&-` operator does on `Int` values.
+  ///
+  /// - Parameter operand: An integer value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The new value after the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func wrappingDecrementThenLoad(
+    by operand: Value = 1,
+    ordering: AtomicUpdateOrdering
+  ) -> Value {
+    let original = Value.AtomicRepresentation.atomicLoadThenWrappingDecrement(
+      by: operand,
+      at: _ptr,
+      ordering: ordering)
+    return original &- operand
+  }
+  /// Perform an atomic bitwise AND operation and return the new value, applying
+  /// the specified memory ordering.
+  ///
+  /// - Parameter operand: An integer value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The new value after the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func bitwiseAndThenLoad(
+    with operand: Value,
+    ordering: AtomicUpdateOrdering
+  ) -> Value {
+    let original = Value.AtomicRepresentation.atomicLoadThenBitwiseAnd(
+      with: operand,
+      at: _ptr,
+      ordering: ordering)
+    return original & operand
+  }
+  /// Perform an atomic bitwise OR operation and return the new value, applying
+  /// the specified memory ordering.
+  ///
+  /// - Parameter operand: An integer value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The new value after the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func bitwiseOrThenLoad(
+    with operand: Value,
+    ordering: AtomicUpdateOrdering
+  ) -> Value {
+    let original = Value.AtomicRepresentation.atomicLoadThenBitwiseOr(
+      with: operand,
+      at: _ptr,
+      ordering: ordering)
+    return original | operand
+  }
+  /// Perform an atomic bitwise XOR operation and return the new value, applying
+  /// the specified memory ordering.
+  ///
+  /// - Parameter operand: An integer value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The new value after the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func bitwiseXorThenLoad(
+    with operand: Value,
+    ordering: AtomicUpdateOrdering
+  ) -> Value {
+    let original = Value.AtomicRepresentation.atomicLoadThenBitwiseXor(
+      with: operand,
+      at: _ptr,
+      ordering: ordering)
+    return original ^ operand
+  }
+
+  /// Perform an atomic wrapping increment operation applying the
+  /// specified memory ordering.
+  ///
+  /// Note: This operation silently wraps around on overflow, like the
+  /// `&+=` operator does on `Int` values.
+  ///
+  /// - Parameter operand: The value to add to the current value.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func wrappingIncrement(
+    by operand: Value = 1,
+    ordering: AtomicUpdateOrdering
   ) {
-    Value.AtomicRepresentation.atomicStore(desired, at: _ptr, ordering: ordering)
+    _ = Value.AtomicRepresentation.atomicLoadThenWrappingIncrement(
+      by: operand,
+      at: _ptr,
+      ordering: ordering)
   }
 
-  /// Atomically sets the current value to `desired` and returns the original
-  /// value, applying the specified memory ordering.
+  /// Perform an atomic wrapping decrement operation applying the
+  /// specified memory ordering.
   ///
-  /// - Parameter desired: The desired new value.
+  /// Note: This operation silently wraps around on overflow, like the
+  /// `&-=` operator does on `Int` values.
+  ///
+  /// - Parameter operand: The value to subtract from the current value.
   /// - Parameter ordering: The memory ordering to apply on this operation.
-  /// - Returns: The original value.
   @_semantics("atomics.requires_constant_orderings")
   @_transparent @_alwaysEmitIntoClient
-  public func exchange(
-    _ desired: __owned Value,
+  public func wrappingDecrement(
+    by operand: Value = 1,
     ordering: AtomicUpdateOrdering
-  ) -> Value {
-    Value.AtomicRepresentation.atomicExchange(desired, at: _ptr, ordering: ordering)
+  ) {
+    _ = Value.AtomicRepresentation.atomicLoadThenWrappingDecrement(
+      by: operand,
+      at: _ptr,
+      ordering: ordering)
   }
+}
 
-  /// Perform an atomic compare and exchange operation on the current value,
-  /// applying the specified memory ordering.
+extension ManagedAtomic where Value == DoubleWord {
+  /// Perform an atomic compare and exchange operation on the high
+  /// word of the current value, leaving the other word intact, and applying
+  /// the specified memory ordering.
   ///
   /// This operation performs the following algorithm as a single atomic
   /// transaction:
@@ -555,36 +1460,57 @@ extension ManagedAtomic {
   /// ```
   /// atomic(self) { currentValue in
   ///   let original = currentValue
-  ///   guard original == expected else { return (false, original) }
-  ///   currentValue = desired
+  ///   guard original.high == expected else { return (false, original) }
+  ///   currentValue.high = desired
   ///   return (true, original)
   /// }
   /// ```
   ///
-  /// This method implements a "strong" compare and exchange operation
-  /// that does not permit spurious failures.
-  ///
-  /// - Parameter expected: The expected current value.
-  /// - Parameter desired: The desired new value.
+  /// - Parameter expected: The expected current value of the high word.
+  /// - Parameter desired: The desired new value of the high word.
   /// - Parameter ordering: The memory ordering to apply on this operation.
   /// - Returns: A tuple `(exchanged, original)`, where `exchanged` is true if
   ///   the exchange was successful, and `original` is the original value.
   @_semantics("atomics.requires_constant_orderings")
   @_transparent @_alwaysEmitIntoClient
-  public func compareExchange(
-    expected: Value,
-    desired: __owned Value,
+  public func compareExchangeHigh(
+    expected: UInt,
+    desired: UInt,
     ordering: AtomicUpdateOrdering
-  ) -> (exchanged: Bool, original: Value) {
-    Value.AtomicRepresentation.atomicCompareExchange(
+  ) -> (exchanged: Bool, original: DoubleWord) {
+    Value.AtomicRepresentation.atomicCompareExchangeHigh(
       expected: expected,
       desired: desired,
       at: _ptr,
       ordering: ordering)
   }
 
-  /// Perform an atomic compare and exchange operation on the current value,
-  /// applying the specified success/failure memory orderings.
+  /// Perform an atomic wrapping increment operation on the high
+  /// word of the current value, leaving the other word intact, and return the
+  /// original value, applying the specified memory ordering.
+  ///
+  /// Note: This operation silently wraps around on overflow, like the
+  /// `&+=` operator does on `UInt` values. It never carries over into the
+  /// other word.
+  ///
+  /// - Parameter operand: The value to add to the high word.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  @discardableResult
+  public func loadThenWrappingIncrementHigh(
+    by operand: UInt = 1,
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+    Value.AtomicRepresentation.atomicLoadThenWrappingIncrementHigh(
+      by: operand,
+      at: _ptr,
+      ordering: ordering)
+  }
+  /// Perform an atomic compare and exchange operation on the low
+  /// word of the current value, leaving the other word intact, and applying
+  /// the specified memory ordering.
   ///
   /// This operation performs the following algorithm as a single atomic
   /// transaction:
@@ -592,276 +1518,253 @@ extension ManagedAtomic {
   /// ```
   /// atomic(self) { currentValue in
   ///   let original = currentValue
-  ///   guard original == expected else { return (false, original) }
-  ///   currentValue = desired
+  ///   guard original.low == expected else { return (false, original) }
+  ///   currentValue.low = desired
   ///   return (true, original)
   /// }
   /// ```
   ///
-  /// The `successOrdering` argument specifies the memory ordering to use when
-  /// the operation manages to update the current value, while `failureOrdering`
-  /// will be used when the operation leaves the value intact.
-  ///
-  /// This method implements a "strong" compare and exchange operation
-  /// that does not permit spurious failures.
-  ///
-  /// - Parameter expected: The expected current value.
-  /// - Parameter desired: The desired new value.
-  /// - Parameter successOrdering: The memory ordering to apply if this
-  ///    operation performs the exchange.
-  /// - Parameter failureOrdering: The memory ordering to apply on this
-  ///    operation does not perform the exchange.
+  /// - Parameter expected: The expected current value of the low word.
+  /// - Parameter desired: The desired new value of the low word.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
   /// - Returns: A tuple `(exchanged, original)`, where `exchanged` is true if
   ///   the exchange was successful, and `original` is the original value.
   @_semantics("atomics.requires_constant_orderings")
   @_transparent @_alwaysEmitIntoClient
-  public func compareExchange(
-    expected: Value,
-    desired: __owned Value,
-    successOrdering: AtomicUpdateOrdering,
-    failureOrdering: AtomicLoadOrdering
-  ) -> (exchanged: Bool, original: Value) {
-    Value.AtomicRepresentation.atomicCompareExchange(
+  public func compareExchangeLow(
+    expected: UInt,
+    desired: UInt,
+    ordering: AtomicUpdateOrdering
+  ) -> (exchanged: Bool, original: DoubleWord) {
+    Value.AtomicRepresentation.atomicCompareExchangeLow(
       expected: expected,
       desired: desired,
       at: _ptr,
-      successOrdering: successOrdering,
-      failureOrdering: failureOrdering)
+      ordering: ordering)
   }
 
-  /// Perform an atomic weak compare and exchange operation on the current
-  /// value, applying the specified success/failure memory orderings. This
-  /// compare-exchange variant is allowed to spuriously fail; it is designed to
-  /// be called in a loop until it indicates a successful exchange has happened.
-  ///
-  /// This operation performs the following algorithm as a single atomic
-  /// transaction:
-  ///
-  /// ```
-  /// atomic(self) { currentValue in
-  ///   let original = currentValue
-  ///   guard original == expected else { return (false, original) }
-  ///   currentValue = desired
-  ///   return (true, original)
-  /// }
-  /// ```
-  ///
-  /// (In this weak form, transient conditions may cause the `original ==
-  /// expected` check to sometimes return false when the two values are in fact
-  /// the same.)
+  /// Perform an atomic wrapping increment operation on the low
+  /// word of the current value, leaving the other word intact, and return the
+  /// original value, applying the specified memory ordering.
   ///
-  /// The `ordering` argument specifies the memory ordering to use when the
-  /// operation manages to update the current value, while `failureOrdering`
-  /// will be used when the operation leaves the value intact.
+  /// Note: This operation silently wraps around on overflow, like the
+  /// `&+=` operator does on `UInt` values. It never carries over into the
+  /// other word.
   ///
-  /// - Parameter expected: The expected current value.
-  /// - Parameter desired: The desired new value.
-  /// - Parameter successOrdering: The memory ordering to apply if this
-  ///    operation performs the exchange.
-  /// - Parameter failureOrdering: The memory ordering to apply on this
-  ///    operation does not perform the exchange.
-  /// - Returns: A tuple `(exchanged, original)`, where `exchanged` is true if
-  ///   the exchange was successful, and `original` is the original value.
+  /// - Parameter operand: The value to add to the low word.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
   @_semantics("atomics.requires_constant_orderings")
   @_transparent @_alwaysEmitIntoClient
-  public func weakCompareExchange(
-    expected: Value,
-    desired: __owned Value,
-    successOrdering: AtomicUpdateOrdering,
-    failureOrdering: AtomicLoadOrdering
-  ) -> (exchanged: Bool, original: Value) {
-    Value.AtomicRepresentation.atomicWeakCompareExchange(
-      expected: expected,
-      desired: desired,
+  @discardableResult
+  public func loadThenWrappingIncrementLow(
+    by operand: UInt = 1,
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+    Value.AtomicRepresentation.atomicLoadThenWrappingIncrementLow(
+      by: operand,
       at: _ptr,
-      successOrdering: successOrdering,
-      failureOrdering: failureOrdering)
+      ordering: ordering)
   }
 }
 
-extension ManagedAtomic where Value: AtomicInteger {
-  /// Perform an atomic wrapping add operation and return the original value, applying
+extension ManagedAtomic where Value == DoubleWord {
+  /// Perform an atomic wrapping add operation on the current value, treating it
+  /// as a single unsigned integer, and return the original value, applying
   /// the specified memory ordering.
   ///
   /// Note: This operation silently wraps around on overflow, like the
-  /// `&+` operator does on `Int` values.
+  /// `&+` operator does on `DoubleWord` values. It carries across the
+  /// two words.
   ///
-  /// - Parameter operand: An integer value.
+  /// - Parameter operand: A double word value.
   /// - Parameter ordering: The memory ordering to apply on this operation.
   /// - Returns: The original value before the operation.
   @_semantics("atomics.requires_constant_orderings")
   @_transparent @_alwaysEmitIntoClient
   public func loadThenWrappingIncrement(
-    by operand: Value = 1,
+    by operand: DoubleWord = DoubleWord(high: 0, low: 1),
     ordering: AtomicUpdateOrdering
-  ) -> Value {
+  ) -> DoubleWord {
     Value.AtomicRepresentation.atomicLoadThenWrappingIncrement(
       by: operand,
       at: _ptr,
       ordering: ordering)
   }
-  /// Perform an atomic wrapping subtract operation and return the original value, applying
+  /// Perform an atomic wrapping subtract operation on the current value, treating it
+  /// as a single unsigned integer, and return the original value, applying
   /// the specified memory ordering.
   ///
   /// Note: This operation silently wraps around on overflow, like the
-  /// `&-` operator does on `Int` values.
+  /// `&-` operator does on `DoubleWord` values. It carries across the
+  /// two words.
   ///
-  /// - Parameter operand: An integer value.
+  /// - Parameter operand: A double word value.
   /// - Parameter ordering: The memory ordering to apply on this operation.
   /// - Returns: The original value before the operation.
   @_semantics("atomics.requires_constant_orderings")
   @_transparent @_alwaysEmitIntoClient
   public func loadThenWrappingDecrement(
-    by operand: Value = 1,
+    by operand: DoubleWord = DoubleWord(high: 0, low: 1),
     ordering: AtomicUpdateOrdering
-  ) -> Value {
+  ) -> DoubleWord {
     Value.AtomicRepresentation.atomicLoadThenWrappingDecrement(
       by: operand,
       at: _ptr,
       ordering: ordering)
   }
-  /// Perform an atomic bitwise AND operation and return the original value, applying
+  /// Perform an atomic bitwise AND operation on the current value, treating it
+  /// as a single unsigned integer, and return the original value, applying
   /// the specified memory ordering.
   ///
-  /// - Parameter operand: An integer value.
+  /// - Parameter operand: A double word value.
   /// - Parameter ordering: The memory ordering to apply on this operation.
   /// - Returns: The original value before the operation.
   @_semantics("atomics.requires_constant_orderings")
   @_transparent @_alwaysEmitIntoClient
   public func loadThenBitwiseAnd(
-    with operand: Value,
+    with operand: DoubleWord,
     ordering: AtomicUpdateOrdering
-  ) -> Value {
+  ) -> DoubleWord {
     Value.AtomicRepresentation.atomicLoadThenBitwiseAnd(
       with: operand,
       at: _ptr,
       ordering: ordering)
   }
-  /// Perform an atomic bitwise OR operation and return the original value, applying
+  /// Perform an atomic bitwise OR operation on the current value, treating it
+  /// as a single unsigned integer, and return the original value, applying
   /// the specified memory ordering.
   ///
-  /// - Parameter operand: An integer value.
+  /// - Parameter operand: A double word value.
   /// - Parameter ordering: The memory ordering to apply on this operation.
   /// - Returns: The original value before the operation.
   @_semantics("atomics.requires_constant_orderings")
   @_transparent @_alwaysEmitIntoClient
   public func loadThenBitwiseOr(
-    with operand: Value,
+    with operand: DoubleWord,
     ordering: AtomicUpdateOrdering
-  ) -> Value {
+  ) -> DoubleWord {
     Value.AtomicRepresentation.atomicLoadThenBitwiseOr(
       with: operand,
       at: _ptr,
       ordering: ordering)
   }
-  /// Perform an atomic bitwise XOR operation and return the original value, applying
+  /// Perform an atomic bitwise XOR operation on the current value, treating it
+  /// as a single unsigned integer, and return the original value, applying
   /// the specified memory ordering.
   ///
-  /// - Parameter operand: An integer value.
+  /// - Parameter operand: A double word value.
   /// - Parameter ordering: The memory ordering to apply on this operation.
   /// - Returns: The original value before the operation.
   @_semantics("atomics.requires_constant_orderings")
   @_transparent @_alwaysEmitIntoClient
   public func loadThenBitwiseXor(
-    with operand: Value,
+    with operand: DoubleWord,
     ordering: AtomicUpdateOrdering
-  ) -> Value {
+  ) -> DoubleWord {
     Value.AtomicRepresentation.atomicLoadThenBitwiseXor(
       with: operand,
       at: _ptr,
       ordering: ordering)
   }
 
-  /// Perform an atomic wrapping add operation and return the new value, applying
-  /// the specified memory ordering.
+  /// Perform an atomic wrapping add operation on the current value, treating it
+  /// as a single unsigned integer, and return the new value, applying the
+  /// specified memory ordering.
   ///
   /// Note: This operation silently wraps around on overflow, like the
-  /// `&+` operator does on `Int` values.
+  /// `&+` operator does on `DoubleWord` values. It carries across the
+  /// two words.
   ///
-  /// - Parameter operand: An integer value.
+  /// - Parameter operand: A double word value.
   /// - Parameter ordering: The memory ordering to apply on this operation.
   /// - Returns: The new value after the operation.
   @_semantics("atomics.requires_constant_orderings")
   @_transparent @_alwaysEmitIntoClient
   public func wrappingIncrementThenLoad(
-    by operand: Value = 1,
+    by operand: DoubleWord = DoubleWord(high: 0, low: 1),
     ordering: AtomicUpdateOrdering
-  ) -> Value {
+  ) -> DoubleWord {
     let original = Value.AtomicRepresentation.atomicLoadThenWrappingIncrement(
       by: operand,
       at: _ptr,
       ordering: ordering)
     return original &+ operand
   }
-  /// Perform an atomic wrapping subtract operation and return the new value, applying
-  /// the specified memory ordering.
+  /// Perform an atomic wrapping subtract operation on the current value, treating it
+  /// as a single unsigned integer, and return the new value, applying the
+  /// specified memory ordering.
   ///
   /// Note: This operation silently wraps around on overflow, like the
-  /// `&-` operator does on `Int` values.
+  /// `&-` operator does on `DoubleWord` values. It carries across the
+  /// two words.
   ///
-  /// - Parameter operand: An integer value.
+  /// - Parameter operand: A double word value.
   /// - Parameter ordering: The memory ordering to apply on this operation.
   /// - Returns: The new value after the operation.
   @_semantics("atomics.requires_constant_orderings")
   @_transparent @_alwaysEmitIntoClient
   public func wrappingDecrementThenLoad(
-    by operand: Value = 1,
+    by operand: DoubleWord = DoubleWord(high: 0, low: 1),
     ordering: AtomicUpdateOrdering
-  ) -> Value {
+  ) -> DoubleWord {
     let original = Value.AtomicRepresentation.atomicLoadThenWrappingDecrement(
       by: operand,
       at: _ptr,
       ordering: ordering)
     return original &- operand
   }
-  /// Perform an atomic bitwise AND operation and return the new value, applying
-  /// the specified memory ordering.
+  /// Perform an atomic bitwise AND operation on the current value, treating it
+  /// as a single unsigned integer, and return the new value, applying the
+  /// specified memory ordering.
   ///
-  /// - Parameter operand: An integer value.
+  /// - Parameter operand: A double word value.
   /// - Parameter ordering: The memory ordering to apply on this operation.
   /// - Returns: The new value after the operation.
   @_semantics("atomics.requires_constant_orderings")
   @_transparent @_alwaysEmitIntoClient
   public func bitwiseAndThenLoad(
-    with operand: Value,
+    with operand: DoubleWord,
     ordering: AtomicUpdateOrdering
-  ) -> Value {
+  ) -> DoubleWord {
     let original = Value.AtomicRepresentation.atomicLoadThenBitwiseAnd(
       with: operand,
       at: _ptr,
       ordering: ordering)
     return original & operand
   }
-  /// Perform an atomic bitwise OR operation and return the new value, applying
-  /// the specified memory ordering.
+  /// Perform an atomic bitwise OR operation on the current value, treating it
+  /// as a single unsigned integer, and return the new value, applying the
+  /// specified memory ordering.
   ///
-  /// - Parameter operand: An integer value.
+  /// - Parameter operand: A double word value.
   /// - Parameter ordering: The memory ordering to apply on this operation.
   /// - Returns: The new value after the operation.
   @_semantics("atomics.requires_constant_orderings")
   @_transparent @_alwaysEmitIntoClient
   public func bitwiseOrThenLoad(
-    with operand: Value,
+    with operand: DoubleWord,
     ordering: AtomicUpdateOrdering
-  ) -> Value {
+  ) -> DoubleWord {
     let original = Value.AtomicRepresentation.atomicLoadThenBitwiseOr(
       with: operand,
       at: _ptr,
       ordering: ordering)
     return original | operand
   }
-  /// Perform an atomic bitwise XOR operation and return the new value, applying
-  /// the specified memory ordering.
+  /// Perform an atomic bitwise XOR operation on the current value, treating it
+  /// as a single unsigned integer, and return the new value, applying the
+  /// specified memory ordering.
   ///
-  /// - Parameter operand: An integer value.
+  /// - Parameter operand: A double word value.
   /// - Parameter ordering: The memory ordering to apply on this operation.
   /// - Returns: The new value after the operation.
   @_semantics("atomics.requires_constant_orderings")
   @_transparent @_alwaysEmitIntoClient
   public func bitwiseXorThenLoad(
-    with operand: Value,
+    with operand: DoubleWord,
     ordering: AtomicUpdateOrdering
-  ) -> Value {
+  ) -> DoubleWord {
     let original = Value.AtomicRepresentation.atomicLoadThenBitwiseXor(
       with: operand,
       at: _ptr,
@@ -869,18 +1772,19 @@ extension ManagedAtomic where Value: AtomicInteger {
     return original ^ operand
   }
 
-  /// Perform an atomic wrapping increment operation applying the
-  /// specified memory ordering.
+  /// Perform an atomic wrapping add operation on the current value, treating it
+  /// as a single unsigned integer, applying the specified memory ordering.
   ///
   /// Note: This operation silently wraps around on overflow, like the
-  /// `&+=` operator does on `Int` values.
+  /// `&+` operator does on `DoubleWord` values. It carries across the
+  /// two words.
   ///
-  /// - Parameter operand: The value to add to the current value.
+  /// - Parameter operand: A double word value.
   /// - Parameter ordering: The memory ordering to apply on this operation.
   @_semantics("atomics.requires_constant_orderings")
   @_transparent @_alwaysEmitIntoClient
   public func wrappingIncrement(
-    by operand: Value = 1,
+    by operand: DoubleWord = DoubleWord(high: 0, low: 1),
     ordering: AtomicUpdateOrdering
   ) {
     _ = Value.AtomicRepresentation.atomicLoadThenWrappingIncrement(
@@ -888,19 +1792,19 @@ extension ManagedAtomic where Value: AtomicInteger {
       at: _ptr,
       ordering: ordering)
   }
-
-  /// Perform an atomic wrapping decrement operation applying the
-  /// specified memory ordering.
+  /// Perform an atomic wrapping subtract operation on the current value, treating it
+  /// as a single unsigned integer, applying the specified memory ordering.
   ///
   /// Note: This operation silently wraps around on overflow, like the
-  /// `&-=` operator does on `Int` values.
+  /// `&-` operator does on `DoubleWord` values. It carries across the
+  /// two words.
   ///
-  /// - Parameter operand: The value to subtract from the current value.
+  /// - Parameter operand: A double word value.
   /// - Parameter ordering: The memory ordering to apply on this operation.
   @_semantics("atomics.requires_constant_orderings")
   @_transparent @_alwaysEmitIntoClient
   public func wrappingDecrement(
-    by operand: Value = 1,
+    by operand: DoubleWord = DoubleWord(high: 0, low: 1),
     ordering: AtomicUpdateOrdering
   ) {
     _ = Value.AtomicRepresentation.atomicLoadThenWrappingDecrement(
@@ -909,3 +1813,177 @@ extension ManagedAtomic where Value: AtomicInteger {
       ordering: ordering)
   }
 }
+
+extension ManagedAtomic
+where
+  Value: RawRepresentable,
+  Value.RawValue: AtomicValue,
+  Value.AtomicRepresentation == AtomicRawRepresentableStorage<Value>
+{
+  @_alwaysEmitIntoClient @inline(__always)
+  internal var _rawPtr: UnsafeMutablePointer<Value.RawValue.AtomicRepresentation> {
+    Value.AtomicRepresentation._extract(_ptr)
+  }
+}
+
+extension ManagedAtomic where Value: AtomicPackedValue {
+  /// Atomically adds `operand` to the specified field of the current value,
+  /// leaving the other fields intact, and returns the original value,
+  /// applying the specified memory ordering.
+  ///
+  /// This is a single atomic integer addition on the packed raw value. The
+  /// field must not overflow: a carry out of the field would change the
+  /// fields above it. (This is checked in debug builds.)
+  ///
+  /// - Parameter field: A field of the packed value.
+  /// - Parameter operand: The value to add to the field.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  @discardableResult
+  public func loadThenIncrement(
+    _ field: AtomicBitField<Value>,
+    by operand: Value.RawValue = 1,
+    ordering: AtomicUpdateOrdering
+  ) -> Value {
+    let raw = Value.RawValue.AtomicRepresentation.atomicLoadThenWrappingIncrement(
+      by: operand &<< Value.RawValue(field.offset),
+      at: _rawPtr,
+      ordering: ordering)
+    assert(
+      field.maximum - field.extract(from: raw) >= operand,
+      "Packed field overflow")
+    return Value(rawValue: raw)!
+  }
+
+  /// Atomically subtracts `operand` from the specified field of the current
+  /// value, leaving the other fields intact, and returns the original value,
+  /// applying the specified memory ordering.
+  ///
+  /// This is a single atomic integer subtraction on the packed raw value.
+  /// The field must not underflow: a borrow out of the field would change
+  /// the fields above it. (This is checked in debug builds.)
+  ///
+  /// - Parameter field: A field of the packed value.
+  /// - Parameter operand: The value to subtract from the field.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  @discardableResult
+  public func loadThenDecrement(
+    _ field: AtomicBitField<Value>,
+    by operand: Value.RawValue = 1,
+    ordering: AtomicUpdateOrdering
+  ) -> Value {
+    let raw = Value.RawValue.AtomicRepresentation.atomicLoadThenWrappingDecrement(
+      by: operand &<< Value.RawValue(field.offset),
+      at: _rawPtr,
+      ordering: ordering)
+    assert(field.extract(from: raw) >= operand, "Packed field underflow")
+    return Value(rawValue: raw)!
+  }
+
+  /// Perform an atomic compare and exchange operation on the specified field
+  /// of the current value, leaving the other fields intact, and applying the
+  /// specified memory ordering.
+  ///
+  /// This operation performs the following algorithm as a single atomic
+  /// transaction:
+  ///
+  /// ```
+  /// atomic(self) { currentValue in
+  ///   let original = currentValue
+  ///   guard original[field] == expected else { return (false, original) }
+  ///   currentValue[field] = desired
+  ///   return (true, original)
+  /// }
+  /// ```
+  ///
+  /// Changes to other fields don't make the exchange fail; to update the
+  /// field only if the other fields also have particular values, use a
+  /// regular compare and exchange operation instead.
+  ///
+  /// - Parameter field: A field of the packed value.
+  /// - Parameter expected: The expected current value of the field.
+  /// - Parameter desired: The desired new value of the field.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: A tuple `(exchanged, original)`, where `exchanged` is true if
+  ///   the exchange was successful, and `original` is the original value.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func compareExchange(
+    _ field: AtomicBitField<Value>,
+    expected: Value.RawValue,
+    desired: Value.RawValue,
+    ordering: AtomicUpdateOrdering
+  ) -> (exchanged: Bool, original: Value) {
+    Value.AtomicRepresentation._atomicCompareExchange(
+      at: _ptr,
+      ordering: ordering,
+      while: { field.extract(from: $0) == expected },
+      desired: { field.inserting(desired, into: $0) })
+  }
+}
+
+extension ManagedAtomic where Value: AtomicStateMachine {
+  /// Atomically changes the current state from `expected` to `desired`, if
+  /// the current state is `expected`, applying the specified memory
+  /// ordering.
+  ///
+  /// This is a single compare-exchange of the states' raw values. The
+  /// transition must be allowed by `Value.transitions`; requesting one that
+  /// isn't is a programming error, and traps without accessing the state.
+  ///
+  /// - Parameter expected: The expected current state.
+  /// - Parameter desired: The desired new state.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: A tuple `(exchanged, original)`, where `exchanged` is true if
+  ///   the transition happened, and `original` is the original state.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func transition(
+    from expected: Value,
+    to desired: Value,
+    ordering: AtomicUpdateOrdering
+  ) -> (exchanged: Bool, original: Value) {
+    precondition(
+      Value.transitions.allows(from: expected, to: desired),
+      "Invalid state transition")
+    let (exchanged, original) =
+      Value.RawValue.AtomicRepresentation.atomicCompareExchange(
+        expected: expected.rawValue,
+        desired: desired.rawValue,
+        at: _rawPtr,
+        ordering: ordering)
+    return (exchanged, exchanged ? expected : Value(rawValue: original)!)
+  }
+
+  /// Atomically changes the current state to `desired`, if
+  /// `Value.transitions` allows that from the current state, applying the
+  /// specified memory ordering.
+  ///
+  /// If the state changes concurrently, this tries again from the new state,
+  /// as long as the transition is still allowed. If it isn't, this returns
+  /// without writing to the state.
+  ///
+  /// - Parameter desired: The desired new state.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: A tuple `(exchanged, original)`, where `exchanged` is true if
+  ///   the transition happened, and `original` is the original state.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public func transition(
+    to desired: Value,
+    ordering: AtomicUpdateOrdering
+  ) -> (exchanged: Bool, original: Value) {
+    let table = Value.transitions
+    let target = desired.rawValue
+    return Value.AtomicRepresentation._atomicCompareExchange(
+      at: _ptr,
+      ordering: ordering,
+      while: { table._allows(from: $0, to: target) },
+      desired: { _ in target })
+  }
+}
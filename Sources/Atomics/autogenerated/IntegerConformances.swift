@@ -55,6 +55,16 @@ extension Int.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicLoadOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.load(at: pointer, ordering: ordering) {
+        _sa_load_relaxed_Int(pointer._extract)
+      }
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.load, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_load_relaxed_Int(pointer._extract)
@@ -74,6 +84,20 @@ extension Int.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicStoreOrdering
   ) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      _AtomicModel.store(
+        desired,
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int(pointer._extract) },
+        { _sa_store_relaxed_Int(pointer._extract, desired) })
+      return
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.store, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       _sa_store_relaxed_Int(pointer._extract, desired)
@@ -93,6 +117,27 @@ extension Int.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int(pointer._extract) },
+        { (_sa_exchange_relaxed_Int(pointer._extract, desired), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       return _sa_exchange_relaxed_Int(pointer._extract, desired)
@@ -117,8 +162,34 @@ extension Int.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_Int(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       exchanged = _sa_cmpxchg_strong_relaxed_relaxed_Int(
@@ -143,6 +214,11 @@ extension Int.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -155,8 +231,35 @@ extension Int.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: successOrdering,
+        failureOrdering: failureOrdering,
+        current: { _sa_load_relaxed_Int(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_Int(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -240,6 +343,11 @@ extension Int.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -252,8 +360,28 @@ extension Int.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      // The model checker doesn't simulate spurious failures.
+      return atomicCompareExchange(
+        expected: expected,
+        desired: desired,
+        at: pointer,
+        successOrdering: successOrdering,
+        failureOrdering: failureOrdering)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -337,6 +465,11 @@ extension Int.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 }
@@ -352,6 +485,18 @@ extension Int.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int(pointer._extract) },
+        { (_sa_fetch_add_relaxed_Int(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_add_relaxed_Int(
@@ -385,6 +530,18 @@ extension Int.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int(pointer._extract) },
+        { (_sa_fetch_sub_relaxed_Int(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_sub_relaxed_Int(
@@ -418,6 +575,18 @@ extension Int.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int(pointer._extract) },
+        { (_sa_fetch_and_relaxed_Int(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_and_relaxed_Int(
@@ -451,6 +620,18 @@ extension Int.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int(pointer._extract) },
+        { (_sa_fetch_or_relaxed_Int(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_or_relaxed_Int(
@@ -484,6 +665,18 @@ extension Int.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int(pointer._extract) },
+        { (_sa_fetch_xor_relaxed_Int(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_xor_relaxed_Int(
@@ -547,6 +740,16 @@ extension Int64.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicLoadOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.load(at: pointer, ordering: ordering) {
+        _sa_load_relaxed_Int64(pointer._extract)
+      }
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.load, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_load_relaxed_Int64(pointer._extract)
@@ -566,6 +769,20 @@ extension Int64.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicStoreOrdering
   ) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      _AtomicModel.store(
+        desired,
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int64(pointer._extract) },
+        { _sa_store_relaxed_Int64(pointer._extract, desired) })
+      return
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.store, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       _sa_store_relaxed_Int64(pointer._extract, desired)
@@ -585,6 +802,27 @@ extension Int64.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int64(pointer._extract) },
+        { (_sa_exchange_relaxed_Int64(pointer._extract, desired), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       return _sa_exchange_relaxed_Int64(pointer._extract, desired)
@@ -609,8 +847,34 @@ extension Int64.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int64(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_Int64(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       exchanged = _sa_cmpxchg_strong_relaxed_relaxed_Int64(
@@ -635,6 +899,11 @@ extension Int64.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -647,8 +916,35 @@ extension Int64.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: successOrdering,
+        failureOrdering: failureOrdering,
+        current: { _sa_load_relaxed_Int64(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_Int64(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -732,6 +1028,11 @@ extension Int64.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -744,8 +1045,28 @@ extension Int64.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      // The model checker doesn't simulate spurious failures.
+      return atomicCompareExchange(
+        expected: expected,
+        desired: desired,
+        at: pointer,
+        successOrdering: successOrdering,
+        failureOrdering: failureOrdering)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -829,6 +1150,11 @@ extension Int64.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 }
@@ -844,6 +1170,18 @@ extension Int64.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int64(pointer._extract) },
+        { (_sa_fetch_add_relaxed_Int64(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_add_relaxed_Int64(
@@ -877,6 +1215,18 @@ extension Int64.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int64(pointer._extract) },
+        { (_sa_fetch_sub_relaxed_Int64(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_sub_relaxed_Int64(
@@ -910,6 +1260,18 @@ extension Int64.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int64(pointer._extract) },
+        { (_sa_fetch_and_relaxed_Int64(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_and_relaxed_Int64(
@@ -943,6 +1305,18 @@ extension Int64.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int64(pointer._extract) },
+        { (_sa_fetch_or_relaxed_Int64(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_or_relaxed_Int64(
@@ -976,6 +1350,18 @@ extension Int64.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int64(pointer._extract) },
+        { (_sa_fetch_xor_relaxed_Int64(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_xor_relaxed_Int64(
@@ -1039,6 +1425,16 @@ extension Int32.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicLoadOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.load(at: pointer, ordering: ordering) {
+        _sa_load_relaxed_Int32(pointer._extract)
+      }
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.load, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_load_relaxed_Int32(pointer._extract)
@@ -1058,6 +1454,20 @@ extension Int32.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicStoreOrdering
   ) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      _AtomicModel.store(
+        desired,
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int32(pointer._extract) },
+        { _sa_store_relaxed_Int32(pointer._extract, desired) })
+      return
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.store, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       _sa_store_relaxed_Int32(pointer._extract, desired)
@@ -1077,6 +1487,27 @@ extension Int32.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int32(pointer._extract) },
+        { (_sa_exchange_relaxed_Int32(pointer._extract, desired), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       return _sa_exchange_relaxed_Int32(pointer._extract, desired)
@@ -1101,8 +1532,34 @@ extension Int32.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int32(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_Int32(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       exchanged = _sa_cmpxchg_strong_relaxed_relaxed_Int32(
@@ -1127,6 +1584,11 @@ extension Int32.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -1139,8 +1601,35 @@ extension Int32.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: successOrdering,
+        failureOrdering: failureOrdering,
+        current: { _sa_load_relaxed_Int32(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_Int32(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -1224,6 +1713,11 @@ extension Int32.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -1236,8 +1730,28 @@ extension Int32.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      // The model checker doesn't simulate spurious failures.
+      return atomicCompareExchange(
+        expected: expected,
+        desired: desired,
+        at: pointer,
+        successOrdering: successOrdering,
+        failureOrdering: failureOrdering)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -1321,6 +1835,11 @@ extension Int32.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 }
@@ -1336,6 +1855,18 @@ extension Int32.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int32(pointer._extract) },
+        { (_sa_fetch_add_relaxed_Int32(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_add_relaxed_Int32(
@@ -1369,6 +1900,18 @@ extension Int32.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int32(pointer._extract) },
+        { (_sa_fetch_sub_relaxed_Int32(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_sub_relaxed_Int32(
@@ -1402,6 +1945,18 @@ extension Int32.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int32(pointer._extract) },
+        { (_sa_fetch_and_relaxed_Int32(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_and_relaxed_Int32(
@@ -1435,6 +1990,18 @@ extension Int32.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int32(pointer._extract) },
+        { (_sa_fetch_or_relaxed_Int32(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_or_relaxed_Int32(
@@ -1468,6 +2035,18 @@ extension Int32.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int32(pointer._extract) },
+        { (_sa_fetch_xor_relaxed_Int32(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_xor_relaxed_Int32(
@@ -1531,6 +2110,16 @@ extension Int16.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicLoadOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.load(at: pointer, ordering: ordering) {
+        _sa_load_relaxed_Int16(pointer._extract)
+      }
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.load, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_load_relaxed_Int16(pointer._extract)
@@ -1550,6 +2139,20 @@ extension Int16.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicStoreOrdering
   ) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      _AtomicModel.store(
+        desired,
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int16(pointer._extract) },
+        { _sa_store_relaxed_Int16(pointer._extract, desired) })
+      return
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.store, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       _sa_store_relaxed_Int16(pointer._extract, desired)
@@ -1569,6 +2172,27 @@ extension Int16.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int16(pointer._extract) },
+        { (_sa_exchange_relaxed_Int16(pointer._extract, desired), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       return _sa_exchange_relaxed_Int16(pointer._extract, desired)
@@ -1593,8 +2217,34 @@ extension Int16.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int16(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_Int16(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       exchanged = _sa_cmpxchg_strong_relaxed_relaxed_Int16(
@@ -1619,6 +2269,11 @@ extension Int16.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -1631,8 +2286,35 @@ extension Int16.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: successOrdering,
+        failureOrdering: failureOrdering,
+        current: { _sa_load_relaxed_Int16(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_Int16(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -1716,6 +2398,11 @@ extension Int16.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -1728,8 +2415,28 @@ extension Int16.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      // The model checker doesn't simulate spurious failures.
+      return atomicCompareExchange(
+        expected: expected,
+        desired: desired,
+        at: pointer,
+        successOrdering: successOrdering,
+        failureOrdering: failureOrdering)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -1813,6 +2520,11 @@ extension Int16.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 }
@@ -1828,6 +2540,18 @@ extension Int16.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int16(pointer._extract) },
+        { (_sa_fetch_add_relaxed_Int16(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_add_relaxed_Int16(
@@ -1861,6 +2585,18 @@ extension Int16.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int16(pointer._extract) },
+        { (_sa_fetch_sub_relaxed_Int16(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_sub_relaxed_Int16(
@@ -1894,6 +2630,18 @@ extension Int16.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int16(pointer._extract) },
+        { (_sa_fetch_and_relaxed_Int16(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_and_relaxed_Int16(
@@ -1927,6 +2675,18 @@ extension Int16.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int16(pointer._extract) },
+        { (_sa_fetch_or_relaxed_Int16(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_or_relaxed_Int16(
@@ -1960,6 +2720,18 @@ extension Int16.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int16(pointer._extract) },
+        { (_sa_fetch_xor_relaxed_Int16(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_xor_relaxed_Int16(
@@ -2023,6 +2795,16 @@ extension Int8.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicLoadOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.load(at: pointer, ordering: ordering) {
+        _sa_load_relaxed_Int8(pointer._extract)
+      }
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.load, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_load_relaxed_Int8(pointer._extract)
@@ -2042,6 +2824,20 @@ extension Int8.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicStoreOrdering
   ) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      _AtomicModel.store(
+        desired,
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int8(pointer._extract) },
+        { _sa_store_relaxed_Int8(pointer._extract, desired) })
+      return
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.store, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       _sa_store_relaxed_Int8(pointer._extract, desired)
@@ -2061,6 +2857,27 @@ extension Int8.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int8(pointer._extract) },
+        { (_sa_exchange_relaxed_Int8(pointer._extract, desired), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       return _sa_exchange_relaxed_Int8(pointer._extract, desired)
@@ -2085,8 +2902,34 @@ extension Int8.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int8(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_Int8(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       exchanged = _sa_cmpxchg_strong_relaxed_relaxed_Int8(
@@ -2111,6 +2954,11 @@ extension Int8.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -2123,8 +2971,35 @@ extension Int8.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: successOrdering,
+        failureOrdering: failureOrdering,
+        current: { _sa_load_relaxed_Int8(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_Int8(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -2208,6 +3083,11 @@ extension Int8.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -2220,8 +3100,28 @@ extension Int8.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      // The model checker doesn't simulate spurious failures.
+      return atomicCompareExchange(
+        expected: expected,
+        desired: desired,
+        at: pointer,
+        successOrdering: successOrdering,
+        failureOrdering: failureOrdering)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -2305,6 +3205,11 @@ extension Int8.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 }
@@ -2320,6 +3225,18 @@ extension Int8.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int8(pointer._extract) },
+        { (_sa_fetch_add_relaxed_Int8(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_add_relaxed_Int8(
@@ -2353,6 +3270,18 @@ extension Int8.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int8(pointer._extract) },
+        { (_sa_fetch_sub_relaxed_Int8(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_sub_relaxed_Int8(
@@ -2386,6 +3315,18 @@ extension Int8.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int8(pointer._extract) },
+        { (_sa_fetch_and_relaxed_Int8(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_and_relaxed_Int8(
@@ -2419,6 +3360,18 @@ extension Int8.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int8(pointer._extract) },
+        { (_sa_fetch_or_relaxed_Int8(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_or_relaxed_Int8(
@@ -2452,6 +3405,18 @@ extension Int8.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_Int8(pointer._extract) },
+        { (_sa_fetch_xor_relaxed_Int8(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_xor_relaxed_Int8(
@@ -2515,6 +3480,16 @@ extension UInt.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicLoadOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.load(at: pointer, ordering: ordering) {
+        _sa_load_relaxed_UInt(pointer._extract)
+      }
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.load, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_load_relaxed_UInt(pointer._extract)
@@ -2534,6 +3509,20 @@ extension UInt.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicStoreOrdering
   ) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      _AtomicModel.store(
+        desired,
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt(pointer._extract) },
+        { _sa_store_relaxed_UInt(pointer._extract, desired) })
+      return
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.store, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       _sa_store_relaxed_UInt(pointer._extract, desired)
@@ -2553,6 +3542,27 @@ extension UInt.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt(pointer._extract) },
+        { (_sa_exchange_relaxed_UInt(pointer._extract, desired), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       return _sa_exchange_relaxed_UInt(pointer._extract, desired)
@@ -2577,8 +3587,34 @@ extension UInt.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_UInt(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       exchanged = _sa_cmpxchg_strong_relaxed_relaxed_UInt(
@@ -2603,6 +3639,11 @@ extension UInt.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -2615,8 +3656,35 @@ extension UInt.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: successOrdering,
+        failureOrdering: failureOrdering,
+        current: { _sa_load_relaxed_UInt(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_UInt(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -2700,6 +3768,11 @@ extension UInt.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -2712,8 +3785,28 @@ extension UInt.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      // The model checker doesn't simulate spurious failures.
+      return atomicCompareExchange(
+        expected: expected,
+        desired: desired,
+        at: pointer,
+        successOrdering: successOrdering,
+        failureOrdering: failureOrdering)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -2797,6 +3890,11 @@ extension UInt.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 }
@@ -2812,6 +3910,18 @@ extension UInt.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt(pointer._extract) },
+        { (_sa_fetch_add_relaxed_UInt(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_add_relaxed_UInt(
@@ -2845,6 +3955,18 @@ extension UInt.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt(pointer._extract) },
+        { (_sa_fetch_sub_relaxed_UInt(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_sub_relaxed_UInt(
@@ -2878,6 +4000,18 @@ extension UInt.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt(pointer._extract) },
+        { (_sa_fetch_and_relaxed_UInt(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_and_relaxed_UInt(
@@ -2911,6 +4045,18 @@ extension UInt.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt(pointer._extract) },
+        { (_sa_fetch_or_relaxed_UInt(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_or_relaxed_UInt(
@@ -2944,6 +4090,18 @@ extension UInt.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt(pointer._extract) },
+        { (_sa_fetch_xor_relaxed_UInt(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_xor_relaxed_UInt(
@@ -3007,6 +4165,16 @@ extension UInt64.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicLoadOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.load(at: pointer, ordering: ordering) {
+        _sa_load_relaxed_UInt64(pointer._extract)
+      }
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.load, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_load_relaxed_UInt64(pointer._extract)
@@ -3026,6 +4194,20 @@ extension UInt64.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicStoreOrdering
   ) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      _AtomicModel.store(
+        desired,
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt64(pointer._extract) },
+        { _sa_store_relaxed_UInt64(pointer._extract, desired) })
+      return
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.store, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       _sa_store_relaxed_UInt64(pointer._extract, desired)
@@ -3045,6 +4227,27 @@ extension UInt64.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt64(pointer._extract) },
+        { (_sa_exchange_relaxed_UInt64(pointer._extract, desired), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       return _sa_exchange_relaxed_UInt64(pointer._extract, desired)
@@ -3069,8 +4272,34 @@ extension UInt64.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt64(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_UInt64(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       exchanged = _sa_cmpxchg_strong_relaxed_relaxed_UInt64(
@@ -3095,6 +4324,11 @@ extension UInt64.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -3107,8 +4341,35 @@ extension UInt64.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: successOrdering,
+        failureOrdering: failureOrdering,
+        current: { _sa_load_relaxed_UInt64(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_UInt64(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -3192,6 +4453,11 @@ extension UInt64.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -3204,8 +4470,28 @@ extension UInt64.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      // The model checker doesn't simulate spurious failures.
+      return atomicCompareExchange(
+        expected: expected,
+        desired: desired,
+        at: pointer,
+        successOrdering: successOrdering,
+        failureOrdering: failureOrdering)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -3289,6 +4575,11 @@ extension UInt64.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 }
@@ -3304,6 +4595,18 @@ extension UInt64.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt64(pointer._extract) },
+        { (_sa_fetch_add_relaxed_UInt64(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_add_relaxed_UInt64(
@@ -3337,6 +4640,18 @@ extension UInt64.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt64(pointer._extract) },
+        { (_sa_fetch_sub_relaxed_UInt64(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_sub_relaxed_UInt64(
@@ -3370,6 +4685,18 @@ extension UInt64.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt64(pointer._extract) },
+        { (_sa_fetch_and_relaxed_UInt64(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_and_relaxed_UInt64(
@@ -3403,6 +4730,18 @@ extension UInt64.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt64(pointer._extract) },
+        { (_sa_fetch_or_relaxed_UInt64(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_or_relaxed_UInt64(
@@ -3436,6 +4775,18 @@ extension UInt64.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt64(pointer._extract) },
+        { (_sa_fetch_xor_relaxed_UInt64(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_xor_relaxed_UInt64(
@@ -3499,6 +4850,16 @@ extension UInt32.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicLoadOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.load(at: pointer, ordering: ordering) {
+        _sa_load_relaxed_UInt32(pointer._extract)
+      }
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.load, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_load_relaxed_UInt32(pointer._extract)
@@ -3518,6 +4879,20 @@ extension UInt32.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicStoreOrdering
   ) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      _AtomicModel.store(
+        desired,
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt32(pointer._extract) },
+        { _sa_store_relaxed_UInt32(pointer._extract, desired) })
+      return
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.store, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       _sa_store_relaxed_UInt32(pointer._extract, desired)
@@ -3537,6 +4912,27 @@ extension UInt32.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt32(pointer._extract) },
+        { (_sa_exchange_relaxed_UInt32(pointer._extract, desired), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       return _sa_exchange_relaxed_UInt32(pointer._extract, desired)
@@ -3561,8 +4957,34 @@ extension UInt32.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt32(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_UInt32(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       exchanged = _sa_cmpxchg_strong_relaxed_relaxed_UInt32(
@@ -3587,6 +5009,11 @@ extension UInt32.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -3599,8 +5026,35 @@ extension UInt32.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: successOrdering,
+        failureOrdering: failureOrdering,
+        current: { _sa_load_relaxed_UInt32(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_UInt32(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -3684,6 +5138,11 @@ extension UInt32.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -3696,8 +5155,28 @@ extension UInt32.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      // The model checker doesn't simulate spurious failures.
+      return atomicCompareExchange(
+        expected: expected,
+        desired: desired,
+        at: pointer,
+        successOrdering: successOrdering,
+        failureOrdering: failureOrdering)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -3781,6 +5260,11 @@ extension UInt32.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 }
@@ -3796,6 +5280,18 @@ extension UInt32.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt32(pointer._extract) },
+        { (_sa_fetch_add_relaxed_UInt32(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_add_relaxed_UInt32(
@@ -3829,6 +5325,18 @@ extension UInt32.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt32(pointer._extract) },
+        { (_sa_fetch_sub_relaxed_UInt32(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_sub_relaxed_UInt32(
@@ -3862,6 +5370,18 @@ extension UInt32.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt32(pointer._extract) },
+        { (_sa_fetch_and_relaxed_UInt32(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_and_relaxed_UInt32(
@@ -3895,6 +5415,18 @@ extension UInt32.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt32(pointer._extract) },
+        { (_sa_fetch_or_relaxed_UInt32(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_or_relaxed_UInt32(
@@ -3928,6 +5460,18 @@ extension UInt32.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt32(pointer._extract) },
+        { (_sa_fetch_xor_relaxed_UInt32(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_xor_relaxed_UInt32(
@@ -3991,6 +5535,16 @@ extension UInt16.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicLoadOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.load(at: pointer, ordering: ordering) {
+        _sa_load_relaxed_UInt16(pointer._extract)
+      }
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.load, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_load_relaxed_UInt16(pointer._extract)
@@ -4010,6 +5564,20 @@ extension UInt16.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicStoreOrdering
   ) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      _AtomicModel.store(
+        desired,
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt16(pointer._extract) },
+        { _sa_store_relaxed_UInt16(pointer._extract, desired) })
+      return
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.store, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       _sa_store_relaxed_UInt16(pointer._extract, desired)
@@ -4029,6 +5597,27 @@ extension UInt16.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt16(pointer._extract) },
+        { (_sa_exchange_relaxed_UInt16(pointer._extract, desired), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       return _sa_exchange_relaxed_UInt16(pointer._extract, desired)
@@ -4053,8 +5642,34 @@ extension UInt16.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt16(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_UInt16(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       exchanged = _sa_cmpxchg_strong_relaxed_relaxed_UInt16(
@@ -4079,6 +5694,11 @@ extension UInt16.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -4091,8 +5711,35 @@ extension UInt16.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: successOrdering,
+        failureOrdering: failureOrdering,
+        current: { _sa_load_relaxed_UInt16(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_UInt16(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -4176,6 +5823,11 @@ extension UInt16.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -4188,8 +5840,28 @@ extension UInt16.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      // The model checker doesn't simulate spurious failures.
+      return atomicCompareExchange(
+        expected: expected,
+        desired: desired,
+        at: pointer,
+        successOrdering: successOrdering,
+        failureOrdering: failureOrdering)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -4273,6 +5945,11 @@ extension UInt16.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 }
@@ -4288,6 +5965,18 @@ extension UInt16.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt16(pointer._extract) },
+        { (_sa_fetch_add_relaxed_UInt16(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_add_relaxed_UInt16(
@@ -4321,6 +6010,18 @@ extension UInt16.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt16(pointer._extract) },
+        { (_sa_fetch_sub_relaxed_UInt16(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_sub_relaxed_UInt16(
@@ -4354,6 +6055,18 @@ extension UInt16.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt16(pointer._extract) },
+        { (_sa_fetch_and_relaxed_UInt16(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_and_relaxed_UInt16(
@@ -4387,6 +6100,18 @@ extension UInt16.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt16(pointer._extract) },
+        { (_sa_fetch_or_relaxed_UInt16(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_or_relaxed_UInt16(
@@ -4420,6 +6145,18 @@ extension UInt16.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt16(pointer._extract) },
+        { (_sa_fetch_xor_relaxed_UInt16(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_xor_relaxed_UInt16(
@@ -4483,6 +6220,16 @@ extension UInt8.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicLoadOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.load(at: pointer, ordering: ordering) {
+        _sa_load_relaxed_UInt8(pointer._extract)
+      }
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.load, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_load_relaxed_UInt8(pointer._extract)
@@ -4502,6 +6249,20 @@ extension UInt8.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicStoreOrdering
   ) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      _AtomicModel.store(
+        desired,
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt8(pointer._extract) },
+        { _sa_store_relaxed_UInt8(pointer._extract, desired) })
+      return
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.store, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       _sa_store_relaxed_UInt8(pointer._extract, desired)
@@ -4521,6 +6282,27 @@ extension UInt8.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt8(pointer._extract) },
+        { (_sa_exchange_relaxed_UInt8(pointer._extract, desired), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       return _sa_exchange_relaxed_UInt8(pointer._extract, desired)
@@ -4545,8 +6327,34 @@ extension UInt8.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt8(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_UInt8(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       exchanged = _sa_cmpxchg_strong_relaxed_relaxed_UInt8(
@@ -4571,6 +6379,11 @@ extension UInt8.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -4583,8 +6396,35 @@ extension UInt8.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: successOrdering,
+        failureOrdering: failureOrdering,
+        current: { _sa_load_relaxed_UInt8(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_UInt8(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -4668,6 +6508,11 @@ extension UInt8.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -4680,8 +6525,28 @@ extension UInt8.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      // The model checker doesn't simulate spurious failures.
+      return atomicCompareExchange(
+        expected: expected,
+        desired: desired,
+        at: pointer,
+        successOrdering: successOrdering,
+        failureOrdering: failureOrdering)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -4765,6 +6630,11 @@ extension UInt8.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 }
@@ -4780,6 +6650,18 @@ extension UInt8.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt8(pointer._extract) },
+        { (_sa_fetch_add_relaxed_UInt8(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_add_relaxed_UInt8(
@@ -4813,6 +6695,18 @@ extension UInt8.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt8(pointer._extract) },
+        { (_sa_fetch_sub_relaxed_UInt8(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_sub_relaxed_UInt8(
@@ -4846,6 +6740,18 @@ extension UInt8.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt8(pointer._extract) },
+        { (_sa_fetch_and_relaxed_UInt8(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_and_relaxed_UInt8(
@@ -4879,6 +6785,18 @@ extension UInt8.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt8(pointer._extract) },
+        { (_sa_fetch_or_relaxed_UInt8(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_or_relaxed_UInt8(
@@ -4912,6 +6830,18 @@ extension UInt8.AtomicRepresentation: AtomicIntegerStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_UInt8(pointer._extract) },
+        { (_sa_fetch_xor_relaxed_UInt8(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_fetch_xor_relaxed_UInt8(
@@ -4939,9 +6869,6 @@ extension UInt8.AtomicRepresentation: AtomicIntegerStorage {
   }
 }
 
-// Double-wide atomic primitives on x86_64 CPUs aren't available by default
-// on Linux distributions, and we cannot currently enable them automatically.
-#if !(os(Linux) && arch(x86_64)) || ENABLE_DOUBLEWIDE_ATOMICS
 extension DoubleWord: AtomicValue {
   public struct AtomicRepresentation {
     public typealias Value = DoubleWord
@@ -4978,6 +6905,16 @@ extension DoubleWord.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicLoadOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.load(at: pointer, ordering: ordering) {
+        _sa_load_relaxed_DoubleWord(pointer._extract)
+      }
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.load, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       return _sa_load_relaxed_DoubleWord(pointer._extract)
@@ -4997,6 +6934,20 @@ extension DoubleWord.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicStoreOrdering
   ) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      _AtomicModel.store(
+        desired,
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_DoubleWord(pointer._extract) },
+        { _sa_store_relaxed_DoubleWord(pointer._extract, desired) })
+      return
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.store, at: pointer)
+#endif
     switch ordering {
     case .relaxed:
       _sa_store_relaxed_DoubleWord(pointer._extract, desired)
@@ -5016,6 +6967,27 @@ extension DoubleWord.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> Value {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_DoubleWord(pointer._extract) },
+        { (_sa_exchange_relaxed_DoubleWord(pointer._extract, desired), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       return _sa_exchange_relaxed_DoubleWord(pointer._extract, desired)
@@ -5040,8 +7012,34 @@ extension DoubleWord.AtomicRepresentation: AtomicStorage {
     at pointer: UnsafeMutablePointer<Self>,
     ordering: AtomicUpdateOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_DoubleWord(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_DoubleWord(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     switch ordering {
     case .relaxed:
       exchanged = _sa_cmpxchg_strong_relaxed_relaxed_DoubleWord(
@@ -5066,6 +7064,11 @@ extension DoubleWord.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -5078,8 +7081,35 @@ extension DoubleWord.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var expected = expected
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: successOrdering,
+        failureOrdering: failureOrdering,
+        current: { _sa_load_relaxed_DoubleWord(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_strong_relaxed_relaxed_DoubleWord(
+            pointer._extract,
+            &expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, expected)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -5163,6 +7193,11 @@ extension DoubleWord.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 
@@ -5175,8 +7210,28 @@ extension DoubleWord.AtomicRepresentation: AtomicStorage {
     successOrdering: AtomicUpdateOrdering,
     failureOrdering: AtomicLoadOrdering
   ) -> (exchanged: Bool, original: Value) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      // The model checker doesn't simulate spurious failures.
+      return atomicCompareExchange(
+        expected: expected,
+        desired: desired,
+        at: pointer,
+        successOrdering: successOrdering,
+        failureOrdering: failureOrdering)
+    }
+#endif
     var expected = expected
     let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
     // FIXME: stdatomic.h (and LLVM underneath) doesn't support
     // arbitrary ordering combinations yet, so upgrade the success
     // ordering when necessary so that it is at least as "strong" as
@@ -5260,9 +7315,622 @@ extension DoubleWord.AtomicRepresentation: AtomicStorage {
     default:
       fatalError("Unsupported ordering")
     }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
     return (exchanged, expected)
   }
 }
 
+extension DoubleWord.AtomicRepresentation {
+  /// Perform an atomic compare and exchange operation on the high
+  /// word of the value referenced by `pointer`, leaving the other word
+  /// intact, and applying the specified memory ordering.
+  ///
+  /// This operation performs the following algorithm as a single atomic
+  /// transaction:
+  ///
+  /// ```
+  /// atomic(self) { currentValue in
+  ///   let original = currentValue
+  ///   guard original.high == expected else { return (false, original) }
+  ///   currentValue.high = desired
+  ///   return (true, original)
+  /// }
+  /// ```
+  ///
+  /// To update the high word only if the other word also has a
+  /// particular value, use a regular compare and exchange operation instead.
+  ///
+  /// - Parameter expected: The expected current value of the high word.
+  /// - Parameter desired: The desired new value of the high word.
+  /// - Parameter pointer: A memory location previously initialized with a value
+  ///   returned by `prepareAtomicRepresentation(for:)`.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: A tuple `(exchanged, original)`, where `exchanged` is true if
+  ///   the exchange was successful, and `original` is the original value.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public static func atomicCompareExchangeHigh(
+    expected: UInt,
+    desired: UInt,
+    at pointer: UnsafeMutablePointer<Self>,
+    ordering: AtomicUpdateOrdering
+  ) -> (exchanged: Bool, original: DoubleWord) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var original = DoubleWord(high: 0, low: 0)
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_DoubleWord(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_high_relaxed_DoubleWord(
+            pointer._extract,
+            &original,
+            expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, original)
+    }
+#endif
+    var original = DoubleWord(high: 0, low: 0)
+    let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
+    switch ordering {
+    case .relaxed:
+      exchanged = _sa_cmpxchg_high_relaxed_DoubleWord(
+        pointer._extract,
+        &original,
+        expected,
+        desired)
+    case .acquiring:
+      exchanged = _sa_cmpxchg_high_acquire_DoubleWord(
+        pointer._extract,
+        &original,
+        expected,
+        desired)
+    case .releasing:
+      exchanged = _sa_cmpxchg_high_release_DoubleWord(
+        pointer._extract,
+        &original,
+        expected,
+        desired)
+    case .acquiringAndReleasing:
+      exchanged = _sa_cmpxchg_high_acq_rel_DoubleWord(
+        pointer._extract,
+        &original,
+        expected,
+        desired)
+    case .sequentiallyConsistent:
+      exchanged = _sa_cmpxchg_high_seq_cst_DoubleWord(
+        pointer._extract,
+        &original,
+        expected,
+        desired)
+    default:
+      fatalError("Unsupported ordering")
+    }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
+    return (exchanged, original)
+  }
+
+  /// Perform an atomic wrapping increment operation on the high
+  /// word of the value referenced by `pointer`, leaving the other word
+  /// intact, and return the original value, applying the specified memory
+  /// ordering.
+  ///
+  /// Note: This operation silently wraps around on overflow, like the
+  /// `&+=` operator does on integer values. It never carries over into the
+  /// other word.
+  ///
+  /// - Parameter operand: The value to add to the high word.
+  /// - Parameter pointer: A memory location previously initialized with a value
+  ///   returned by `prepareAtomicRepresentation(for:)`.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  @discardableResult
+  public static func atomicLoadThenWrappingIncrementHigh(
+    by operand: UInt = 1,
+    at pointer: UnsafeMutablePointer<Self>,
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_DoubleWord(pointer._extract) },
+        { (_sa_fetch_add_high_relaxed_DoubleWord(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
+    switch ordering {
+    case .relaxed:
+      return _sa_fetch_add_high_relaxed_DoubleWord(
+        pointer._extract,
+        operand)
+    case .acquiring:
+      return _sa_fetch_add_high_acquire_DoubleWord(
+        pointer._extract,
+        operand)
+    case .releasing:
+      return _sa_fetch_add_high_release_DoubleWord(
+        pointer._extract,
+        operand)
+    case .acquiringAndReleasing:
+      return _sa_fetch_add_high_acq_rel_DoubleWord(
+        pointer._extract,
+        operand)
+    case .sequentiallyConsistent:
+      return _sa_fetch_add_high_seq_cst_DoubleWord(
+        pointer._extract,
+        operand)
+    default:
+      fatalError("Unsupported ordering")
+    }
+  }
+  /// Perform an atomic compare and exchange operation on the low
+  /// word of the value referenced by `pointer`, leaving the other word
+  /// intact, and applying the specified memory ordering.
+  ///
+  /// This operation performs the following algorithm as a single atomic
+  /// transaction:
+  ///
+  /// ```
+  /// atomic(self) { currentValue in
+  ///   let original = currentValue
+  ///   guard original.low == expected else { return (false, original) }
+  ///   currentValue.low = desired
+  ///   return (true, original)
+  /// }
+  /// ```
+  ///
+  /// To update the low word only if the other word also has a
+  /// particular value, use a regular compare and exchange operation instead.
+  ///
+  /// - Parameter expected: The expected current value of the low word.
+  /// - Parameter desired: The desired new value of the low word.
+  /// - Parameter pointer: A memory location previously initialized with a value
+  ///   returned by `prepareAtomicRepresentation(for:)`.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: A tuple `(exchanged, original)`, where `exchanged` is true if
+  ///   the exchange was successful, and `original` is the original value.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  public static func atomicCompareExchangeLow(
+    expected: UInt,
+    desired: UInt,
+    at pointer: UnsafeMutablePointer<Self>,
+    ordering: AtomicUpdateOrdering
+  ) -> (exchanged: Bool, original: DoubleWord) {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      var original = DoubleWord(high: 0, low: 0)
+      let exchanged: Bool = _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_DoubleWord(pointer._extract) },
+        {
+          let exchanged = _sa_cmpxchg_low_relaxed_DoubleWord(
+            pointer._extract,
+            &original,
+            expected,
+            desired)
+          return (exchanged, exchanged)
+        })
+      return (exchanged, original)
+    }
+#endif
+    var original = DoubleWord(high: 0, low: 0)
+    let exchanged: Bool
+#if ATOMICS_CONTENTION_PROFILING
+    let _sample = _sa_profiler_should_sample()
+    let _start = _sample ? _sa_profiler_timestamp() : 0
+    defer {
+      if _sample {
+        _sa_profiler_record(pointer, _sa_profiler_timestamp() &- _start)
+      }
+    }
+#endif
+    switch ordering {
+    case .relaxed:
+      exchanged = _sa_cmpxchg_low_relaxed_DoubleWord(
+        pointer._extract,
+        &original,
+        expected,
+        desired)
+    case .acquiring:
+      exchanged = _sa_cmpxchg_low_acquire_DoubleWord(
+        pointer._extract,
+        &original,
+        expected,
+        desired)
+    case .releasing:
+      exchanged = _sa_cmpxchg_low_release_DoubleWord(
+        pointer._extract,
+        &original,
+        expected,
+        desired)
+    case .acquiringAndReleasing:
+      exchanged = _sa_cmpxchg_low_acq_rel_DoubleWord(
+        pointer._extract,
+        &original,
+        expected,
+        desired)
+    case .sequentiallyConsistent:
+      exchanged = _sa_cmpxchg_low_seq_cst_DoubleWord(
+        pointer._extract,
+        &original,
+        expected,
+        desired)
+    default:
+      fatalError("Unsupported ordering")
+    }
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(
+      exchanged ? .readModifyWrite : .failedReadModifyWrite,
+      at: pointer)
+#endif
+    return (exchanged, original)
+  }
+
+  /// Perform an atomic wrapping increment operation on the low
+  /// word of the value referenced by `pointer`, leaving the other word
+  /// intact, and return the original value, applying the specified memory
+  /// ordering.
+  ///
+  /// Note: This operation silently wraps around on overflow, like the
+  /// `&+=` operator does on integer values. It never carries over into the
+  /// other word.
+  ///
+  /// - Parameter operand: The value to add to the low word.
+  /// - Parameter pointer: A memory location previously initialized with a value
+  ///   returned by `prepareAtomicRepresentation(for:)`.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  @discardableResult
+  public static func atomicLoadThenWrappingIncrementLow(
+    by operand: UInt = 1,
+    at pointer: UnsafeMutablePointer<Self>,
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_DoubleWord(pointer._extract) },
+        { (_sa_fetch_add_low_relaxed_DoubleWord(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
+    switch ordering {
+    case .relaxed:
+      return _sa_fetch_add_low_relaxed_DoubleWord(
+        pointer._extract,
+        operand)
+    case .acquiring:
+      return _sa_fetch_add_low_acquire_DoubleWord(
+        pointer._extract,
+        operand)
+    case .releasing:
+      return _sa_fetch_add_low_release_DoubleWord(
+        pointer._extract,
+        operand)
+    case .acquiringAndReleasing:
+      return _sa_fetch_add_low_acq_rel_DoubleWord(
+        pointer._extract,
+        operand)
+    case .sequentiallyConsistent:
+      return _sa_fetch_add_low_seq_cst_DoubleWord(
+        pointer._extract,
+        operand)
+    default:
+      fatalError("Unsupported ordering")
+    }
+  }
+
+  /// Perform an atomic wrapping add operation on the value referenced by
+  /// `pointer`, treating it as a single unsigned integer, and return the
+  /// original value, applying the specified memory ordering.
+  ///
+  /// Note: This operation silently wraps around on overflow, like the
+  /// `&+` operator does on `DoubleWord` values. It carries across the
+  /// two words.
+  ///
+  /// - Parameter operand: A double word value.
+  /// - Parameter pointer: A memory location previously initialized with a value
+  ///   returned by `prepareAtomicRepresentation(for:)`.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  @discardableResult
+  public static func atomicLoadThenWrappingIncrement(
+    by operand: DoubleWord = DoubleWord(high: 0, low: 1),
+    at pointer: UnsafeMutablePointer<Self>,
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_DoubleWord(pointer._extract) },
+        { (_sa_fetch_add_relaxed_DoubleWord(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
+    switch ordering {
+    case .relaxed:
+      return _sa_fetch_add_relaxed_DoubleWord(
+        pointer._extract,
+        operand)
+    case .acquiring:
+      return _sa_fetch_add_acquire_DoubleWord(
+        pointer._extract,
+        operand)
+    case .releasing:
+      return _sa_fetch_add_release_DoubleWord(
+        pointer._extract,
+        operand)
+    case .acquiringAndReleasing:
+      return _sa_fetch_add_acq_rel_DoubleWord(
+        pointer._extract,
+        operand)
+    case .sequentiallyConsistent:
+      return _sa_fetch_add_seq_cst_DoubleWord(
+        pointer._extract,
+        operand)
+    default:
+      fatalError("Unsupported ordering")
+    }
+  }
+  /// Perform an atomic wrapping subtract operation on the value referenced by
+  /// `pointer`, treating it as a single unsigned integer, and return the
+  /// original value, applying the specified memory ordering.
+  ///
+  /// Note: This operation silently wraps around on overflow, like the
+  /// `&-` operator does on `DoubleWord` values. It carries across the
+  /// two words.
+  ///
+  /// - Parameter operand: A double word value.
+  /// - Parameter pointer: A memory location previously initialized with a value
+  ///   returned by `prepareAtomicRepresentation(for:)`.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  @discardableResult
+  public static func atomicLoadThenWrappingDecrement(
+    by operand: DoubleWord = DoubleWord(high: 0, low: 1),
+    at pointer: UnsafeMutablePointer<Self>,
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_DoubleWord(pointer._extract) },
+        { (_sa_fetch_sub_relaxed_DoubleWord(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
+    switch ordering {
+    case .relaxed:
+      return _sa_fetch_sub_relaxed_DoubleWord(
+        pointer._extract,
+        operand)
+    case .acquiring:
+      return _sa_fetch_sub_acquire_DoubleWord(
+        pointer._extract,
+        operand)
+    case .releasing:
+      return _sa_fetch_sub_release_DoubleWord(
+        pointer._extract,
+        operand)
+    case .acquiringAndReleasing:
+      return _sa_fetch_sub_acq_rel_DoubleWord(
+        pointer._extract,
+        operand)
+    case .sequentiallyConsistent:
+      return _sa_fetch_sub_seq_cst_DoubleWord(
+        pointer._extract,
+        operand)
+    default:
+      fatalError("Unsupported ordering")
+    }
+  }
+  /// Perform an atomic bitwise AND operation on the value referenced by
+  /// `pointer`, treating it as a single unsigned integer, and return the
+  /// original value, applying the specified memory ordering.
+  ///
+  /// - Parameter operand: A double word value.
+  /// - Parameter pointer: A memory location previously initialized with a value
+  ///   returned by `prepareAtomicRepresentation(for:)`.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  @discardableResult
+  public static func atomicLoadThenBitwiseAnd(
+    with operand: DoubleWord,
+    at pointer: UnsafeMutablePointer<Self>,
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_DoubleWord(pointer._extract) },
+        { (_sa_fetch_and_relaxed_DoubleWord(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
+    switch ordering {
+    case .relaxed:
+      return _sa_fetch_and_relaxed_DoubleWord(
+        pointer._extract,
+        operand)
+    case .acquiring:
+      return _sa_fetch_and_acquire_DoubleWord(
+        pointer._extract,
+        operand)
+    case .releasing:
+      return _sa_fetch_and_release_DoubleWord(
+        pointer._extract,
+        operand)
+    case .acquiringAndReleasing:
+      return _sa_fetch_and_acq_rel_DoubleWord(
+        pointer._extract,
+        operand)
+    case .sequentiallyConsistent:
+      return _sa_fetch_and_seq_cst_DoubleWord(
+        pointer._extract,
+        operand)
+    default:
+      fatalError("Unsupported ordering")
+    }
+  }
+  /// Perform an atomic bitwise OR operation on the value referenced by
+  /// `pointer`, treating it as a single unsigned integer, and return the
+  /// original value, applying the specified memory ordering.
+  ///
+  /// - Parameter operand: A double word value.
+  /// - Parameter pointer: A memory location previously initialized with a value
+  ///   returned by `prepareAtomicRepresentation(for:)`.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  @discardableResult
+  public static func atomicLoadThenBitwiseOr(
+    with operand: DoubleWord,
+    at pointer: UnsafeMutablePointer<Self>,
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_DoubleWord(pointer._extract) },
+        { (_sa_fetch_or_relaxed_DoubleWord(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
+    switch ordering {
+    case .relaxed:
+      return _sa_fetch_or_relaxed_DoubleWord(
+        pointer._extract,
+        operand)
+    case .acquiring:
+      return _sa_fetch_or_acquire_DoubleWord(
+        pointer._extract,
+        operand)
+    case .releasing:
+      return _sa_fetch_or_release_DoubleWord(
+        pointer._extract,
+        operand)
+    case .acquiringAndReleasing:
+      return _sa_fetch_or_acq_rel_DoubleWord(
+        pointer._extract,
+        operand)
+    case .sequentiallyConsistent:
+      return _sa_fetch_or_seq_cst_DoubleWord(
+        pointer._extract,
+        operand)
+    default:
+      fatalError("Unsupported ordering")
+    }
+  }
+  /// Perform an atomic bitwise XOR operation on the value referenced by
+  /// `pointer`, treating it as a single unsigned integer, and return the
+  /// original value, applying the specified memory ordering.
+  ///
+  /// - Parameter operand: A double word value.
+  /// - Parameter pointer: A memory location previously initialized with a value
+  ///   returned by `prepareAtomicRepresentation(for:)`.
+  /// - Parameter ordering: The memory ordering to apply on this operation.
+  /// - Returns: The original value before the operation.
+  @_semantics("atomics.requires_constant_orderings")
+  @_transparent @_alwaysEmitIntoClient
+  @discardableResult
+  public static func atomicLoadThenBitwiseXor(
+    with operand: DoubleWord,
+    at pointer: UnsafeMutablePointer<Self>,
+    ordering: AtomicUpdateOrdering
+  ) -> DoubleWord {
+#if ATOMICS_MODEL_CHECKING
+    if _AtomicModel.isActive {
+      return _AtomicModel.update(
+        at: pointer,
+        ordering: ordering,
+        current: { _sa_load_relaxed_DoubleWord(pointer._extract) },
+        { (_sa_fetch_xor_relaxed_DoubleWord(pointer._extract, operand), true) })
+    }
+#endif
+#if ATOMICS_INSTRUMENTATION
+    AtomicInstrumentation._record(.readModifyWrite, at: pointer)
+#endif
+    switch ordering {
+    case .relaxed:
+      return _sa_fetch_xor_relaxed_DoubleWord(
+        pointer._extract,
+        operand)
+    case .acquiring:
+      return _sa_fetch_xor_acquire_DoubleWord(
+        pointer._extract,
+        operand)
+    case .releasing:
+      return _sa_fetch_xor_release_DoubleWord(
+        pointer._extract,
+        operand)
+    case .acquiringAndReleasing:
+      return _sa_fetch_xor_acq_rel_DoubleWord(
+        pointer._extract,
+        operand)
+    case .sequentiallyConsistent:
+      return _sa_fetch_xor_seq_cst_DoubleWord(
+        pointer._extract,
+        operand)
+    default:
+      fatalError("Unsupported ordering")
+    }
+  }
+}
 
-#endif // ENABLE_DOUBLEWIDE_ATOMICS
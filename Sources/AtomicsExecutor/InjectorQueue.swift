@@ -0,0 +1,123 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import Atomics
+
+// An unbounded multi-producer, multi-consumer FIFO queue, following
+// M. Michael and M. Scott's 1996 paper "Simple, Fast, and Practical
+// Non-Blocking and Blocking Concurrent Queue Algorithms" [Michael 1996].
+//
+// Links between nodes are atomic strong references, so reference counting
+// takes care of the original algorithm's memory reclamation and ABA
+// problems. Dequeued nodes have their `next` link replaced by a marker, so
+// that threads suspended in the middle of an operation don't keep arbitrary
+// long chains of dequeued nodes alive.
+
+/// The queue that tasks submitted from outside the executor's workers go
+/// through.
+internal final class _InjectorQueue<Element> {
+  final class Node: AtomicReference {
+    let next: ManagedAtomic<Node?>
+    var value: Element?
+
+    init(value: Element?) {
+      self.value = value
+      self.next = ManagedAtomic(nil)
+    }
+
+    deinit {
+      // Release long chains iteratively rather than recursively.
+      var node = next.exchange(nil, ordering: .relaxed)
+      while node != nil && isKnownUniquelyReferenced(&node) {
+        node = node!.next.exchange(nil, ordering: .relaxed)
+      }
+    }
+  }
+
+  private let head: ManagedAtomic<Node>
+  private let tail: ManagedAtomic<Node>
+  private let marker = Node(value: nil)
+
+  init() {
+    let dummy = Node(value: nil)
+    head = ManagedAtomic(dummy)
+    tail = ManagedAtomic(dummy)
+  }
+
+  /// Returns true if the queue contained no elements at the time of the
+  /// call.
+  var isEmpty: Bool {
+    let next = head.load(ordering: .acquiring).next.load(ordering: .acquiring)
+    return next == nil || next === marker
+  }
+
+  func enqueue(_ value: Element) {
+    let new = Node(value: value)
+    var tail = self.tail.load(ordering: .acquiring)
+    while true {
+      let next = tail.next.load(ordering: .acquiring)
+      if tail === marker || next === marker {
+        // `tail` has been dequeued in the meantime.
+        tail = self.tail.load(ordering: .acquiring)
+        continue
+      }
+      if let next = next {
+        // Help a concurrent enqueue move the tail forward.
+        let (exchanged, original) = self.tail.compareExchange(
+          expected: tail,
+          desired: next,
+          ordering: .acquiringAndReleasing)
+        tail = exchanged ? next : original
+        continue
+      }
+      let (exchanged, current) = tail.next.compareExchange(
+        expected: nil,
+        desired: new,
+        ordering: .acquiringAndReleasing)
+      if exchanged {
+        _ = self.tail.compareExchange(
+          expected: tail,
+          desired: new,
+          ordering: .releasing)
+        return
+      }
+      tail = current!
+    }
+  }
+
+  func dequeue() -> Element? {
+    while true {
+      let head = self.head.load(ordering: .acquiring)
+      let next = head.next.load(ordering: .acquiring)
+      if next === marker { continue }
+      guard let first = next else { return nil }
+      let tail = self.tail.load(ordering: .acquiring)
+      if head === tail {
+        // Make sure the tail doesn't fall behind the head.
+        _ = self.tail.compareExchange(
+          expected: tail,
+          desired: first,
+          ordering: .acquiringAndReleasing)
+      }
+      if self.head.compareExchange(
+        expected: head,
+        desired: first,
+        ordering: .acquiringAndReleasing
+      ).exchanged {
+        let result = first.value!
+        first.value = nil
+        head.next.store(marker, ordering: .releasing)
+        return result
+      }
+    }
+  }
+}
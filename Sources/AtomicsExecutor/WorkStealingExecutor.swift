@@ -0,0 +1,330 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import _AtomicsShims
+import Atomics
+
+// Each worker owns a work-stealing deque. Tasks submitted by a worker go to
+// the bottom of its own deque; tasks submitted by other threads go through
+// a shared injector queue. Idle workers look for work in their own deque,
+// then in the injector, then try to steal half of another worker's deque.
+//
+// Workers that find nothing to do park on an atomic wait. Parking follows
+// the usual store-fence-load handshake:
+//
+//   - a submitter makes the task visible, issues a sequentially consistent
+//     fence, then checks the number of sleeping workers; only if there are
+//     any does it bump `epoch` and wake one of them;
+//   - a parking worker increments the number of sleepers, issues a fence,
+//     loads `epoch`, checks for work one last time, then waits for `epoch`
+//     to change.
+//
+// Either the submitter sees the sleeper, or the sleeper sees the task, so
+// wake-ups can't get lost, and submitting a task to a busy executor costs
+// no read-modify-write operations beyond the queue operation itself.
+
+/// A fixed-size pool of worker threads that run tasks, balancing the load
+/// by work stealing.
+///
+///     let executor = WorkStealingExecutor()
+///     let task = executor.spawn { expensiveComputation() }
+///     executor.execute { print("Hello") }
+///     print(task.join())
+///
+/// Tasks may spawn other tasks; these are run by the same worker (most
+/// recent first) unless other workers steal them. Idle workers sleep on an
+/// atomic wait (a futex on Linux) rather than a condition variable.
+public final class WorkStealingExecutor {
+  /// The number of worker threads.
+  public let workerCount: Int
+
+  private let _state: _ExecutorState
+  private var _threads: [_ThreadHandle] = []
+
+  /// Creates an executor and starts its worker threads.
+  ///
+  /// - Parameter workerCount: The number of worker threads. The default is
+  ///   the number of online processors.
+  public init(workerCount: Int? = nil) {
+    let count = workerCount ?? Int(_sa_processor_count())
+    precondition(count > 0, "Invalid worker count")
+    self.workerCount = count
+    self._state = _ExecutorState(workerCount: count)
+    for worker in _state.workers {
+      _threads.append(_spawn(worker))
+    }
+  }
+
+  deinit {
+    if let worker = _ExecutorState.currentWorker, worker.state === _state {
+      // The last reference was released by one of our own tasks, so we
+      // can't wait for the workers to exit.
+      _state.requestShutdown()
+      _threads.forEach(_detach)
+    } else {
+      shutdown()
+    }
+  }
+
+  /// Submits a task for execution.
+  public func execute(_ body: @escaping () -> Void) {
+    _state.submit(_Job(body))
+  }
+
+  /// Submits a task for execution, and returns a handle that can be used to
+  /// wait for its result.
+  @discardableResult
+  public func spawn<Result>(
+    _ body: @escaping () -> Result
+  ) -> TaskHandle<Result> {
+    let handle = TaskHandle<Result>(_state)
+    _state.submit(_Job { handle._complete(body()) })
+    return handle
+  }
+
+  /// Runs the tasks that have already been submitted, then stops the
+  /// worker threads and waits for them to exit.
+  ///
+  /// This must not be called from a task.
+  public func shutdown() {
+    precondition(
+      _ExecutorState.currentWorker?.state !== _state,
+      "Can't shut down an executor from one of its own tasks")
+    guard !_threads.isEmpty else { return }
+    _state.requestShutdown()
+    _threads.forEach(_join)
+    _threads.removeAll()
+  }
+}
+
+/// A handle for the result of a task spawned on a `WorkStealingExecutor`.
+public final class TaskHandle<Result> {
+  private static var _running: UInt32 { 0 }
+  private static var _waiting: UInt32 { 1 }
+  private static var _finished: UInt32 { 2 }
+
+  private let _executor: _ExecutorState
+  private let _status = ManagedAtomic<UInt32>(0)
+  private var _result: Result?
+
+  internal init(_ executor: _ExecutorState) {
+    self._executor = executor
+  }
+
+  internal func _complete(_ result: Result) {
+    _result = result
+    let old = _status.exchange(TaskHandle._finished, ordering: .releasing)
+    if old == TaskHandle._waiting {
+      _status.wakeAll()
+    }
+  }
+
+  /// Returns true if the task has finished.
+  public var isFinished: Bool {
+    _status.load(ordering: .acquiring) == TaskHandle._finished
+  }
+
+  /// Waits for the task to finish, and returns its result.
+  ///
+  /// If this is called from a task of the same executor, the calling worker
+  /// runs other tasks while it waits.
+  public func join() -> Result {
+    if let worker = _ExecutorState.currentWorker, worker.state === _executor {
+      while !isFinished {
+        if let job = worker.findJob() {
+          job.run()
+        } else {
+          _waitForCompletion(timeoutNanoseconds: 100_000)
+        }
+      }
+    } else {
+      while !isFinished {
+        _waitForCompletion(timeoutNanoseconds: nil)
+      }
+    }
+    return _result!
+  }
+
+  private func _waitForCompletion(timeoutNanoseconds: Int?) {
+    let status = _status.compareExchange(
+      expected: TaskHandle._running,
+      desired: TaskHandle._waiting,
+      ordering: .acquiring
+    ).original
+    guard status != TaskHandle._finished else { return }
+    _status.wait(
+      whileEqualTo: TaskHandle._waiting,
+      timeoutNanoseconds: timeoutNanoseconds)
+  }
+}
+
+internal final class _Job {
+  let body: () -> Void
+
+  init(_ body: @escaping () -> Void) {
+    self.body = body
+  }
+
+  func run() {
+    body()
+  }
+}
+
+internal final class _ExecutorState {
+  var workers: [_Worker] = []
+  let injector = _InjectorQueue<_Job>()
+  let epoch = ManagedAtomic<UInt32>(0)
+  let sleepers = ManagedAtomic<Int>(0)
+  let isShuttingDown = ManagedAtomic<Bool>(false)
+  let liveWorkers: ManagedAtomic<Int>
+
+  init(workerCount: Int) {
+    liveWorkers = ManagedAtomic(workerCount)
+    workers = (0 ..< workerCount).map { _Worker(state: self, index: $0) }
+  }
+
+  static var currentWorker: _Worker? {
+    _ThreadLocalRegistry.entry(_CurrentWorker.self)?.worker
+  }
+
+  func submit(_ job: _Job) {
+    if let worker = _ExecutorState.currentWorker, worker.state === self {
+      worker.deque.push(job)
+    } else {
+      injector.enqueue(job)
+    }
+    notify()
+  }
+
+  /// Wakes up a sleeping worker, if there is one, after making new work
+  /// visible.
+  func notify() {
+    atomicMemoryFence(ordering: .sequentiallyConsistent)
+    if sleepers.load(ordering: .relaxed) > 0 {
+      epoch.wrappingIncrement(ordering: .sequentiallyConsistent)
+      epoch.wake(count: 1)
+    }
+  }
+
+  func requestShutdown() {
+    isShuttingDown.store(true, ordering: .sequentiallyConsistent)
+    epoch.wrappingIncrement(ordering: .sequentiallyConsistent)
+    epoch.wakeAll()
+  }
+
+  var hasWork: Bool {
+    !injector.isEmpty || workers.contains { !$0.deque.isEmpty }
+  }
+}
+
+internal final class _Worker {
+  let state: _ExecutorState
+  let index: Int
+  let deque = WorkStealingDeque<_Job>()
+
+  init(state: _ExecutorState, index: Int) {
+    self.state = state
+    self.index = index
+  }
+
+  func findJob() -> _Job? {
+    if let job = deque.pop() {
+      return job
+    }
+    if let job = state.injector.dequeue() {
+      // There may be more where this came from.
+      state.notify()
+      return job
+    }
+    let workers = state.workers
+    for offset in 1 ..< Swift.max(1, workers.count) {
+      let victim = workers[(index + offset) % workers.count]
+      if let job = victim.deque.steal(maxCount: 32, into: deque) {
+        if !deque.isEmpty { state.notify() }
+        return job
+      }
+    }
+    return nil
+  }
+
+  func run() {
+    _ = _ThreadLocalRegistry.entry(
+      _CurrentWorker.self,
+      orInsert: { _CurrentWorker(self) })
+    while true {
+      if let job = findJob() {
+        job.run()
+        continue
+      }
+      if state.isShuttingDown.load(ordering: .acquiring) {
+        // Submissions that happened before the shutdown are visible now.
+        if let job = findJob() {
+          job.run()
+          continue
+        }
+        break
+      }
+      park()
+    }
+    _ThreadLocalRegistry.removeEntry(_CurrentWorker.self)
+    if state.liveWorkers.wrappingDecrementThenLoad(
+      ordering: .acquiringAndReleasing
+    ) == 0 {
+      // Break the reference cycle between the state and its workers.
+      state.workers.removeAll()
+    }
+  }
+
+  private func park() {
+    state.sleepers.wrappingIncrement(ordering: .sequentiallyConsistent)
+    atomicMemoryFence(ordering: .sequentiallyConsistent)
+    let epoch = state.epoch.load(ordering: .sequentiallyConsistent)
+    if !state.hasWork && !state.isShuttingDown.load(ordering: .relaxed) {
+      state.epoch.wait(whileEqualTo: epoch)
+    }
+    state.sleepers.wrappingDecrement(ordering: .relaxed)
+  }
+}
+
+/// Identifies the worker that runs on the current thread, in its
+/// per-thread registry.
+private final class _CurrentWorker: _ThreadLocalEntry {
+  let worker: _Worker
+
+  init(_ worker: _Worker) {
+    self.worker = worker
+  }
+
+  func threadDidExit() {}
+}
+
+private typealias _ThreadHandle = OpaquePointer
+
+private func _runWorker(_ context: UnsafeMutableRawPointer?) {
+  Unmanaged<_Worker>.fromOpaque(context!).takeRetainedValue().run()
+}
+
+private func _spawn(_ worker: _Worker) -> _ThreadHandle {
+  let context = Unmanaged.passRetained(worker).toOpaque()
+  guard let handle = _sa_thread_create({ _runWorker($0) }, context) else {
+    preconditionFailure("Cannot create worker thread")
+  }
+  return handle
+}
+
+private func _join(_ handle: _ThreadHandle) {
+  _sa_thread_join(handle)
+}
+
+private func _detach(_ handle: _ThreadHandle) {
+  _sa_thread_detach(handle)
+}
@@ -59,17 +59,21 @@
 #include <stdatomic.h>
 #include <assert.h>
 
-// For now, assume double-wide atomics are available everywhere,
-// except on Linux/x86_64, where they need to be manually enabled
-// by the `cx16` target attribute. (Unfortunately we cannot currently
-// turn that on in our package description.)
+// For now, assume double-wide atomics are available everywhere.
+//
+// On Linux/x86_64, `cmpxchg16b` needs to be manually enabled by the `cx16`
+// target attribute, which we cannot currently turn on in our package
+// description. When it isn't enabled, double-wide operations are dispatched
+// to out-of-line shims that are compiled with that attribute, and the CPU is
+// checked for `cmpxchg16b` support at runtime.
 #ifdef __APPLE__
 #  define ENABLE_DOUBLEWIDE_ATOMICS 1
 #elif defined(_WIN32)
 #  define ENABLE_DOUBLEWIDE_ATOMICS 1
 #elif defined(__linux__)
-#  if !defined(__x86_64__) || defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
-#    define ENABLE_DOUBLEWIDE_ATOMICS 1
+#  define ENABLE_DOUBLEWIDE_ATOMICS 1
+#  if defined(__x86_64__) && !defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+#    define SWIFTATOMIC_DWORD_RUNTIME_CX16 1
 #  endif
 #endif
 
@@ -88,6 +92,60 @@ SWIFTATOMIC_THREAD_FENCE_FN(release)
 SWIFTATOMIC_THREAD_FENCE_FN(acq_rel)
 SWIFTATOMIC_THREAD_FENCE_FN(seq_cst)
 
+// ARMv8.1 LSE atomics
+//
+// Unless the target architecture includes the Large System Extensions,
+// read-modify-write operations on AArch64 compile into load-exclusive /
+// store-exclusive loops, which degrade badly under contention. On Linux, we
+// detect LSE support once, at runtime (via `getauxval`), and dispatch
+// exchanges, compare-exchanges and integer operations to out-of-line variants
+// that are compiled with LSE enabled (using single `swp`, `cas`, `casp` and
+// `ld<op>` instructions). These variants are defined in _AtomicsShims.c by
+// expanding the definitions below with `SWIFTATOMIC_LSE_IMPLEMENTATION` set.
+// Define `SWIFTATOMIC_DISABLE_LSE_DISPATCH` to always use the inline
+// implementations (e.g., for benchmarking).
+#if defined(__linux__) && defined(__aarch64__) \
+  && !defined(__ARM_FEATURE_ATOMICS) \
+  && !defined(SWIFTATOMIC_DISABLE_LSE_DISPATCH)
+#  define SWIFTATOMIC_LSE_DISPATCH 1
+#endif
+
+#if SWIFTATOMIC_LSE_DISPATCH
+// 0: not yet detected; 1: unavailable; 2: available
+extern int _sa_lse_state;
+extern int _sa_detect_lse(void);
+
+SWIFTATOMIC_INLINE
+bool _sa_has_lse(void)
+{
+  int state = __atomic_load_n(&_sa_lse_state, __ATOMIC_RELAXED);
+  if (__builtin_expect(state == 0, 0)) {
+    state = _sa_detect_lse();
+  }
+  return state == 2;
+}
+
+#  if defined(SWIFTATOMIC_LSE_IMPLEMENTATION)
+#    if defined(__clang__)
+#      define SWIFTATOMIC_LSE_TARGET __attribute__((target("lse")))
+#    else
+#      define SWIFTATOMIC_LSE_TARGET __attribute__((target("+lse")))
+#    endif
+#    define SWIFTATOMIC_LSE_FN(signature, body)                        \
+  SWIFTATOMIC_LSE_TARGET signature { body }
+#  else
+#    define SWIFTATOMIC_LSE_FN(signature, body)                        \
+  extern signature;
+#  endif
+#  define SWIFTATOMIC_LSE_DISPATCH_TO(call)                            \
+  if (_sa_has_lse()) {                                                  \
+    return call;                                                        \
+  }
+#else
+#  define SWIFTATOMIC_LSE_FN(signature, body)
+#  define SWIFTATOMIC_LSE_DISPATCH_TO(call)
+#endif // SWIFTATOMIC_LSE_DISPATCH
+
 // Definition of an atomic storage type.
 #define SWIFTATOMIC_STORAGE_TYPE(swiftType, cType, storageType)         \
   typedef struct {                                                      \
@@ -137,37 +195,57 @@ SWIFTATOMIC_THREAD_FENCE_FN(seq_cst)
   }
 
 // Atomic exchange
+#define SWIFTATOMIC_EXCHANGE_BODY(swiftType, order)                     \
+  return SWIFTATOMIC_DECODE_##swiftType(                                \
+    atomic_exchange_explicit(                                           \
+      &ptr->value,                                                      \
+      SWIFTATOMIC_ENCODE_##swiftType(desired),                          \
+      memory_order_##order));
+
 #define SWIFTATOMIC_EXCHANGE_FN(swiftType, cType, storageType, order)   \
+  SWIFTATOMIC_LSE_FN(                                                   \
+    cType _sa_lse_exchange_##order##_##swiftType(                       \
+      _sa_##swiftType *ptr,                                             \
+      cType desired),                                                   \
+    SWIFTATOMIC_EXCHANGE_BODY(swiftType, order))                        \
   SWIFTATOMIC_INLINE                                                    \
   cType _sa_exchange_##order##_##swiftType(                             \
     _sa_##swiftType *ptr,                                               \
     cType desired)                                                      \
   {                                                                     \
-    return SWIFTATOMIC_DECODE_##swiftType(                              \
-      atomic_exchange_explicit(                                         \
-        &ptr->value,                                                    \
-        SWIFTATOMIC_ENCODE_##swiftType(desired),                        \
-        memory_order_##order));                                         \
+    SWIFTATOMIC_LSE_DISPATCH_TO(                                        \
+      _sa_lse_exchange_##order##_##swiftType(ptr, desired))             \
+    SWIFTATOMIC_EXCHANGE_BODY(swiftType, order)                         \
   }
 
 // Atomic compare/exchange
-#define SWIFTATOMIC_CMPXCHG_FN_SIMPLE(_kind, swiftType, cType, storageType, succ, fail) \
-  SWIFTATOMIC_INLINE                                                    \
-  bool                                                                  \
-  _sa_cmpxchg_##_kind##_##succ##_##fail##_##swiftType(                  \
-    _sa_##swiftType *ptr,                                               \
-    cType *expected,                                                    \
-    cType desired)                                                      \
-  {                                                                     \
-    return atomic_compare_exchange_##_kind##_explicit(                  \
+#define SWIFTATOMIC_CMPXCHG_BODY_SIMPLE(_kind, swiftType, storageType, succ, fail) \
+  return atomic_compare_exchange_##_kind##_explicit(                    \
+    &ptr->value,                                                        \
+    expected,                                                           \
+    desired,                                                            \
+    memory_order_##succ,                                                \
+    memory_order_##fail);
+
+#define SWIFTATOMIC_CMPXCHG_BODY_COMPLEX(_kind, swiftType, storageType, succ, fail) \
+  storageType _expected = SWIFTATOMIC_ENCODE_##swiftType(*expected);    \
+  bool result = atomic_compare_exchange_##_kind##_explicit(             \
       &ptr->value,                                                      \
-      expected,                                                         \
-      desired,                                                          \
+      &_expected,                                                       \
+      SWIFTATOMIC_ENCODE_##swiftType(desired),                          \
       memory_order_##succ,                                              \
       memory_order_##fail);                                             \
-  }
+  *expected = SWIFTATOMIC_DECODE_##swiftType(_expected);                \
+  return result;
 
-#define SWIFTATOMIC_CMPXCHG_FN_COMPLEX(_kind, swiftType, cType, storageType, succ, fail) \
+#define SWIFTATOMIC_CMPXCHG_FN(variant, _kind, swiftType, cType, storageType, succ, fail) \
+  SWIFTATOMIC_LSE_FN(                                                   \
+    bool                                                                \
+    _sa_lse_cmpxchg_##_kind##_##succ##_##fail##_##swiftType(            \
+      _sa_##swiftType *ptr,                                             \
+      cType *expected,                                                  \
+      cType desired),                                                   \
+    SWIFTATOMIC_CMPXCHG_BODY_##variant(_kind, swiftType, storageType, succ, fail)) \
   SWIFTATOMIC_INLINE                                                    \
   bool                                                                  \
   _sa_cmpxchg_##_kind##_##succ##_##fail##_##swiftType(                  \
@@ -175,30 +253,35 @@ SWIFTATOMIC_THREAD_FENCE_FN(seq_cst)
     cType *expected,                                                    \
     cType desired)                                                      \
   {                                                                     \
-    storageType _expected = SWIFTATOMIC_ENCODE_##swiftType(*expected);  \
-    bool result = atomic_compare_exchange_##_kind##_explicit(           \
-        &ptr->value,                                                    \
-        &_expected,                                                     \
-        SWIFTATOMIC_ENCODE_##swiftType(desired),                        \
-        memory_order_##succ,                                            \
-        memory_order_##fail);                                           \
-    *expected = SWIFTATOMIC_DECODE_##swiftType(_expected);              \
-    return result;                                                      \
+    SWIFTATOMIC_LSE_DISPATCH_TO(                                        \
+      _sa_lse_cmpxchg_##_kind##_##succ##_##fail##_##swiftType(          \
+        ptr, expected, desired))                                        \
+    SWIFTATOMIC_CMPXCHG_BODY_##variant(_kind, swiftType, storageType, succ, fail) \
   }
 
 // Atomic integer operations
+#define SWIFTATOMIC_INTEGER_BODY(op, swiftType, order)                  \
+  return SWIFTATOMIC_DECODE_##swiftType(                                \
+    atomic_fetch_##op##_explicit(                                       \
+      &ptr->value,                                                      \
+      SWIFTATOMIC_ENCODE_##swiftType(operand),                          \
+      memory_order_##order));
+
 #define SWIFTATOMIC_INTEGER_FN(op, swiftType, cType, storageType, order) \
+  SWIFTATOMIC_LSE_FN(                                                   \
+    cType _sa_lse_fetch_##op##_##order##_##swiftType(                   \
+      _sa_##swiftType *ptr,                                             \
+      cType operand),                                                   \
+    SWIFTATOMIC_INTEGER_BODY(op, swiftType, order))                     \
   SWIFTATOMIC_INLINE                                                    \
   cType _sa_fetch_##op##_##order##_##swiftType(                         \
     _sa_##swiftType *ptr,                                               \
     cType operand)                                                      \
   {                                                                     \
-    return SWIFTATOMIC_DECODE_##swiftType(                              \
-      atomic_fetch_##op##_explicit(                                     \
-        &ptr->value,                                                    \
-        SWIFTATOMIC_ENCODE_##swiftType(operand),                        \
-        memory_order_##order));                                         \
-    }
+    SWIFTATOMIC_LSE_DISPATCH_TO(                                        \
+      _sa_lse_fetch_##op##_##order##_##swiftType(ptr, operand))         \
+    SWIFTATOMIC_INTEGER_BODY(op, swiftType, order)                      \
+  }
 
 // Functions for each supported operation + memory ordering combination
 #define SWIFTATOMIC_STORE_FNS(swiftType, cType, storageType)           \
@@ -219,15 +302,15 @@ SWIFTATOMIC_THREAD_FENCE_FN(seq_cst)
   SWIFTATOMIC_EXCHANGE_FN(swiftType, cType, storageType, seq_cst)
 
 #define SWIFTATOMIC_CMPXCHG_FNS(variant, kind, swiftType, cType, storageType) \
-  SWIFTATOMIC_CMPXCHG_FN_##variant(kind, swiftType, cType, storageType, relaxed, relaxed) \
-  SWIFTATOMIC_CMPXCHG_FN_##variant(kind, swiftType, cType, storageType, acquire, relaxed) \
-  SWIFTATOMIC_CMPXCHG_FN_##variant(kind, swiftType, cType, storageType, release, relaxed) \
-  SWIFTATOMIC_CMPXCHG_FN_##variant(kind, swiftType, cType, storageType, acq_rel, relaxed) \
-  SWIFTATOMIC_CMPXCHG_FN_##variant(kind, swiftType, cType, storageType, seq_cst, relaxed) \
-  SWIFTATOMIC_CMPXCHG_FN_##variant(kind, swiftType, cType, storageType, acquire, acquire) \
-  SWIFTATOMIC_CMPXCHG_FN_##variant(kind, swiftType, cType, storageType, acq_rel, acquire) \
-  SWIFTATOMIC_CMPXCHG_FN_##variant(kind, swiftType, cType, storageType, seq_cst, acquire) \
-  SWIFTATOMIC_CMPXCHG_FN_##variant(kind, swiftType, cType, storageType, seq_cst, seq_cst)
+  SWIFTATOMIC_CMPXCHG_FN(variant, kind, swiftType, cType, storageType, relaxed, relaxed) \
+  SWIFTATOMIC_CMPXCHG_FN(variant, kind, swiftType, cType, storageType, acquire, relaxed) \
+  SWIFTATOMIC_CMPXCHG_FN(variant, kind, swiftType, cType, storageType, release, relaxed) \
+  SWIFTATOMIC_CMPXCHG_FN(variant, kind, swiftType, cType, storageType, acq_rel, relaxed) \
+  SWIFTATOMIC_CMPXCHG_FN(variant, kind, swiftType, cType, storageType, seq_cst, relaxed) \
+  SWIFTATOMIC_CMPXCHG_FN(variant, kind, swiftType, cType, storageType, acquire, acquire) \
+  SWIFTATOMIC_CMPXCHG_FN(variant, kind, swiftType, cType, storageType, acq_rel, acquire) \
+  SWIFTATOMIC_CMPXCHG_FN(variant, kind, swiftType, cType, storageType, seq_cst, acquire) \
+  SWIFTATOMIC_CMPXCHG_FN(variant, kind, swiftType, cType, storageType, seq_cst, seq_cst)
 
 #define SWIFTATOMIC_INTEGER_FNS(op, swiftType, cType, storageType)     \
   SWIFTATOMIC_INTEGER_FN(op, swiftType, cType, storageType, relaxed)   \
@@ -340,13 +423,650 @@ _sa_dword _sa_decode_dword(__uint128_t value) {
   return (_sa_dword){ value };
 }
 
+SWIFTATOMIC_STORAGE_TYPE(DoubleWord, _sa_dword, _sa_double_word_ctype)
+
 #if ENABLE_DOUBLEWIDE_ATOMICS
-#define SWIFTATOMIC_ENCODE_DoubleWord(_value) (_value).value
-#define SWIFTATOMIC_DECODE_DoubleWord(_value) _sa_decode_dword(_value)
-SWIFTATOMIC_DEFINE_TYPE(COMPLEX, DoubleWord, _sa_dword, _sa_double_word_ctype)
+// Double-wide primitives
+//
+// All double-wide operations below are expressed in terms of these four
+// primitives. Normally they map directly to the standard C atomics. On
+// Linux/x86_64 builds that don't enable `cmpxchg16b` at compile time, they
+// call out-of-line shims that are compiled with the `cx16` target attribute
+// instead. The presence of `cmpxchg16b` is verified (once) when the first
+// double-wide storage value is prepared. `lock cmpxchg16b` is a full barrier,
+// so these shims satisfy every memory ordering. On Linux/AArch64, exchanges
+// and compare-exchanges are subject to LSE dispatch, like all other
+// read-modify-write operations.
+#if SWIFTATOMIC_DWORD_RUNTIME_CX16
+extern void _sa_dword_require_cx16(void);
+extern _sa_double_word_ctype _sa_dword_cx16_load(_sa_DoubleWord *ptr);
+extern _sa_double_word_ctype _sa_dword_cx16_exchange(
+  _sa_DoubleWord *ptr,
+  _sa_double_word_ctype desired);
+extern bool _sa_dword_cx16_cmpxchg(
+  _sa_DoubleWord *ptr,
+  _sa_double_word_ctype *expected,
+  _sa_double_word_ctype desired);
+
+#  define SWIFTATOMIC_DWORD_LOAD(ptr, order)                            \
+  _sa_dword_cx16_load(ptr)
+#  define SWIFTATOMIC_DWORD_STORE(ptr, _value, order)                   \
+  ((void)_sa_dword_cx16_exchange(ptr, _value))
+#  define SWIFTATOMIC_DWORD_EXCHANGE(ptr, _value, order)                \
+  _sa_dword_cx16_exchange(ptr, _value)
+#  define SWIFTATOMIC_DWORD_CMPXCHG(kind, ptr, expected, desired, succ, fail) \
+  _sa_dword_cx16_cmpxchg(ptr, expected, desired)
+#elif SWIFTATOMIC_LSE_DISPATCH
+// Exchanges and compare-exchanges dispatch to `casp`-based variants when LSE
+// is available.
+#  define SWIFTATOMIC_DWORD_EXCHANGE_BODY(order)                        \
+  return atomic_exchange_explicit(                                      \
+    &ptr->value, desired, memory_order_##order);
+
+#  define SWIFTATOMIC_DWORD_CMPXCHG_BODY(kind, succ, fail)              \
+  return atomic_compare_exchange_##kind##_explicit(                     \
+    &ptr->value, expected, desired,                                     \
+    memory_order_##succ, memory_order_##fail);
+
+#  define SWIFTATOMIC_DWORD_LSE_EXCHANGE_FN(order)                      \
+  SWIFTATOMIC_LSE_FN(                                                   \
+    _sa_double_word_ctype _sa_lse_dword_exchange_##order(               \
+      _sa_DoubleWord *ptr,                                              \
+      _sa_double_word_ctype desired),                                   \
+    SWIFTATOMIC_DWORD_EXCHANGE_BODY(order))                             \
+  SWIFTATOMIC_INLINE                                                    \
+  _sa_double_word_ctype _sa_dword_exchange_##order(                     \
+    _sa_DoubleWord *ptr,                                                \
+    _sa_double_word_ctype desired)                                      \
+  {                                                                     \
+    SWIFTATOMIC_LSE_DISPATCH_TO(                                        \
+      _sa_lse_dword_exchange_##order(ptr, desired))                     \
+    SWIFTATOMIC_DWORD_EXCHANGE_BODY(order)                              \
+  }
+
+#  define SWIFTATOMIC_DWORD_LSE_CMPXCHG_FN(kind, succ, fail)            \
+  SWIFTATOMIC_LSE_FN(                                                   \
+    bool _sa_lse_dword_cmpxchg_##kind##_##succ##_##fail(                \
+      _sa_DoubleWord *ptr,                                              \
+      _sa_double_word_ctype *expected,                                  \
+      _sa_double_word_ctype desired),                                   \
+    SWIFTATOMIC_DWORD_CMPXCHG_BODY(kind, succ, fail))                   \
+  SWIFTATOMIC_INLINE                                                    \
+  bool _sa_dword_cmpxchg_##kind##_##succ##_##fail(                      \
+    _sa_DoubleWord *ptr,                                                \
+    _sa_double_word_ctype *expected,                                    \
+    _sa_double_word_ctype desired)                                      \
+  {                                                                     \
+    SWIFTATOMIC_LSE_DISPATCH_TO(                                        \
+      _sa_lse_dword_cmpxchg_##kind##_##succ##_##fail(                   \
+        ptr, expected, desired))                                        \
+    SWIFTATOMIC_DWORD_CMPXCHG_BODY(kind, succ, fail)                    \
+  }
+
+#  define SWIFTATOMIC_DWORD_LSE_CMPXCHG_FNS(kind)                       \
+  SWIFTATOMIC_DWORD_LSE_CMPXCHG_FN(kind, relaxed, relaxed)              \
+  SWIFTATOMIC_DWORD_LSE_CMPXCHG_FN(kind, acquire, relaxed)              \
+  SWIFTATOMIC_DWORD_LSE_CMPXCHG_FN(kind, release, relaxed)              \
+  SWIFTATOMIC_DWORD_LSE_CMPXCHG_FN(kind, acq_rel, relaxed)              \
+  SWIFTATOMIC_DWORD_LSE_CMPXCHG_FN(kind, seq_cst, relaxed)              \
+  SWIFTATOMIC_DWORD_LSE_CMPXCHG_FN(kind, acquire, acquire)              \
+  SWIFTATOMIC_DWORD_LSE_CMPXCHG_FN(kind, acq_rel, acquire)              \
+  SWIFTATOMIC_DWORD_LSE_CMPXCHG_FN(kind, seq_cst, acquire)              \
+  SWIFTATOMIC_DWORD_LSE_CMPXCHG_FN(kind, seq_cst, seq_cst)
+
+SWIFTATOMIC_DWORD_LSE_EXCHANGE_FN(relaxed)
+SWIFTATOMIC_DWORD_LSE_EXCHANGE_FN(acquire)
+SWIFTATOMIC_DWORD_LSE_EXCHANGE_FN(release)
+SWIFTATOMIC_DWORD_LSE_EXCHANGE_FN(acq_rel)
+SWIFTATOMIC_DWORD_LSE_EXCHANGE_FN(seq_cst)
+SWIFTATOMIC_DWORD_LSE_CMPXCHG_FNS(strong)
+SWIFTATOMIC_DWORD_LSE_CMPXCHG_FNS(weak)
+
+#  define SWIFTATOMIC_DWORD_LOAD(ptr, order)                            \
+  atomic_load_explicit(&(ptr)->value, memory_order_##order)
+#  define SWIFTATOMIC_DWORD_STORE(ptr, _value, order)                   \
+  atomic_store_explicit(&(ptr)->value, _value, memory_order_##order)
+#  define SWIFTATOMIC_DWORD_EXCHANGE(ptr, _value, order)                \
+  _sa_dword_exchange_##order(ptr, _value)
+#  define SWIFTATOMIC_DWORD_CMPXCHG(kind, ptr, expected, desired, succ, fail) \
+  _sa_dword_cmpxchg_##kind##_##succ##_##fail(ptr, expected, desired)
 #else
-SWIFTATOMIC_STORAGE_TYPE(DoubleWord, _sa_dword, _sa_double_word_ctype)
+#  define SWIFTATOMIC_DWORD_LOAD(ptr, order)                            \
+  atomic_load_explicit(&(ptr)->value, memory_order_##order)
+#  define SWIFTATOMIC_DWORD_STORE(ptr, _value, order)                   \
+  atomic_store_explicit(&(ptr)->value, _value, memory_order_##order)
+#  define SWIFTATOMIC_DWORD_EXCHANGE(ptr, _value, order)                \
+  atomic_exchange_explicit(&(ptr)->value, _value, memory_order_##order)
+#  define SWIFTATOMIC_DWORD_CMPXCHG(kind, ptr, expected, desired, succ, fail) \
+  atomic_compare_exchange_##kind##_explicit(                            \
+    &(ptr)->value, expected, desired,                                   \
+    memory_order_##succ, memory_order_##fail)
+#endif // SWIFTATOMIC_DWORD_RUNTIME_CX16
+
+SWIFTATOMIC_INLINE
+_sa_DoubleWord _sa_prepare_DoubleWord(_sa_dword value)
+{
+  _sa_DoubleWord storage = { value.value };
+#if SWIFTATOMIC_DWORD_RUNTIME_CX16
+  _sa_dword_require_cx16();
+#else
+  assert(atomic_is_lock_free(&storage.value));
 #endif
+  return storage;
+}
+
+SWIFTATOMIC_INLINE
+_sa_dword _sa_dispose_DoubleWord(_sa_DoubleWord storage)
+{
+  // Disposal isn't an atomic access, so read the value directly.
+  return _sa_decode_dword(*(_sa_double_word_ctype *)&storage.value);
+}
+#endif // ENABLE_DOUBLEWIDE_ATOMICS
+
+// Double-wide loads and stores
+//
+// Standard C implements double-wide atomic loads and stores using
+// compare-exchange instructions (e.g., `lock cmpxchg16b` on x86_64). This
+// means that even loads need exclusive access to the cache line, which scales
+// badly for read-mostly values. However, plain double-wide loads and stores
+// are guaranteed to be atomic on some CPUs:
+//
+// - On x86_64, Intel, AMD and Zhaoxin processors that enumerate support
+//   for AVX guarantee that aligned 16-byte SSE/AVX memory operations are
+//   atomic. (Other vendors make no such promise, so we check the vendor
+//   string too, like libatomic.)
+// - On ARMv8.4 and later (FEAT_LSE2, reported as `HWCAP_USCAT` on Linux),
+//   aligned `ldp`/`stp` instructions are single-copy atomic.
+//
+// On these platforms, we detect these capabilities once, at runtime, and use
+// plain instructions when available. Define
+// `SWIFTATOMIC_DISABLE_PLAIN_DOUBLEWIDE_ACCESS` to always use the standard C
+// implementations (e.g., for benchmarking).
+#if ENABLE_DOUBLEWIDE_ATOMICS && !defined(SWIFTATOMIC_DISABLE_PLAIN_DOUBLEWIDE_ACCESS)
+#  if defined(__x86_64__)
+#    define SWIFTATOMIC_PLAIN_DOUBLEWIDE_ACCESS 1
+#  elif defined(__linux__) && defined(__aarch64__) && defined(__AARCH64EL__)
+#    define SWIFTATOMIC_PLAIN_DOUBLEWIDE_ACCESS 1
+#  endif
+#endif
+
+#if SWIFTATOMIC_PLAIN_DOUBLEWIDE_ACCESS
+// 0: not yet detected; 1: unavailable; 2: available
+extern int _sa_dword_plain_access_state;
+extern int _sa_dword_detect_plain_access(void);
+
+SWIFTATOMIC_INLINE
+bool _sa_dword_has_plain_access(void)
+{
+  int state = __atomic_load_n(&_sa_dword_plain_access_state, __ATOMIC_RELAXED);
+  if (__builtin_expect(state == 0, 0)) {
+    state = _sa_dword_detect_plain_access();
+  }
+  return state == 2;
+}
+
+#  if defined(__x86_64__)
+// x86_64 is strongly ordered, so plain loads are acquiring and plain stores
+// are releasing. Sequentially consistent stores need a trailing full fence;
+// sequentially consistent loads can then be plain loads.
+#    define SWIFTATOMIC_DWORD_PLAIN_SEQ_CST 1
+#    define SWIFTATOMIC_DWORD_PLAIN_LOAD_FN(order, fence)               \
+  SWIFTATOMIC_INLINE                                                    \
+  _sa_double_word_ctype _sa_dword_plain_load_##order(                   \
+    _sa_DoubleWord *ptr)                                                \
+  {                                                                     \
+    uint64_t low, high;                                                 \
+    __asm__ __volatile__(                                               \
+      "movdqa %2, %%xmm0\n\t"                                           \
+      "movq %%xmm0, %0\n\t"                                             \
+      "punpckhqdq %%xmm0, %%xmm0\n\t"                                   \
+      "movq %%xmm0, %1"                                                 \
+      fence                                                             \
+      : "=r"(low), "=r"(high)                                           \
+      : "m"(*(const _sa_double_word_ctype *)&ptr->value)                \
+      : "xmm0", "memory");                                              \
+    return ((_sa_double_word_ctype)high << 64) | low;                   \
+  }
+#    define SWIFTATOMIC_DWORD_PLAIN_STORE_FN(order, fence)              \
+  SWIFTATOMIC_INLINE                                                    \
+  void _sa_dword_plain_store_##order(                                   \
+    _sa_DoubleWord *ptr,                                                \
+    _sa_double_word_ctype value)                                        \
+  {                                                                     \
+    __asm__ __volatile__(                                               \
+      "movq %1, %%xmm0\n\t"                                             \
+      "movq %2, %%xmm1\n\t"                                             \
+      "punpcklqdq %%xmm1, %%xmm0\n\t"                                   \
+      "movdqa %%xmm0, %0"                                               \
+      fence                                                             \
+      : "=m"(*(_sa_double_word_ctype *)&ptr->value)                     \
+      : "r"((uint64_t)value), "r"((uint64_t)(value >> 64))              \
+      : "xmm0", "xmm1", "memory");                                      \
+  }
+SWIFTATOMIC_DWORD_PLAIN_LOAD_FN(relaxed, "")
+SWIFTATOMIC_DWORD_PLAIN_LOAD_FN(acquire, "")
+SWIFTATOMIC_DWORD_PLAIN_LOAD_FN(seq_cst, "")
+SWIFTATOMIC_DWORD_PLAIN_STORE_FN(relaxed, "")
+SWIFTATOMIC_DWORD_PLAIN_STORE_FN(release, "")
+SWIFTATOMIC_DWORD_PLAIN_STORE_FN(seq_cst, "\n\tmfence")
+#  elif defined(__aarch64__)
+// Sequentially consistent accesses keep using the standard implementation,
+// as it doesn't mix well with fence-based mappings.
+#    define SWIFTATOMIC_DWORD_PLAIN_SEQ_CST 0
+#    define SWIFTATOMIC_DWORD_PLAIN_LOAD_FN(order, fence)               \
+  SWIFTATOMIC_INLINE                                                    \
+  _sa_double_word_ctype _sa_dword_plain_load_##order(                   \
+    _sa_DoubleWord *ptr)                                                \
+  {                                                                     \
+    uint64_t low, high;                                                 \
+    __asm__ __volatile__(                                               \
+      "ldp %0, %1, %2"                                                  \
+      fence                                                             \
+      : "=&r"(low), "=&r"(high)                                         \
+      : "Q"(*(const _sa_double_word_ctype *)&ptr->value)                \
+      : "memory");                                                      \
+    return ((_sa_double_word_ctype)high << 64) | low;                   \
+  }
+#    define SWIFTATOMIC_DWORD_PLAIN_STORE_FN(order, fence)              \
+  SWIFTATOMIC_INLINE                                                    \
+  void _sa_dword_plain_store_##order(                                   \
+    _sa_DoubleWord *ptr,                                                \
+    _sa_double_word_ctype value)                                        \
+  {                                                                     \
+    __asm__ __volatile__(                                               \
+      fence                                                             \
+      "stp %1, %2, %0"                                                  \
+      : "=Q"(*(_sa_double_word_ctype *)&ptr->value)                     \
+      : "r"((uint64_t)value), "r"((uint64_t)(value >> 64))              \
+      : "memory");                                                      \
+  }
+SWIFTATOMIC_DWORD_PLAIN_LOAD_FN(relaxed, "")
+SWIFTATOMIC_DWORD_PLAIN_LOAD_FN(acquire, "\n\tdmb ishld")
+SWIFTATOMIC_DWORD_PLAIN_STORE_FN(relaxed, "")
+SWIFTATOMIC_DWORD_PLAIN_STORE_FN(release, "dmb ish\n\t")
+#  endif
+
+#  define SWIFTATOMIC_DWORD_TRY_PLAIN_LOAD(ptr, order)                 \
+  if (_sa_dword_has_plain_access()) {                                   \
+    return _sa_decode_dword(_sa_dword_plain_load_##order(ptr));         \
+  }
+#  define SWIFTATOMIC_DWORD_TRY_PLAIN_STORE(ptr, value, order)         \
+  if (_sa_dword_has_plain_access()) {                                   \
+    _sa_dword_plain_store_##order(ptr, value);                          \
+    return;                                                             \
+  }
+#else
+#  define SWIFTATOMIC_DWORD_TRY_PLAIN_LOAD(ptr, order)
+#  define SWIFTATOMIC_DWORD_TRY_PLAIN_STORE(ptr, value, order)
+#endif // SWIFTATOMIC_PLAIN_DOUBLEWIDE_ACCESS
+
+// Plain access isn't attempted for orderings that lack plain implementations.
+#define SWIFTATOMIC_DWORD_TRY_STANDARD_LOAD(ptr, order)
+#define SWIFTATOMIC_DWORD_TRY_STANDARD_STORE(ptr, value, order)
+
+#if ENABLE_DOUBLEWIDE_ATOMICS
+// Atomic load, using plain instructions when available
+#define SWIFTATOMIC_DWORD_LOAD_FN(order, access)                        \
+  SWIFTATOMIC_INLINE                                                    \
+  _sa_dword _sa_load_##order##_DoubleWord(_sa_DoubleWord *ptr)          \
+  {                                                                     \
+    SWIFTATOMIC_DWORD_TRY_##access##_LOAD(ptr, order)                   \
+    return _sa_decode_dword(SWIFTATOMIC_DWORD_LOAD(ptr, order));        \
+  }
+
+// Atomic store, using plain instructions when available
+#define SWIFTATOMIC_DWORD_STORE_FN(order, access)                       \
+  SWIFTATOMIC_INLINE                                                    \
+  void _sa_store_##order##_DoubleWord(                                  \
+    _sa_DoubleWord *ptr,                                                \
+    _sa_dword desired)                                                  \
+  {                                                                     \
+    SWIFTATOMIC_DWORD_TRY_##access##_STORE(ptr, desired.value, order)   \
+    SWIFTATOMIC_DWORD_STORE(ptr, desired.value, order);                 \
+  }
+
+// Atomic exchange
+#define SWIFTATOMIC_DWORD_EXCHANGE_FN(order)                            \
+  SWIFTATOMIC_INLINE                                                    \
+  _sa_dword _sa_exchange_##order##_DoubleWord(                          \
+    _sa_DoubleWord *ptr,                                                \
+    _sa_dword desired)                                                  \
+  {                                                                     \
+    return _sa_decode_dword(                                            \
+      SWIFTATOMIC_DWORD_EXCHANGE(ptr, desired.value, order));           \
+  }
+
+// Atomic compare/exchange
+#define SWIFTATOMIC_DWORD_CMPXCHG_FN(kind, succ, fail)                  \
+  SWIFTATOMIC_INLINE                                                    \
+  bool                                                                  \
+  _sa_cmpxchg_##kind##_##succ##_##fail##_DoubleWord(                    \
+    _sa_DoubleWord *ptr,                                                \
+    _sa_dword *expected,                                                \
+    _sa_dword desired)                                                  \
+  {                                                                     \
+    return SWIFTATOMIC_DWORD_CMPXCHG(                                   \
+      kind, ptr, &expected->value, desired.value, succ, fail);          \
+  }
+
+#define SWIFTATOMIC_DWORD_CMPXCHG_FNS(kind)                             \
+  SWIFTATOMIC_DWORD_CMPXCHG_FN(kind, relaxed, relaxed)                  \
+  SWIFTATOMIC_DWORD_CMPXCHG_FN(kind, acquire, relaxed)                  \
+  SWIFTATOMIC_DWORD_CMPXCHG_FN(kind, release, relaxed)                  \
+  SWIFTATOMIC_DWORD_CMPXCHG_FN(kind, acq_rel, relaxed)                  \
+  SWIFTATOMIC_DWORD_CMPXCHG_FN(kind, seq_cst, relaxed)                  \
+  SWIFTATOMIC_DWORD_CMPXCHG_FN(kind, acquire, acquire)                  \
+  SWIFTATOMIC_DWORD_CMPXCHG_FN(kind, acq_rel, acquire)                  \
+  SWIFTATOMIC_DWORD_CMPXCHG_FN(kind, seq_cst, acquire)                  \
+  SWIFTATOMIC_DWORD_CMPXCHG_FN(kind, seq_cst, seq_cst)
+
+SWIFTATOMIC_DWORD_LOAD_FN(relaxed, PLAIN)
+SWIFTATOMIC_DWORD_LOAD_FN(acquire, PLAIN)
+SWIFTATOMIC_DWORD_STORE_FN(relaxed, PLAIN)
+SWIFTATOMIC_DWORD_STORE_FN(release, PLAIN)
+#if SWIFTATOMIC_DWORD_PLAIN_SEQ_CST
+SWIFTATOMIC_DWORD_LOAD_FN(seq_cst, PLAIN)
+SWIFTATOMIC_DWORD_STORE_FN(seq_cst, PLAIN)
+#else
+SWIFTATOMIC_DWORD_LOAD_FN(seq_cst, STANDARD)
+SWIFTATOMIC_DWORD_STORE_FN(seq_cst, STANDARD)
+#endif
+SWIFTATOMIC_DWORD_EXCHANGE_FN(relaxed)
+SWIFTATOMIC_DWORD_EXCHANGE_FN(acquire)
+SWIFTATOMIC_DWORD_EXCHANGE_FN(release)
+SWIFTATOMIC_DWORD_EXCHANGE_FN(acq_rel)
+SWIFTATOMIC_DWORD_EXCHANGE_FN(seq_cst)
+SWIFTATOMIC_DWORD_CMPXCHG_FNS(strong)
+SWIFTATOMIC_DWORD_CMPXCHG_FNS(weak)
+#endif // ENABLE_DOUBLEWIDE_ATOMICS
+
+#if ENABLE_DOUBLEWIDE_ATOMICS
+// Operations on one half of a double word, leaving the other half intact.
+// These are implemented as compare-exchange loops here rather than in Swift
+// so that each iteration compiles down to a single double-wide
+// compare-exchange instruction without any repacking overhead.
+SWIFTATOMIC_INLINE
+uintptr_t _sa_dword_get_high(_sa_double_word_ctype value) {
+  return (uintptr_t)(value >> __INTPTR_WIDTH__);
+}
+
+SWIFTATOMIC_INLINE
+uintptr_t _sa_dword_get_low(_sa_double_word_ctype value) {
+  return (uintptr_t)value;
+}
+
+SWIFTATOMIC_INLINE
+_sa_double_word_ctype _sa_dword_set_high(
+  _sa_double_word_ctype value, uintptr_t high)
+{
+  return ((_sa_double_word_ctype)high << __INTPTR_WIDTH__)
+    | (_sa_double_word_ctype)_sa_dword_get_low(value);
+}
+
+SWIFTATOMIC_INLINE
+_sa_double_word_ctype _sa_dword_set_low(
+  _sa_double_word_ctype value, uintptr_t low)
+{
+  return ((_sa_double_word_ctype)_sa_dword_get_high(value) << __INTPTR_WIDTH__)
+    | (_sa_double_word_ctype)low;
+}
+
+// Atomic compare/exchange of one half
+#define SWIFTATOMIC_DWORD_CMPXCHG_HALF_FN(half, succ, fail)             \
+  SWIFTATOMIC_INLINE                                                    \
+  bool _sa_cmpxchg_##half##_##succ##_DoubleWord(                        \
+    _sa_DoubleWord *ptr,                                                \
+    _sa_dword *original,                                                \
+    uintptr_t expected,                                                 \
+    uintptr_t desired)                                                  \
+  {                                                                     \
+    _sa_double_word_ctype old = SWIFTATOMIC_DWORD_LOAD(ptr, fail);      \
+    while (_sa_dword_get_##half(old) == expected) {                     \
+      if (SWIFTATOMIC_DWORD_CMPXCHG(                                    \
+            weak, ptr, &old, _sa_dword_set_##half(old, desired),        \
+            succ, fail)) {                                              \
+        *original = _sa_decode_dword(old);                              \
+        return true;                                                    \
+      }                                                                 \
+    }                                                                   \
+    *original = _sa_decode_dword(old);                                  \
+    return false;                                                       \
+  }
+
+// Atomic wrapping add on one half
+#define SWIFTATOMIC_DWORD_FETCH_ADD_HALF_FN(half, order)                \
+  SWIFTATOMIC_INLINE                                                    \
+  _sa_dword _sa_fetch_add_##half##_##order##_DoubleWord(                \
+    _sa_DoubleWord *ptr,                                                \
+    uintptr_t operand)                                                  \
+  {                                                                     \
+    _sa_double_word_ctype old = SWIFTATOMIC_DWORD_LOAD(ptr, relaxed);   \
+    while (!SWIFTATOMIC_DWORD_CMPXCHG(                                  \
+             weak, ptr, &old,                                           \
+             _sa_dword_set_##half(old, _sa_dword_get_##half(old) + operand), \
+             order, relaxed)) {                                         \
+    }                                                                   \
+    return _sa_decode_dword(old);                                       \
+  }
+
+#define SWIFTATOMIC_DWORD_HALF_FNS(half)                                \
+  SWIFTATOMIC_DWORD_CMPXCHG_HALF_FN(half, relaxed, relaxed)             \
+  SWIFTATOMIC_DWORD_CMPXCHG_HALF_FN(half, acquire, acquire)             \
+  SWIFTATOMIC_DWORD_CMPXCHG_HALF_FN(half, release, relaxed)             \
+  SWIFTATOMIC_DWORD_CMPXCHG_HALF_FN(half, acq_rel, acquire)             \
+  SWIFTATOMIC_DWORD_CMPXCHG_HALF_FN(half, seq_cst, seq_cst)             \
+  SWIFTATOMIC_DWORD_FETCH_ADD_HALF_FN(half, relaxed)                    \
+  SWIFTATOMIC_DWORD_FETCH_ADD_HALF_FN(half, acquire)                    \
+  SWIFTATOMIC_DWORD_FETCH_ADD_HALF_FN(half, release)                    \
+  SWIFTATOMIC_DWORD_FETCH_ADD_HALF_FN(half, acq_rel)                    \
+  SWIFTATOMIC_DWORD_FETCH_ADD_HALF_FN(half, seq_cst)
+
+SWIFTATOMIC_DWORD_HALF_FNS(high)
+SWIFTATOMIC_DWORD_HALF_FNS(low)
+
+// Atomic integer operations on the full double word
+//
+// These treat the double word as a single unsigned integer, carrying across
+// the two halves. When double-wide operations map directly to the standard C
+// atomics, they use the standard `atomic_fetch_<op>` operations, which the
+// compiler expands inline (no current CPU implements these in a single
+// instruction). Otherwise, they're compare-exchange loops on the dispatched
+// primitives above, so that they keep using `cmpxchg16b` or `casp`.
+#if SWIFTATOMIC_DWORD_RUNTIME_CX16 || SWIFTATOMIC_LSE_DISPATCH
+#  define SWIFTATOMIC_DWORD_INTEGER_BODY(op, cop, order)                \
+  _sa_double_word_ctype old = SWIFTATOMIC_DWORD_LOAD(ptr, relaxed);     \
+  while (!SWIFTATOMIC_DWORD_CMPXCHG(                                    \
+           weak, ptr, &old, old cop operand.value, order, relaxed)) {   \
+  }                                                                     \
+  return _sa_decode_dword(old);
+#else
+#  define SWIFTATOMIC_DWORD_INTEGER_BODY(op, cop, order)                \
+  return _sa_decode_dword(                                              \
+    atomic_fetch_##op##_explicit(                                       \
+      &ptr->value, operand.value, memory_order_##order));
+#endif
+
+#define SWIFTATOMIC_DWORD_INTEGER_FN(op, cop, order)                    \
+  SWIFTATOMIC_INLINE                                                    \
+  _sa_dword _sa_fetch_##op##_##order##_DoubleWord(                      \
+    _sa_DoubleWord *ptr,                                                \
+    _sa_dword operand)                                                  \
+  {                                                                     \
+    SWIFTATOMIC_DWORD_INTEGER_BODY(op, cop, order)                      \
+  }
+
+#define SWIFTATOMIC_DWORD_INTEGER_FNS(op, cop)                          \
+  SWIFTATOMIC_DWORD_INTEGER_FN(op, cop, relaxed)                        \
+  SWIFTATOMIC_DWORD_INTEGER_FN(op, cop, acquire)                        \
+  SWIFTATOMIC_DWORD_INTEGER_FN(op, cop, release)                        \
+  SWIFTATOMIC_DWORD_INTEGER_FN(op, cop, acq_rel)                        \
+  SWIFTATOMIC_DWORD_INTEGER_FN(op, cop, seq_cst)
+
+SWIFTATOMIC_DWORD_INTEGER_FNS(add, +)
+SWIFTATOMIC_DWORD_INTEGER_FNS(sub, -)
+SWIFTATOMIC_DWORD_INTEGER_FNS(or, |)
+SWIFTATOMIC_DWORD_INTEGER_FNS(xor, ^)
+SWIFTATOMIC_DWORD_INTEGER_FNS(and, &)
+#endif
+
+// Contention profiler
+//
+// When enabled (with a nonzero sampling interval), one in every `interval`
+// exchange or compare-exchange operations on each thread gets timed using
+// the CPU's timestamp counter, and its latency is recorded in a histogram
+// associated with the address of the atomic value. The Swift side only
+// calls these in builds with the `ATOMICS_CONTENTION_PROFILING` condition.
+#define SWIFTATOMIC_PROFILER_LOCATIONS 256
+#define SWIFTATOMIC_PROFILER_BUCKETS 32
+
+extern uint32_t _sa_profiler_interval;
+extern _Thread_local uint32_t _sa_profiler_countdown;
+
+// Each call to `_sa_profiler_set_interval` bumps the epoch. Threads restart
+// their countdown when they notice, so that one left over from an earlier
+// (longer) interval doesn't delay the first samples.
+extern uint32_t _sa_profiler_epoch;
+extern _Thread_local uint32_t _sa_profiler_thread_epoch;
+
+SWIFTATOMIC_INLINE
+bool _sa_profiler_should_sample(void)
+{
+  uint32_t interval = __atomic_load_n(&_sa_profiler_interval, __ATOMIC_RELAXED);
+  if (__builtin_expect(interval == 0, 1)) {
+    return false;
+  }
+  uint32_t epoch = __atomic_load_n(&_sa_profiler_epoch, __ATOMIC_RELAXED);
+  if (__builtin_expect(_sa_profiler_thread_epoch != epoch, 0)) {
+    _sa_profiler_thread_epoch = epoch;
+    _sa_profiler_countdown = interval;
+  }
+  if (__builtin_expect(_sa_profiler_countdown > 1, 1)) {
+    _sa_profiler_countdown -= 1;
+    return false;
+  }
+  _sa_profiler_countdown = interval;
+  return true;
+}
+
+// Read the timestamp counter, after all preceding instructions have completed.
+SWIFTATOMIC_INLINE
+uint64_t _sa_profiler_timestamp(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  uint32_t low, high;
+  __asm__ __volatile__("lfence\n\trdtsc" : "=a"(low), "=d"(high) :: "memory");
+  return ((uint64_t)high << 32) | low;
+#elif defined(__aarch64__)
+  uint64_t value;
+  __asm__ __volatile__("isb\n\tmrs %0, cntvct_el0" : "=r"(value) :: "memory");
+  return value;
+#else
+  return 0;
+#endif
+}
+
+extern void _sa_profiler_set_interval(uint32_t interval);
+extern void _sa_profiler_record(const void *address, uint64_t ticks);
+extern void _sa_profiler_reset(void);
+extern const void *_sa_profiler_address(int location);
+extern uint64_t _sa_profiler_count(int location, int bucket);
+
+// Waiting and waking
+//
+// `_sa_wait` blocks the calling thread as long as the 32-bit value at
+// `address` equals `expected`, until `_sa_wake` is called on the same
+// address, or until `timeout` nanoseconds have passed (a negative timeout
+// waits indefinitely). It returns one of the `SWIFTATOMIC_WAIT_` results
+// below.
+//
+// On Linux, these are futex operations without FUTEX_PRIVATE_FLAG, so they
+// work across processes that map the same memory. On Windows, they use
+// `WaitOnAddress` and `WakeByAddress*`, which only work within a process.
+// Elsewhere, waiting falls back to polling with exponential backoff, and
+// waking does nothing.
+#define SWIFTATOMIC_WAIT_WOKEN 0
+#define SWIFTATOMIC_WAIT_VALUE_CHANGED 1
+#define SWIFTATOMIC_WAIT_TIMED_OUT 2
+
+extern int _sa_wait(const void *address, uint32_t expected, int64_t timeout);
+extern int _sa_wake(const void *address, int32_t count);
+
+// Threads
+//
+// Portable wrappers for the few thread services that the `Atomics` module
+// needs, so that it doesn't have to import any platform modules.
+//
+// `_sa_thread_id` returns a nonzero value that identifies the calling thread
+// among the threads that are currently running: the address of one of its
+// thread-local variables. `_sa_thread_yield` gives up the processor, and
+// `_sa_processor_count` returns the number of online processors.
+extern _Thread_local char _sa_thread_marker;
+
+SWIFTATOMIC_INLINE
+uintptr_t _sa_thread_id(void)
+{
+  return (uintptr_t)&_sa_thread_marker;
+}
+
+extern void _sa_thread_yield(void);
+extern int _sa_processor_count(void);
+
+// `_sa_thread_local_get` and `_sa_thread_local_set` access a single
+// package-wide pointer per thread. When a thread that set a non-null pointer
+// exits, the pointer is passed to `destructor` (which must be the same in
+// every call). This only uses one platform thread-specific data key for the
+// whole process. Only `_ThreadLocalRegistry` (in the `Atomics` module) calls
+// these; everything else that needs per-thread state registers an entry in
+// it instead.
+typedef void (*_sa_thread_local_destructor)(void *);
+
+extern _Thread_local void *_sa_thread_local_value;
+
+SWIFTATOMIC_INLINE
+void *_sa_thread_local_get(void)
+{
+  return _sa_thread_local_value;
+}
+
+extern void _sa_thread_local_set(
+  void *value,
+  _sa_thread_local_destructor destructor);
+
+// `_sa_thread_create` starts a new thread that calls `body(context)`, and
+// returns a handle for it, or NULL if the thread couldn't be created. Each
+// handle must be passed to exactly one of `_sa_thread_join`, which waits for
+// the thread to exit, and `_sa_thread_detach`, which lets it run on its own.
+typedef void (*_sa_thread_body)(void *);
+typedef struct _sa_thread _sa_thread;
+
+extern _sa_thread *_sa_thread_create(_sa_thread_body body, void *context);
+extern void _sa_thread_join(_sa_thread *thread);
+extern void _sa_thread_detach(_sa_thread *thread);
+
+// `_sa_lock` is a mutual exclusion lock with an associated condition, for
+// the diagnostic builds that need to block outside of atomic waits.
+// `_sa_lock_wait` must be called with the lock held; it releases the lock
+// while it waits for a `_sa_lock_broadcast` (or a spurious wake-up), then
+// reacquires it.
+typedef struct _sa_lock _sa_lock;
+
+extern _sa_lock *_sa_lock_create(void);
+extern void _sa_lock_destroy(_sa_lock *lock);
+extern void _sa_lock_acquire(_sa_lock *lock);
+extern void _sa_lock_release(_sa_lock *lock);
+extern void _sa_lock_wait(_sa_lock *lock);
+extern void _sa_lock_broadcast(_sa_lock *lock);
+
+// Call sites, for the model checker.
+//
+// `_sa_backtrace` stores the return addresses of up to `count` (at most 64)
+// stack frames in `frames`, starting with the frame of its caller, and
+// returns how many it stored. `_sa_symbol_name` returns the name of the
+// symbol that contains `address` and stores its start address in `start`,
+// or returns NULL if the name is unknown. Where the platform doesn't
+// support this, they return 0 and NULL.
+extern int _sa_backtrace(void **frames, int count);
+extern const char *_sa_symbol_name(const void *address, const void **start);
 
 #if ENABLE_DOUBLEWIDE_ATOMICS
 extern void _sa_retain_n(void *object, uint32_t n);
@@ -10,8 +10,660 @@
 //
 //===----------------------------------------------------------------------===//
 
+// `dladdr` (for `_sa_symbol_name`) is a GNU extension in glibc and musl.
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE 1
+#endif
+
+// Expand the out-of-line LSE variants of read-modify-write operations.
+#define SWIFTATOMIC_LSE_IMPLEMENTATION 1
 #include "_AtomicsShims.h"
 
+#if SWIFTATOMIC_LSE_DISPATCH
+#include <sys/auxv.h>
+#ifndef HWCAP_ATOMICS
+#  define HWCAP_ATOMICS (1 << 8)
+#endif
+
+int _sa_lse_state = 0;
+
+int _sa_detect_lse(void)
+{
+  bool available = (getauxval(AT_HWCAP) & HWCAP_ATOMICS) != 0;
+  int state = available ? 2 : 1;
+  __atomic_store_n(&_sa_lse_state, state, __ATOMIC_RELAXED);
+  return state;
+}
+#endif
+
+#if SWIFTATOMIC_PLAIN_DOUBLEWIDE_ACCESS
+#  if defined(__x86_64__)
+#    include <cpuid.h>
+#    ifndef signature_SHANGHAI_ebx
+#      define signature_SHANGHAI_ebx 0x68532020
+#      define signature_SHANGHAI_ecx 0x20206961
+#      define signature_SHANGHAI_edx 0x68676e61
+#    endif
+#  elif defined(__aarch64__)
+#    include <sys/auxv.h>
+#    ifndef HWCAP_USCAT
+#      define HWCAP_USCAT (1 << 25)
+#    endif
+#  endif
+
+int _sa_dword_plain_access_state = 0;
+
+int _sa_dword_detect_plain_access(void)
+{
+  bool available = false;
+#  if defined(__x86_64__)
+  // Only Intel, AMD and Zhaoxin document that aligned 16-byte SSE accesses
+  // are atomic on processors with AVX. Like libatomic, trust AVX as a
+  // signal on those vendors only; other vendors (and some hypervisors that
+  // report AVX) may split them.
+  unsigned int eax, ebx, ecx, edx;
+  if (__get_cpuid(0, &eax, &ebx, &ecx, &edx)) {
+    bool intelOrAMD =
+      (ebx == signature_INTEL_ebx && ecx == signature_INTEL_ecx
+        && edx == signature_INTEL_edx)
+      || (ebx == signature_AMD_ebx && ecx == signature_AMD_ecx
+        && edx == signature_AMD_edx);
+    bool zhaoxin =
+      (ebx == signature_CENTAUR_ebx && ecx == signature_CENTAUR_ecx
+        && edx == signature_CENTAUR_edx)
+      || (ebx == signature_SHANGHAI_ebx && ecx == signature_SHANGHAI_ecx
+        && edx == signature_SHANGHAI_edx);
+    if ((intelOrAMD || zhaoxin) && __get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+      unsigned int family = (eax >> 8) & 0xf;
+      available = (ecx & bit_AVX) != 0 && (intelOrAMD || family == 7);
+    }
+  }
+#  elif defined(__aarch64__)
+  available = (getauxval(AT_HWCAP) & HWCAP_USCAT) != 0;
+#  endif
+  int state = available ? 2 : 1;
+  __atomic_store_n(&_sa_dword_plain_access_state, state, __ATOMIC_RELAXED);
+  return state;
+}
+#endif
+
+#if SWIFTATOMIC_DWORD_RUNTIME_CX16
+#include <cpuid.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// 0: not yet checked; 1: available
+static int _sa_dword_cx16_state = 0;
+
+void _sa_dword_require_cx16(void)
+{
+  if (__builtin_expect(
+        __atomic_load_n(&_sa_dword_cx16_state, __ATOMIC_RELAXED) != 0, 1)) {
+    return;
+  }
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_CMPXCHG16B)) {
+    fputs("Fatal error: double-wide atomics require a CPU that "
+          "supports the cmpxchg16b instruction\n", stderr);
+    abort();
+  }
+  __atomic_store_n(&_sa_dword_cx16_state, 1, __ATOMIC_RELAXED);
+}
+
+// The `__sync` builtins are full barriers, and (unlike the C11 atomics) they
+// are lowered to `lock cmpxchg16b` whenever the enclosing function enables
+// the `cx16` target feature.
+
+__attribute__((target("cx16")))
+_sa_double_word_ctype _sa_dword_cx16_load(_sa_DoubleWord *ptr)
+{
+  // A compare-exchange that replaces zero with zero doesn't change anything,
+  // but it returns the current value.
+  _sa_double_word_ctype *value = (_sa_double_word_ctype *)&ptr->value;
+  return __sync_val_compare_and_swap(value, 0, 0);
+}
+
+__attribute__((target("cx16")))
+_sa_double_word_ctype _sa_dword_cx16_exchange(
+  _sa_DoubleWord *ptr,
+  _sa_double_word_ctype desired)
+{
+  _sa_double_word_ctype *value = (_sa_double_word_ctype *)&ptr->value;
+  _sa_double_word_ctype expected = 0;
+  while (1) {
+    _sa_double_word_ctype original =
+      __sync_val_compare_and_swap(value, expected, desired);
+    if (original == expected) return original;
+    expected = original;
+  }
+}
+
+__attribute__((target("cx16")))
+bool _sa_dword_cx16_cmpxchg(
+  _sa_DoubleWord *ptr,
+  _sa_double_word_ctype *expected,
+  _sa_double_word_ctype desired)
+{
+  _sa_double_word_ctype *value = (_sa_double_word_ctype *)&ptr->value;
+  _sa_double_word_ctype original =
+    __sync_val_compare_and_swap(value, *expected, desired);
+  bool exchanged = (original == *expected);
+  *expected = original;
+  return exchanged;
+}
+#endif
+
+uint32_t _sa_profiler_interval = 0;
+_Thread_local uint32_t _sa_profiler_countdown = 0;
+uint32_t _sa_profiler_epoch = 0;
+_Thread_local uint32_t _sa_profiler_thread_epoch = 0;
+
+// Histograms are kept in an open-addressed table indexed by a hash of the
+// atomic value's address. The last entry collects samples for addresses that
+// don't fit in the table. Bucket `i` counts latencies in the range
+// [2^(i-1), 2^i) ticks; the last bucket also counts all longer latencies.
+typedef struct {
+  uintptr_t address;
+  uint64_t counts[SWIFTATOMIC_PROFILER_BUCKETS];
+} _sa_profiler_location;
+
+static _sa_profiler_location
+_sa_profiler_locations[SWIFTATOMIC_PROFILER_LOCATIONS + 1];
+
+static _sa_profiler_location *_sa_profiler_find(uintptr_t address)
+{
+  uintptr_t index = (address >> 3) ^ (address >> 11);
+  for (int probe = 0; probe < 16; probe++, index++) {
+    _sa_profiler_location *location =
+      &_sa_profiler_locations[index % SWIFTATOMIC_PROFILER_LOCATIONS];
+    uintptr_t key = __atomic_load_n(&location->address, __ATOMIC_RELAXED);
+    if (key == 0) {
+      __atomic_compare_exchange_n(&location->address, &key, address, false,
+                                  __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+      // On failure, `key` is now the address that got there first.
+      if (key == 0) {
+        return location;
+      }
+    }
+    if (key == address) {
+      return location;
+    }
+  }
+  return &_sa_profiler_locations[SWIFTATOMIC_PROFILER_LOCATIONS];
+}
+
+void _sa_profiler_set_interval(uint32_t interval)
+{
+  __atomic_fetch_add(&_sa_profiler_epoch, 1, __ATOMIC_RELAXED);
+  __atomic_store_n(&_sa_profiler_interval, interval, __ATOMIC_RELEASE);
+}
+
+void _sa_profiler_record(const void *address, uint64_t ticks)
+{
+  int bucket = ticks == 0 ? 0 : 64 - __builtin_clzll(ticks);
+  if (bucket >= SWIFTATOMIC_PROFILER_BUCKETS) {
+    bucket = SWIFTATOMIC_PROFILER_BUCKETS - 1;
+  }
+  _sa_profiler_location *location = _sa_profiler_find((uintptr_t)address);
+  __atomic_fetch_add(&location->counts[bucket], 1, __ATOMIC_RELAXED);
+}
+
+void _sa_profiler_reset(void)
+{
+  for (int i = 0; i <= SWIFTATOMIC_PROFILER_LOCATIONS; i++) {
+    _sa_profiler_location *location = &_sa_profiler_locations[i];
+    for (int bucket = 0; bucket < SWIFTATOMIC_PROFILER_BUCKETS; bucket++) {
+      __atomic_store_n(&location->counts[bucket], 0, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&location->address, 0, __ATOMIC_RELAXED);
+  }
+}
+
+const void *_sa_profiler_address(int location)
+{
+  return (const void *)__atomic_load_n(
+    &_sa_profiler_locations[location].address, __ATOMIC_RELAXED);
+}
+
+uint64_t _sa_profiler_count(int location, int bucket)
+{
+  return __atomic_load_n(
+    &_sa_profiler_locations[location].counts[bucket], __ATOMIC_RELAXED);
+}
+
+#if defined(__linux__)
+#include <errno.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+int _sa_wait(const void *address, uint32_t expected, int64_t timeout)
+{
+  struct timespec duration;
+  struct timespec *durationp = NULL;
+  if (timeout >= 0) {
+    duration.tv_sec = timeout / 1000000000;
+    duration.tv_nsec = timeout % 1000000000;
+    durationp = &duration;
+  }
+  if (syscall(SYS_futex, address, FUTEX_WAIT, expected, durationp, NULL, 0) == 0) {
+    return SWIFTATOMIC_WAIT_WOKEN;
+  }
+  switch (errno) {
+  // Report interrupted waits as spurious wakeups.
+  case EINTR: return SWIFTATOMIC_WAIT_WOKEN;
+  case ETIMEDOUT: return SWIFTATOMIC_WAIT_TIMED_OUT;
+  default: return SWIFTATOMIC_WAIT_VALUE_CHANGED;
+  }
+}
+
+int _sa_wake(const void *address, int32_t count)
+{
+  if (count < 0) count = INT_MAX;
+  return (int)syscall(SYS_futex, address, FUTEX_WAKE, count, NULL, NULL, 0);
+}
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#pragma comment(lib, "Synchronization.lib")
+
+int _sa_wait(const void *address, uint32_t expected, int64_t timeout)
+{
+  if (__atomic_load_n((const uint32_t *)address, __ATOMIC_ACQUIRE) != expected) {
+    return SWIFTATOMIC_WAIT_VALUE_CHANGED;
+  }
+  DWORD milliseconds = INFINITE;
+  if (timeout >= 0) {
+    // Round up, so that short timeouts don't turn into polling.
+    int64_t rounded = (timeout + 999999) / 1000000;
+    milliseconds = rounded < INFINITE ? (DWORD)rounded : INFINITE - 1;
+  }
+  if (WaitOnAddress((volatile void *)address, &expected, sizeof(expected),
+                    milliseconds)) {
+    return SWIFTATOMIC_WAIT_WOKEN;
+  }
+  return GetLastError() == ERROR_TIMEOUT
+    ? SWIFTATOMIC_WAIT_TIMED_OUT
+    : SWIFTATOMIC_WAIT_WOKEN;
+}
+
+int _sa_wake(const void *address, int32_t count)
+{
+  if (count == 1) {
+    WakeByAddressSingle((void *)address);
+  } else if (count != 0) {
+    WakeByAddressAll((void *)address);
+  }
+  return 0;
+}
+#else
+#include <time.h>
+
+int _sa_wait(const void *address, uint32_t expected, int64_t timeout)
+{
+  struct timespec start, now;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  long delay = 1000;
+  while (__atomic_load_n((const uint32_t *)address, __ATOMIC_ACQUIRE) == expected) {
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t elapsed = (int64_t)(now.tv_sec - start.tv_sec) * 1000000000
+      + (now.tv_nsec - start.tv_nsec);
+    if (timeout >= 0 && elapsed >= timeout) {
+      return SWIFTATOMIC_WAIT_TIMED_OUT;
+    }
+    struct timespec pause = { 0, delay };
+    nanosleep(&pause, NULL);
+    if (delay < 1000000) delay *= 2;
+  }
+  return SWIFTATOMIC_WAIT_VALUE_CHANGED;
+}
+
+int _sa_wake(const void *address, int32_t count)
+{
+  (void)address;
+  (void)count;
+  return 0;
+}
+#endif
+
+_Thread_local char _sa_thread_marker = 0;
+
+#if defined(_WIN32)
+void _sa_thread_yield(void)
+{
+  SwitchToThread();
+}
+
+int _sa_processor_count(void)
+{
+  DWORD count = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+  return count > 0 ? (int)count : 1;
+}
+#else
+#include <sched.h>
+#include <unistd.h>
+
+void _sa_thread_yield(void)
+{
+  sched_yield();
+}
+
+int _sa_processor_count(void)
+{
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+  return count > 0 ? (int)count : 1;
+}
+#endif
+
+#include <stdlib.h>
+
+// The thread-local pointer is cached in a `_Thread_local` variable for fast
+// access; the platform key only exists to run the destructor on thread exit.
+_Thread_local void *_sa_thread_local_value = NULL;
+static _sa_thread_local_destructor _sa_thread_local_cleanup = NULL;
+
+static void _sa_thread_local_exit(void *value)
+{
+  _sa_thread_local_value = NULL;
+  _sa_thread_local_destructor cleanup =
+    __atomic_load_n(&_sa_thread_local_cleanup, __ATOMIC_ACQUIRE);
+  if (value != NULL && cleanup != NULL) {
+    cleanup(value);
+  }
+}
+
+#if defined(_WIN32)
+static DWORD _sa_thread_local_key = FLS_OUT_OF_INDEXES;
+static INIT_ONCE _sa_thread_local_once = INIT_ONCE_STATIC_INIT;
+
+static VOID NTAPI _sa_thread_local_callback(PVOID value)
+{
+  _sa_thread_local_exit(value);
+}
+
+static BOOL CALLBACK _sa_thread_local_create(
+  PINIT_ONCE once, PVOID parameter, PVOID *context)
+{
+  (void)once;
+  (void)parameter;
+  (void)context;
+  _sa_thread_local_key = FlsAlloc(_sa_thread_local_callback);
+  return _sa_thread_local_key != FLS_OUT_OF_INDEXES;
+}
+
+void _sa_thread_local_set(
+  void *value,
+  _sa_thread_local_destructor destructor)
+{
+  __atomic_store_n(&_sa_thread_local_cleanup, destructor, __ATOMIC_RELEASE);
+  if (!InitOnceExecuteOnce(
+        &_sa_thread_local_once, _sa_thread_local_create, NULL, NULL)) {
+    abort();
+  }
+  FlsSetValue(_sa_thread_local_key, value);
+  _sa_thread_local_value = value;
+}
+#else
+#include <pthread.h>
+
+static pthread_key_t _sa_thread_local_key;
+static pthread_once_t _sa_thread_local_once = PTHREAD_ONCE_INIT;
+
+static void _sa_thread_local_create(void)
+{
+  if (pthread_key_create(&_sa_thread_local_key, _sa_thread_local_exit) != 0) {
+    abort();
+  }
+}
+
+void _sa_thread_local_set(
+  void *value,
+  _sa_thread_local_destructor destructor)
+{
+  __atomic_store_n(&_sa_thread_local_cleanup, destructor, __ATOMIC_RELEASE);
+  pthread_once(&_sa_thread_local_once, _sa_thread_local_create);
+  pthread_setspecific(_sa_thread_local_key, value);
+  _sa_thread_local_value = value;
+}
+#endif
+
+// Threads get their body and context through a separate allocation that
+// the new thread frees itself, so that detaching (and freeing the handle)
+// can't race with the thread starting up.
+struct _sa_thread_start {
+  _sa_thread_body body;
+  void *context;
+};
+
+static struct _sa_thread_start *_sa_thread_start_create(
+  _sa_thread_body body,
+  void *context)
+{
+  struct _sa_thread_start *start = malloc(sizeof(*start));
+  if (start == NULL) abort();
+  start->body = body;
+  start->context = context;
+  return start;
+}
+
+static void _sa_thread_start_run(struct _sa_thread_start *start)
+{
+  _sa_thread_body body = start->body;
+  void *context = start->context;
+  free(start);
+  body(context);
+}
+
+#if defined(_WIN32)
+#include <process.h>
+
+struct _sa_thread {
+  HANDLE handle;
+};
+
+static unsigned __stdcall _sa_thread_main(void *start)
+{
+  _sa_thread_start_run(start);
+  return 0;
+}
+
+_sa_thread *_sa_thread_create(_sa_thread_body body, void *context)
+{
+  _sa_thread *thread = malloc(sizeof(*thread));
+  if (thread == NULL) abort();
+  struct _sa_thread_start *start = _sa_thread_start_create(body, context);
+  uintptr_t handle = _beginthreadex(NULL, 0, _sa_thread_main, start, 0, NULL);
+  if (handle == 0) {
+    free(start);
+    free(thread);
+    return NULL;
+  }
+  thread->handle = (HANDLE)handle;
+  return thread;
+}
+
+void _sa_thread_join(_sa_thread *thread)
+{
+  WaitForSingleObject(thread->handle, INFINITE);
+  CloseHandle(thread->handle);
+  free(thread);
+}
+
+void _sa_thread_detach(_sa_thread *thread)
+{
+  CloseHandle(thread->handle);
+  free(thread);
+}
+#else
+struct _sa_thread {
+  pthread_t handle;
+};
+
+static void *_sa_thread_main(void *start)
+{
+  _sa_thread_start_run(start);
+  return NULL;
+}
+
+_sa_thread *_sa_thread_create(_sa_thread_body body, void *context)
+{
+  _sa_thread *thread = malloc(sizeof(*thread));
+  if (thread == NULL) abort();
+  struct _sa_thread_start *start = _sa_thread_start_create(body, context);
+  if (pthread_create(&thread->handle, NULL, _sa_thread_main, start) != 0) {
+    free(start);
+    free(thread);
+    return NULL;
+  }
+  return thread;
+}
+
+void _sa_thread_join(_sa_thread *thread)
+{
+  pthread_join(thread->handle, NULL);
+  free(thread);
+}
+
+void _sa_thread_detach(_sa_thread *thread)
+{
+  pthread_detach(thread->handle);
+  free(thread);
+}
+#endif
+
+#if defined(_WIN32)
+struct _sa_lock {
+  SRWLOCK lock;
+  CONDITION_VARIABLE condition;
+};
+
+_sa_lock *_sa_lock_create(void)
+{
+  _sa_lock *lock = malloc(sizeof(*lock));
+  if (lock == NULL) abort();
+  InitializeSRWLock(&lock->lock);
+  InitializeConditionVariable(&lock->condition);
+  return lock;
+}
+
+void _sa_lock_destroy(_sa_lock *lock)
+{
+  free(lock);
+}
+
+void _sa_lock_acquire(_sa_lock *lock)
+{
+  AcquireSRWLockExclusive(&lock->lock);
+}
+
+void _sa_lock_release(_sa_lock *lock)
+{
+  ReleaseSRWLockExclusive(&lock->lock);
+}
+
+void _sa_lock_wait(_sa_lock *lock)
+{
+  SleepConditionVariableSRW(&lock->condition, &lock->lock, INFINITE, 0);
+}
+
+void _sa_lock_broadcast(_sa_lock *lock)
+{
+  WakeAllConditionVariable(&lock->condition);
+}
+#else
+struct _sa_lock {
+  pthread_mutex_t mutex;
+  pthread_cond_t condition;
+};
+
+_sa_lock *_sa_lock_create(void)
+{
+  _sa_lock *lock = malloc(sizeof(*lock));
+  if (lock == NULL) abort();
+  if (pthread_mutex_init(&lock->mutex, NULL) != 0) abort();
+  if (pthread_cond_init(&lock->condition, NULL) != 0) abort();
+  return lock;
+}
+
+void _sa_lock_destroy(_sa_lock *lock)
+{
+  pthread_cond_destroy(&lock->condition);
+  pthread_mutex_destroy(&lock->mutex);
+  free(lock);
+}
+
+void _sa_lock_acquire(_sa_lock *lock)
+{
+  pthread_mutex_lock(&lock->mutex);
+}
+
+void _sa_lock_release(_sa_lock *lock)
+{
+  pthread_mutex_unlock(&lock->mutex);
+}
+
+void _sa_lock_wait(_sa_lock *lock)
+{
+  pthread_cond_wait(&lock->condition, &lock->mutex);
+}
+
+void _sa_lock_broadcast(_sa_lock *lock)
+{
+  pthread_cond_broadcast(&lock->condition);
+}
+#endif
+
+#if defined(_WIN32)
+int _sa_backtrace(void **frames, int count)
+{
+  // Skip this function's own frame.
+  return (int)CaptureStackBackTrace(1, (DWORD)count, frames, NULL);
+}
+
+const char *_sa_symbol_name(const void *address, const void **start)
+{
+  (void)address;
+  (void)start;
+  return NULL;
+}
+#else
+#include <dlfcn.h>
+#if defined(__APPLE__) || defined(__GLIBC__)
+#include <execinfo.h>
+
+int _sa_backtrace(void **frames, int count)
+{
+  // Skip this function's own frame.
+  void *buffer[65];
+  if (count > 64) count = 64;
+  int captured = backtrace(buffer, count + 1) - 1;
+  for (int i = 0; i < captured; i++) {
+    frames[i] = buffer[i + 1];
+  }
+  return captured > 0 ? captured : 0;
+}
+#else
+int _sa_backtrace(void **frames, int count)
+{
+  (void)frames;
+  (void)count;
+  return 0;
+}
+#endif
+
+const char *_sa_symbol_name(const void *address, const void **start)
+{
+  Dl_info info;
+  if (dladdr(address, &info) == 0 || info.dli_sname == NULL) {
+    return NULL;
+  }
+  *start = info.dli_saddr;
+  return info.dli_sname;
+}
+#endif
+
 #if ENABLE_DOUBLEWIDE_ATOMICS
 // FIXME: These should be static inline header-only shims, but Swift 5.3 doesn't
 // like calls to swift_retain_n/swift_release_n appearing in Swift code, not
@@ -0,0 +1,116 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Dispatch
+import Foundation
+import Atomics
+
+class AtomicBatchedCounterTests: XCTestCase {
+  func test_singleThread() {
+    let counter = AtomicBatchedCounter(flushThreshold: 4)
+    XCTAssertEqual(counter.load(), 0)
+    counter.increment()
+    counter.increment(by: 10)
+    XCTAssertEqual(counter.load(), 11)
+    counter.increment(by: -1)
+    XCTAssertEqual(counter.load(), 10)
+  }
+
+  func test_threshold() {
+    let counter = AtomicBatchedCounter(flushThreshold: 3)
+    let reader = DispatchQueue(label: "reader")
+    func othersSee() -> Int { reader.sync { counter.load() } }
+
+    counter.increment()
+    counter.increment()
+    XCTAssertEqual(othersSee(), 0)
+    counter.increment()
+    XCTAssertEqual(othersSee(), 3)
+    counter.increment()
+    XCTAssertEqual(othersSee(), 3)
+    counter.flush()
+    XCTAssertEqual(othersSee(), 4)
+  }
+
+  func test_concurrentFlush() {
+    let counter = AtomicBatchedCounter(flushThreshold: 100)
+    DispatchQueue.concurrentPerform(iterations: 8) { _ in
+      for _ in 0 ..< 12_345 {
+        counter.increment()
+      }
+      counter.flush()
+    }
+    XCTAssertEqual(counter.load(), 8 * 12_345)
+  }
+
+  func test_threadExit() {
+    let counter = AtomicBatchedCounter(flushThreshold: 1000)
+    let group = DispatchGroup()
+    for _ in 0 ..< 4 {
+      group.enter()
+      Thread {
+        for _ in 0 ..< 10 {
+          counter.increment()
+        }
+        group.leave()
+      }.start()
+    }
+    group.wait()
+    // Threads flush their increments as they exit, shortly after leaving
+    // the group.
+    let deadline = Date(timeIntervalSinceNow: 10)
+    while counter.load() < 40 && Date() < deadline {
+      Thread.sleep(forTimeInterval: 0.001)
+    }
+    XCTAssertEqual(counter.load(), 40)
+  }
+
+  func test_manyCounters() {
+    // More counters than a process has thread-specific data keys.
+    let counters = (0 ..< 5000).map { _ in
+      AtomicBatchedCounter(flushThreshold: 10)
+    }
+    for (i, counter) in counters.enumerated() {
+      counter.increment(by: i)
+    }
+    for (i, counter) in counters.enumerated() {
+      XCTAssertEqual(counter.load(), i)
+    }
+  }
+
+  func test_reusedIndex() {
+    let worker = DispatchQueue(label: "worker")
+    for round in 0 ..< 10 {
+      // The worker thread keeps state for the previous round's counter,
+      // which has been deinitialized; its index may now belong to this one.
+      let counter = AtomicBatchedCounter(flushThreshold: 100)
+      worker.sync {
+        counter.increment(by: round)
+        counter.flush()
+      }
+      counter.increment()
+      XCTAssertEqual(counter.load(), round + 1)
+    }
+  }
+
+#if !SWIFT_PACKAGE
+  public static var allTests = [
+    ("test_singleThread", test_singleThread),
+    ("test_threshold", test_threshold),
+    ("test_concurrentFlush", test_concurrentFlush),
+    ("test_threadExit", test_threadExit),
+    ("test_manyCounters", test_manyCounters),
+    ("test_reusedIndex", test_reusedIndex),
+  ]
+#endif
+}
@@ -0,0 +1,96 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Dispatch
+import Atomics
+
+class AtomicBufferTests: XCTestCase {
+  func test_unsafe_elements() {
+    let buffer = UnsafeAtomicBuffer<Int>.create(repeating: 7, count: 5)
+    defer { buffer.destroy() }
+    XCTAssertEqual(buffer.count, 5)
+    XCTAssertEqual(buffer.snapshot(), [7, 7, 7, 7, 7])
+
+    buffer[1].store(1, ordering: .relaxed)
+    buffer[4].wrappingIncrement(by: 3, ordering: .relaxed)
+    XCTAssertEqual(buffer[2].exchange(2, ordering: .relaxed), 7)
+    XCTAssertEqual(buffer.snapshot(), [7, 1, 2, 7, 10])
+
+    XCTAssertEqual(buffer.snapshotAndReset(to: 0), [7, 1, 2, 7, 10])
+    XCTAssertEqual(buffer.snapshot(), [0, 0, 0, 0, 0])
+
+    buffer.reset(to: 5)
+    var target = [Int](repeating: 0, count: 5)
+    target.withUnsafeMutableBufferPointer { buffer.snapshot(into: $0) }
+    XCTAssertEqual(target, [5, 5, 5, 5, 5])
+  }
+
+  func test_unsafe_empty() {
+    let buffer = UnsafeAtomicBuffer<Int>.create(repeating: 0, count: 0)
+    defer { buffer.destroy() }
+    XCTAssertEqual(buffer.snapshot(), [])
+    XCTAssertEqual(buffer.snapshotAndReset(to: 1), [])
+  }
+
+  func test_managed_elements() {
+    let buffer = ManagedAtomicBuffer<UInt8>(repeating: 0, count: 3)
+    XCTAssertEqual(buffer.count, 3)
+    buffer.store(250, at: 0, ordering: .relaxed)
+    buffer.wrappingIncrement(at: 0, by: 10, ordering: .relaxed)
+    XCTAssertEqual(buffer.load(at: 0, ordering: .relaxed), 4)
+    XCTAssertEqual(
+      buffer.loadThenWrappingIncrement(at: 1, ordering: .relaxed), 0)
+    XCTAssertEqual(buffer.exchange(9, at: 2, ordering: .relaxed), 0)
+    let (exchanged, original) = buffer.compareExchange(
+      expected: 9, desired: 8, at: 2, ordering: .relaxed)
+    XCTAssertTrue(exchanged)
+    XCTAssertEqual(original, 9)
+    XCTAssertEqual(buffer.snapshotAndReset(to: 0), [4, 1, 8])
+    XCTAssertEqual(buffer.snapshot(), [0, 0, 0])
+  }
+
+  func test_concurrent_increments() {
+    let buckets = 64
+    let iterations = 10_000
+    let buffer = ManagedAtomicBuffer<Int>(repeating: 0, count: buckets)
+    var drained = [Int](repeating: 0, count: buckets)
+    let lock = DispatchQueue(label: "drained")
+    DispatchQueue.concurrentPerform(iterations: 5) { thread in
+      if thread == 0 {
+        // Periodically drain the buffer while the others increment it.
+        for _ in 0 ..< 100 {
+          let values = buffer.snapshotAndReset(to: 0)
+          lock.sync {
+            for index in 0 ..< buckets { drained[index] += values[index] }
+          }
+        }
+      } else {
+        for i in 0 ..< iterations {
+          buffer.wrappingIncrement(at: i % buckets, ordering: .relaxed)
+        }
+      }
+    }
+    let rest = buffer.snapshot()
+    let total = (0 ..< buckets).reduce(0) { $0 + drained[$1] + rest[$1] }
+    XCTAssertEqual(total, 4 * iterations)
+  }
+
+#if !SWIFT_PACKAGE
+  public static var allTests = [
+    ("test_unsafe_elements", test_unsafe_elements),
+    ("test_unsafe_empty", test_unsafe_empty),
+    ("test_managed_elements", test_managed_elements),
+    ("test_concurrent_increments", test_concurrent_increments),
+  ]
+#endif
+}
@@ -0,0 +1,103 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Dispatch
+import Atomics
+
+// These tests only run in builds that enable the contention profiler:
+//
+//     $ swift test -Xswiftc -DATOMICS_CONTENTION_PROFILING
+class AtomicContentionProfilerTests: XCTestCase {
+#if ATOMICS_CONTENTION_PROFILING
+  func histogram(
+    for storage: UnsafeMutablePointer<Int.AtomicRepresentation>
+  ) -> AtomicContentionProfiler.Histogram? {
+    AtomicContentionProfiler.histograms().first {
+      $0.address == UnsafeRawPointer(storage)
+    }
+  }
+
+  func test_sampling() {
+    let storage = UnsafeMutablePointer<Int.AtomicRepresentation>
+      .allocate(capacity: 1)
+    storage.initialize(to: Int.AtomicRepresentation(0))
+    defer {
+      storage.deinitialize(count: 1)
+      storage.deallocate()
+    }
+    let v = UnsafeAtomic<Int>(at: storage)
+
+    AtomicContentionProfiler.reset()
+    _ = v.exchange(1, ordering: .relaxed)
+    XCTAssertNil(histogram(for: storage))
+
+    AtomicContentionProfiler.start(samplingInterval: 1)
+    _ = v.exchange(2, ordering: .relaxed)
+    _ = v.compareExchange(expected: 2, desired: 3, ordering: .relaxed)
+    _ = v.compareExchange(expected: 2, desired: 3, ordering: .relaxed)
+    v.wrappingIncrement(ordering: .relaxed) // Not sampled
+    AtomicContentionProfiler.stop()
+    _ = v.exchange(4, ordering: .relaxed)
+
+    guard let h = histogram(for: storage) else {
+      XCTFail("Missing histogram")
+      return
+    }
+    XCTAssertEqual(h.counts.count, AtomicContentionProfiler.bucketCount)
+    XCTAssertEqual(h.sampleCount, 3)
+    XCTAssertLessThanOrEqual(h.percentile(0.5), h.percentile(0.99))
+
+    AtomicContentionProfiler.reset()
+    XCTAssertNil(histogram(for: storage))
+  }
+
+  func test_contended() {
+    let contended = ManagedAtomic<Int>(0)
+    AtomicContentionProfiler.reset()
+    AtomicContentionProfiler.start(samplingInterval: 100)
+    DispatchQueue.concurrentPerform(iterations: 8) { _ in
+      for _ in 0 ..< 100_000 {
+        var value = contended.load(ordering: .relaxed)
+        while true {
+          let (done, original) = contended.weakCompareExchange(
+            expected: value,
+            desired: value + 1,
+            ordering: .relaxed)
+          if done { break }
+          value = original
+        }
+      }
+    }
+    AtomicContentionProfiler.stop()
+    XCTAssertEqual(contended.load(ordering: .relaxed), 800_000)
+
+    let histograms = AtomicContentionProfiler.histograms()
+    XCTAssertFalse(histograms.isEmpty)
+    XCTAssertGreaterThanOrEqual(
+      histograms.reduce(0) { $0 + $1.sampleCount }, 8_000 - 8)
+  }
+#endif
+
+#if !SWIFT_PACKAGE
+  public static var allTests: [(String, (AtomicContentionProfilerTests) -> () throws -> Void)] = {
+#if ATOMICS_CONTENTION_PROFILING
+    return [
+      ("test_sampling", test_sampling),
+      ("test_contended", test_contended),
+    ]
+#else
+    return []
+#endif
+  }()
+#endif
+}
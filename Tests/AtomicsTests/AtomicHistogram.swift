@@ -0,0 +1,130 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Dispatch
+import Atomics
+
+class AtomicHistogramTests: XCTestCase {
+  func test_empty() {
+    let histogram = AtomicHistogram(significantBits: 3, stripeCount: 2)
+    let snapshot = histogram.snapshot()
+    XCTAssertEqual(snapshot.totalCount, 0)
+    XCTAssertEqual(snapshot.value(atPercentile: 50), 0)
+    XCTAssertNil(snapshot.minimum)
+    XCTAssertNil(snapshot.maximum)
+  }
+
+  func test_precision() {
+    let histogram = AtomicHistogram(significantBits: 7, stripeCount: 1)
+    let values: [UInt64] = [
+      0, 1, 127, 128, 129, 1000, 65_535, 1 << 40, UInt64.max - 1, UInt64.max,
+    ]
+    for value in values {
+      histogram.record(value)
+    }
+    let snapshot = histogram.snapshot()
+    XCTAssertEqual(snapshot.totalCount, UInt64(values.count))
+    for value in values {
+      XCTAssertGreaterThan(snapshot.count(near: value), 0, "\(value)")
+    }
+    // Small values are exact.
+    XCTAssertEqual(snapshot.minimum, 0)
+    XCTAssertEqual(snapshot.value(atPercentile: 30), 127)
+    XCTAssertEqual(snapshot.maximum, UInt64.max)
+    // Larger ones are within the configured relative error.
+    let p60 = snapshot.value(atPercentile: 60)
+    XCTAssertGreaterThanOrEqual(p60, 1000)
+    XCTAssertLessThanOrEqual(p60, 1000 + 1000 / 64)
+  }
+
+  func test_percentiles() {
+    let histogram = AtomicHistogram(significantBits: 5)
+    for value in 1 ... 1000 as ClosedRange<UInt64> {
+      histogram.record(value)
+    }
+    let snapshot = histogram.snapshot()
+    XCTAssertEqual(snapshot.totalCount, 1000)
+    for percentile in [1.0, 25, 50, 90, 99, 99.9, 100] {
+      let expected = UInt64(percentile * 10)
+      let value = snapshot.value(atPercentile: percentile)
+      XCTAssertGreaterThanOrEqual(value, expected, "\(percentile)")
+      XCTAssertLessThanOrEqual(value, expected + expected / 16, "\(percentile)")
+    }
+  }
+
+  func test_merge() {
+    let a = AtomicHistogram(significantBits: 4, stripeCount: 2)
+    let b = AtomicHistogram(significantBits: 4, stripeCount: 3)
+    a.record(10, count: 3)
+    b.record(10)
+    b.record(20_000)
+    var merged = a.snapshot()
+    merged.merge(b.snapshot())
+    XCTAssertEqual(merged.totalCount, 5)
+    XCTAssertEqual(merged.count(near: 10), 4)
+    XCTAssertEqual(merged.count(near: 20_000), 1)
+
+    var reversed = b.snapshot()
+    reversed.merge(a.snapshot())
+    XCTAssertEqual(merged, reversed)
+  }
+
+  func test_reset() {
+    let histogram = AtomicHistogram(significantBits: 4)
+    histogram.record(1)
+    histogram.record(2)
+    XCTAssertEqual(histogram.snapshotAndReset().totalCount, 2)
+    XCTAssertEqual(histogram.snapshot().totalCount, 0)
+    histogram.record(3)
+    let second = histogram.snapshotAndReset()
+    XCTAssertEqual(second.totalCount, 1)
+    XCTAssertEqual(second.count(near: 3), 1)
+    XCTAssertEqual(histogram.snapshotAndReset().totalCount, 0)
+  }
+
+  func test_concurrent_reset_loses_nothing() {
+    let histogram = AtomicHistogram(significantBits: 6, stripeCount: 4)
+    let threads = 4
+    let iterations = 50_000
+    let done = ManagedAtomic<Int>(0)
+    var total = AtomicHistogram.Snapshot(significantBits: 6)
+    DispatchQueue.concurrentPerform(iterations: threads + 1) { thread in
+      if thread == threads {
+        while done.load(ordering: .acquiring) < threads {
+          total.merge(histogram.snapshotAndReset())
+        }
+      } else {
+        for i in 0 ..< iterations {
+          histogram.record(UInt64(i))
+        }
+        done.wrappingIncrement(ordering: .releasing)
+      }
+    }
+    // Drain both banks.
+    total.merge(histogram.snapshotAndReset())
+    total.merge(histogram.snapshotAndReset())
+    XCTAssertEqual(total.totalCount, UInt64(threads * iterations))
+    XCTAssertEqual(total.count(near: 0), UInt64(threads))
+  }
+
+#if !SWIFT_PACKAGE
+  public static var allTests = [
+    ("test_empty", test_empty),
+    ("test_precision", test_precision),
+    ("test_percentiles", test_percentiles),
+    ("test_merge", test_merge),
+    ("test_reset", test_reset),
+    ("test_concurrent_reset_loses_nothing", test_concurrent_reset_loses_nothing),
+  ]
+#endif
+}
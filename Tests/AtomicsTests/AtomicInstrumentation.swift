@@ -0,0 +1,110 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Dispatch
+import Atomics
+
+// These tests only run in builds that enable instrumentation:
+//
+//     $ swift test -Xswiftc -DATOMICS_INSTRUMENTATION
+class AtomicInstrumentationTests: XCTestCase {
+#if ATOMICS_INSTRUMENTATION
+  func entry(
+    for storage: UnsafeMutablePointer<Int.AtomicRepresentation>
+  ) -> AtomicInstrumentation.Entry? {
+    AtomicInstrumentation.entries().first {
+      $0.address == UnsafeRawPointer(storage)
+    }
+  }
+
+  func test_counts() {
+    let storage = UnsafeMutablePointer<Int.AtomicRepresentation>
+      .allocate(capacity: 1)
+    storage.initialize(to: Int.AtomicRepresentation(0))
+    defer {
+      storage.deinitialize(count: 1)
+      storage.deallocate()
+    }
+    let v = UnsafeAtomic<Int>(at: storage)
+
+    AtomicInstrumentation.reset()
+    _ = v.load(ordering: .relaxed)
+    _ = v.load(ordering: .acquiring)
+    v.store(1, ordering: .releasing)
+    v.wrappingIncrement(ordering: .relaxed)
+    _ = v.exchange(3, ordering: .acquiringAndReleasing)
+    XCTAssertFalse(v.compareExchange(
+        expected: 1,
+        desired: 4,
+        ordering: .sequentiallyConsistent).exchanged)
+    XCTAssertTrue(v.compareExchange(
+        expected: 3,
+        desired: 4,
+        ordering: .sequentiallyConsistent).exchanged)
+
+    guard let e = entry(for: storage) else {
+      XCTFail("Missing entry")
+      return
+    }
+    XCTAssertEqual(e.loads, 2)
+    XCTAssertEqual(e.stores, 1)
+    XCTAssertEqual(e.readModifyWrites, 4)
+    XCTAssertEqual(e.failedCompareExchanges, 1)
+
+    AtomicInstrumentation.reset()
+    XCTAssertNil(entry(for: storage))
+  }
+
+  func test_topContended() {
+    let contended = ManagedAtomic<Int>(0)
+    let quiet = ManagedAtomic<Int>(0)
+    AtomicInstrumentation.reset()
+    DispatchQueue.concurrentPerform(iterations: 8) { _ in
+      for _ in 0 ..< 10_000 {
+        _ = quiet.load(ordering: .relaxed)
+        var value = contended.load(ordering: .relaxed)
+        while true {
+          let (done, original) = contended.weakCompareExchange(
+            expected: value,
+            desired: value + 1,
+            ordering: .relaxed)
+          if done { break }
+          value = original
+        }
+      }
+    }
+    XCTAssertEqual(contended.load(ordering: .relaxed), 80_000)
+
+    let top = AtomicInstrumentation.topContended(2)
+    XCTAssertEqual(top.count, 2)
+    XCTAssertGreaterThanOrEqual(top[0].readModifyWrites, 80_000)
+    XCTAssertGreaterThanOrEqual(top[0].loads, 80_000)
+    XCTAssertEqual(top[1].readModifyWrites, 0)
+    XCTAssertEqual(top[1].failedCompareExchanges, 0)
+    XCTAssertEqual(top[1].loads, 80_000)
+  }
+#endif
+
+#if !SWIFT_PACKAGE
+  public static var allTests: [(String, (AtomicInstrumentationTests) -> () throws -> Void)] = {
+#if ATOMICS_INSTRUMENTATION
+    return [
+      ("test_counts", test_counts),
+      ("test_topContended", test_topContended),
+    ]
+#else
+    return []
+#endif
+  }()
+#endif
+}
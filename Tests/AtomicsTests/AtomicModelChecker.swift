@@ -0,0 +1,194 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Atomics
+
+#if ATOMICS_MODEL_CHECKING
+private final class MessagePassing {
+  let data = ManagedAtomic<Int>(0)
+  let flag = ManagedAtomic<Bool>(false)
+  var received: Int? = nil
+}
+#endif
+
+// These tests only run in builds that enable the model checker:
+//
+//     $ swift test -Xswiftc -DATOMICS_MODEL_CHECKING
+class AtomicModelCheckerTests: XCTestCase {
+#if ATOMICS_MODEL_CHECKING
+  func checkMessagePassing(
+    store: AtomicStoreOrdering,
+    load: AtomicLoadOrdering
+  ) -> AtomicModelChecker.Report {
+    AtomicModelChecker.explore(
+      .exhaustive(),
+      threads: 2,
+      setUp: { MessagePassing() },
+      thread: { state, thread in
+        if thread == 0 {
+          state.data.store(42, ordering: .relaxed)
+          state.flag.store(true, ordering: store)
+        } else if state.flag.load(ordering: load) {
+          state.received = state.data.load(ordering: .relaxed)
+        }
+      },
+      verify: { state in
+        state.received == nil || state.received == 42
+      })
+  }
+
+  func test_messagePassing_releaseAcquire() {
+    let report = checkMessagePassing(store: .releasing, load: .acquiring)
+    XCTAssertNil(report.failure)
+    XCTAssertTrue(report.isComplete)
+  }
+
+  func test_messagePassing_relaxed() {
+    // The relaxed store to `flag` doesn't publish `data`; the model checker
+    // must find an execution where the reader sees the flag but stale data.
+    let report = checkMessagePassing(store: .relaxed, load: .acquiring)
+    XCTAssertNotNil(report.failure)
+
+    let reader = checkMessagePassing(store: .releasing, load: .relaxed)
+    XCTAssertNotNil(reader.failure)
+  }
+
+  func test_messagePassing_fences() {
+    let report = AtomicModelChecker.explore(
+      .exhaustive(),
+      threads: 2,
+      setUp: { MessagePassing() },
+      thread: { state, thread in
+        if thread == 0 {
+          state.data.store(42, ordering: .relaxed)
+          atomicMemoryFence(ordering: .releasing)
+          state.flag.store(true, ordering: .relaxed)
+        } else if state.flag.load(ordering: .relaxed) {
+          atomicMemoryFence(ordering: .acquiring)
+          state.received = state.data.load(ordering: .relaxed)
+        }
+      },
+      verify: { state in
+        state.received == nil || state.received == 42
+      })
+    XCTAssertNil(report.failure)
+    XCTAssertTrue(report.isComplete)
+  }
+
+  func test_spinLoop() {
+    let report = AtomicModelChecker.explore(
+      .exhaustive(),
+      threads: 2,
+      setUp: { MessagePassing() },
+      thread: { state, thread in
+        if thread == 0 {
+          state.data.store(42, ordering: .relaxed)
+          state.flag.store(true, ordering: .releasing)
+        } else {
+          while !state.flag.load(ordering: .acquiring) {
+            AtomicModelChecker.yield()
+          }
+          state.received = state.data.load(ordering: .relaxed)
+        }
+      },
+      verify: { state in state.received == 42 })
+    XCTAssertNil(report.failure)
+    XCTAssertTrue(report.isComplete)
+  }
+
+  func test_lostUpdate() {
+    let report = AtomicModelChecker.explore(
+      .exhaustive(),
+      threads: 2,
+      setUp: { ManagedAtomic<Int>(0) },
+      thread: { counter, _ in
+        // Not atomic!
+        let value = counter.load(ordering: .relaxed)
+        counter.store(value + 1, ordering: .relaxed)
+      },
+      verify: { counter in counter.load(ordering: .relaxed) == 2 })
+    guard let failure = report.failure else {
+      XCTFail("Lost update not found")
+      return
+    }
+
+    // The failing schedule reproduces the failure.
+    let replay = AtomicModelChecker.explore(
+      .replay(failure.schedule),
+      threads: 2,
+      setUp: { ManagedAtomic<Int>(0) },
+      thread: { counter, _ in
+        let value = counter.load(ordering: .relaxed)
+        counter.store(value + 1, ordering: .relaxed)
+      },
+      verify: { counter in counter.load(ordering: .relaxed) == 2 })
+    XCTAssertEqual(replay.executions, 1)
+    XCTAssertEqual(replay.failure?.schedule, failure.schedule)
+  }
+
+  func test_compareExchangeLoop() {
+    let report = AtomicModelChecker.explore(
+      .exhaustive(preemptionBound: nil),
+      threads: 3,
+      setUp: { ManagedAtomic<Int>(0) },
+      thread: { counter, _ in
+        var value = counter.load(ordering: .relaxed)
+        while true {
+          let (done, original) = counter.weakCompareExchange(
+            expected: value,
+            desired: value + 1,
+            ordering: .relaxed)
+          if done { break }
+          value = original
+        }
+      },
+      verify: { counter in counter.load(ordering: .relaxed) == 3 })
+    XCTAssertNil(report.failure)
+    XCTAssertTrue(report.isComplete)
+    XCTAssertGreaterThan(report.executions, 1)
+  }
+
+  func test_random() {
+    let report = AtomicModelChecker.explore(
+      .random(executions: 200, seed: 42),
+      threads: 4,
+      setUp: { ManagedAtomic<Int>(0) },
+      thread: { counter, _ in
+        for _ in 0 ..< 3 {
+          counter.wrappingIncrement(ordering: .relaxed)
+        }
+      },
+      verify: { counter in counter.load(ordering: .relaxed) == 12 })
+    XCTAssertNil(report.failure)
+    XCTAssertEqual(report.executions, 200)
+  }
+#endif
+
+#if !SWIFT_PACKAGE
+  public static var allTests: [(String, (AtomicModelCheckerTests) -> () throws -> Void)] = {
+#if ATOMICS_MODEL_CHECKING
+    return [
+      ("test_messagePassing_releaseAcquire", test_messagePassing_releaseAcquire),
+      ("test_messagePassing_relaxed", test_messagePassing_relaxed),
+      ("test_messagePassing_fences", test_messagePassing_fences),
+      ("test_spinLoop", test_spinLoop),
+      ("test_lostUpdate", test_lostUpdate),
+      ("test_compareExchangeLoop", test_compareExchangeLoop),
+      ("test_random", test_random),
+    ]
+#else
+    return []
+#endif
+  }()
+#endif
+}
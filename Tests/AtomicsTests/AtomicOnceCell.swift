@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Dispatch
+import Foundation
+import Atomics
+
+private struct InitializationError: Error {}
+
+class AtomicOnceCellTests: XCTestCase {
+  func test_basics() {
+    let cell = AtomicOnceCell<[Int]>()
+    XCTAssertFalse(cell.isInitialized)
+    XCTAssertNil(cell.load())
+    XCTAssertEqual(cell.get { [1, 2, 3] }, [1, 2, 3])
+    XCTAssertTrue(cell.isInitialized)
+    XCTAssertEqual(cell.load(), [1, 2, 3])
+    XCTAssertEqual(cell.get { [4] }, [1, 2, 3])
+
+    let initialized = AtomicOnceCell("foo")
+    XCTAssertEqual(initialized.load(), "foo")
+    XCTAssertEqual(initialized.get { "bar" }, "foo")
+  }
+
+  func test_throwingInitializer() {
+    let cell = AtomicOnceCell<Int>()
+    XCTAssertThrowsError(try cell.get { throw InitializationError() })
+    XCTAssertFalse(cell.isInitialized)
+    XCTAssertEqual(try cell.get { 42 }, 42)
+  }
+
+  func test_singleInitialization() {
+    let cell = AtomicOnceCell<LifetimeTracked>()
+    let initializations = ManagedAtomic<Int>(0)
+    let results = (0 ..< 8).map { _ in ManagedAtomic<Int>(0) }
+    DispatchQueue.concurrentPerform(iterations: 8) { thread in
+      let value = cell.get {
+        initializations.wrappingIncrement(ordering: .relaxed)
+        // Make sure other threads have to wait.
+        Thread.sleep(forTimeInterval: 0.05)
+        return LifetimeTracked(thread + 1)
+      }
+      results[thread].store(value.value, ordering: .relaxed)
+    }
+    XCTAssertEqual(initializations.load(ordering: .relaxed), 1)
+    let values = Set(results.map { $0.load(ordering: .relaxed) })
+    XCTAssertEqual(values.count, 1)
+    XCTAssertEqual(values.first, cell.load()?.value)
+  }
+
+  func test_waitersRetryAfterFailure() {
+    let cell = AtomicOnceCell<Int>()
+    let attempts = ManagedAtomic<Int>(0)
+    DispatchQueue.concurrentPerform(iterations: 4) { _ in
+      let value = try? cell.get { () throws -> Int in
+        let attempt = attempts.loadThenWrappingIncrement(ordering: .relaxed)
+        Thread.sleep(forTimeInterval: 0.01)
+        if attempt == 0 { throw InitializationError() }
+        return attempt
+      }
+      XCTAssert(value == nil || value == 1)
+    }
+    XCTAssertEqual(cell.load(), 1)
+    XCTAssertEqual(attempts.load(ordering: .relaxed), 2)
+  }
+
+#if !SWIFT_PACKAGE
+  public static var allTests = [
+    ("test_basics", test_basics),
+    ("test_throwingInitializer", test_throwingInitializer),
+    ("test_singleInitialization", test_singleInitialization),
+    ("test_waitersRetryAfterFailure", test_waitersRetryAfterFailure),
+  ]
+#endif
+}
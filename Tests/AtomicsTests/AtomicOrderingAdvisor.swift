@@ -0,0 +1,154 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Atomics
+
+#if ATOMICS_MODEL_CHECKING
+private final class Handoff {
+  let data = ManagedAtomic<Int>(0)
+  let flag = ManagedAtomic<Bool>(false)
+  var received: Int? = nil
+}
+
+private final class StoreBuffering {
+  let x = ManagedAtomic<Int>(0)
+  let y = ManagedAtomic<Int>(0)
+  var seen = [-1, -1]
+}
+#endif
+
+// These tests only run in builds that enable the model checker:
+//
+//     $ swift test -Xswiftc -DATOMICS_MODEL_CHECKING
+class AtomicOrderingAdvisorTests: XCTestCase {
+#if ATOMICS_MODEL_CHECKING
+  func test_messagePassing() {
+    let report = AtomicModelChecker.adviseOrderings(
+      threads: 2,
+      setUp: { Handoff() },
+      thread: { state, thread in
+        if thread == 0 {
+          state.data.store(42, ordering: .sequentiallyConsistent)
+          state.flag.store(true, ordering: .sequentiallyConsistent)
+        } else if state.flag.load(ordering: .sequentiallyConsistent) {
+          state.received = state.data.load(ordering: .sequentiallyConsistent)
+        }
+      },
+      verify: { state in
+        state.received == nil || state.received == 42
+      })
+    XCTAssertNil(report.baseline.failure)
+    XCTAssertTrue(report.baseline.isComplete)
+    XCTAssertEqual(report.advice.count, 4)
+    XCTAssertEqual(report.weakenable.count, 4)
+
+    func suggestions(
+      _ kind: AtomicModelChecker.OperationKind
+    ) -> Set<AtomicUpdateOrdering> {
+      Set(report.advice.filter { $0.kind == kind }.compactMap { $0.suggested })
+    }
+    // The data accesses can be relaxed, but the flag needs to publish them.
+    XCTAssertEqual(suggestions(.store), [.relaxed, .releasing])
+    XCTAssertEqual(suggestions(.load), [.relaxed, .acquiring])
+  }
+
+  func test_storeBuffering() {
+    // Each thread stores to one location, then loads the other. Only
+    // sequential consistency rules out both loads reading zero.
+    let report = AtomicModelChecker.adviseOrderings(
+      threads: 2,
+      setUp: { StoreBuffering() },
+      thread: { state, thread in
+        if thread == 0 {
+          state.x.store(1, ordering: .sequentiallyConsistent)
+          state.seen[0] = state.y.load(ordering: .sequentiallyConsistent)
+        } else {
+          state.y.store(1, ordering: .sequentiallyConsistent)
+          state.seen[1] = state.x.load(ordering: .sequentiallyConsistent)
+        }
+      },
+      verify: { state in state.seen != [0, 0] })
+    XCTAssertNil(report.baseline.failure)
+    XCTAssertTrue(report.baseline.isComplete)
+    XCTAssertEqual(report.advice.count, 4)
+    XCTAssertTrue(report.weakenable.isEmpty)
+  }
+
+  func test_dekkerFences() {
+    // The same pattern with relaxed accesses, ordered by fences.
+    let report = AtomicModelChecker.adviseOrderings(
+      threads: 2,
+      setUp: { StoreBuffering() },
+      thread: { state, thread in
+        if thread == 0 {
+          state.x.store(1, ordering: .relaxed)
+          atomicMemoryFence(ordering: .sequentiallyConsistent)
+          state.seen[0] = state.y.load(ordering: .relaxed)
+        } else {
+          state.y.store(1, ordering: .relaxed)
+          atomicMemoryFence(ordering: .sequentiallyConsistent)
+          state.seen[1] = state.x.load(ordering: .relaxed)
+        }
+      },
+      verify: { state in state.seen != [0, 0] })
+    XCTAssertNil(report.baseline.failure)
+    XCTAssertTrue(report.baseline.isComplete)
+    XCTAssertEqual(report.advice.count, 2)
+    XCTAssertTrue(report.advice.allSatisfy { $0.kind == .fence })
+    XCTAssertTrue(report.weakenable.isEmpty)
+  }
+
+  func test_counter() {
+    let report = AtomicModelChecker.adviseOrderings(
+      threads: 2,
+      setUp: { ManagedAtomic<Int>(0) },
+      thread: { counter, _ in
+        counter.wrappingIncrement(ordering: .acquiringAndReleasing)
+      },
+      verify: { counter in counter.load(ordering: .relaxed) == 2 })
+    XCTAssertEqual(report.advice.count, 1)
+    XCTAssertEqual(report.advice.first?.kind, .readModifyWrite)
+    XCTAssertEqual(report.advice.first?.current, .acquiringAndReleasing)
+    XCTAssertEqual(report.advice.first?.suggested, .relaxed)
+  }
+
+  func test_failingBaseline() {
+    let report = AtomicModelChecker.adviseOrderings(
+      threads: 2,
+      setUp: { ManagedAtomic<Int>(0) },
+      thread: { counter, _ in
+        let value = counter.load(ordering: .sequentiallyConsistent)
+        counter.store(value + 1, ordering: .sequentiallyConsistent)
+      },
+      verify: { counter in counter.load(ordering: .relaxed) == 2 })
+    XCTAssertNotNil(report.baseline.failure)
+    XCTAssertTrue(report.advice.isEmpty)
+  }
+#endif
+
+#if !SWIFT_PACKAGE
+  public static var allTests: [(String, (AtomicOrderingAdvisorTests) -> () throws -> Void)] = {
+#if ATOMICS_MODEL_CHECKING
+    return [
+      ("test_messagePassing", test_messagePassing),
+      ("test_storeBuffering", test_storeBuffering),
+      ("test_dekkerFences", test_dekkerFences),
+      ("test_counter", test_counter),
+      ("test_failingBaseline", test_failingBaseline),
+    ]
+#else
+    return []
+#endif
+  }()
+#endif
+}
@@ -0,0 +1,133 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Dispatch
+import Atomics
+
+private struct Packed: AtomicPackedValue, Equatable {
+  var rawValue: UInt64
+  init(rawValue: UInt64) { self.rawValue = rawValue }
+
+  static let phase = AtomicBitField<Packed>(width: 2)
+  static let count = AtomicBitField.after(phase, width: 30)
+  static let generation = AtomicBitField.after(count, width: 32)
+
+  init(phase: UInt64, count: UInt64, generation: UInt64) {
+    self.rawValue = 0
+    self[Packed.phase] = phase
+    self[Packed.count] = count
+    self[Packed.generation] = generation
+  }
+
+  var phase: UInt64 { self[Packed.phase] }
+  var count: UInt64 { self[Packed.count] }
+  var generation: UInt64 { self[Packed.generation] }
+}
+
+class AtomicPackedValueTests: XCTestCase {
+  func test_fields() {
+    XCTAssertEqual(Packed.phase.mask, 0b11)
+    XCTAssertEqual(Packed.count.offset, 2)
+    XCTAssertEqual(Packed.count.maximum, (1 << 30) - 1)
+    XCTAssertEqual(Packed.generation.offset, 32)
+    XCTAssertEqual(Packed.generation.maximum, UInt64(UInt32.max))
+    XCTAssertEqual(Packed.generation.mask, 0xFFFF_FFFF_0000_0000)
+
+    let full = AtomicBitField<Packed>(width: 64)
+    XCTAssertEqual(full.maximum, UInt64.max)
+    XCTAssertEqual(full.mask, UInt64.max)
+
+    var value = Packed(phase: 3, count: 12345, generation: UInt64(UInt32.max))
+    XCTAssertEqual(value.phase, 3)
+    XCTAssertEqual(value.count, 12345)
+    XCTAssertEqual(value.generation, UInt64(UInt32.max))
+    value[Packed.count] = 0
+    XCTAssertEqual(value, Packed(phase: 3, count: 0, generation: UInt64(UInt32.max)))
+  }
+
+  func test_increment_decrement() {
+    let v = ManagedAtomic(Packed(phase: 1, count: 0, generation: 7))
+
+    var original = v.loadThenIncrement(Packed.count, ordering: .relaxed)
+    XCTAssertEqual(original, Packed(phase: 1, count: 0, generation: 7))
+    v.loadThenIncrement(Packed.count, by: 10, ordering: .acquiringAndReleasing)
+    v.loadThenIncrement(Packed.generation, ordering: .releasing)
+    XCTAssertEqual(
+      v.load(ordering: .relaxed),
+      Packed(phase: 1, count: 11, generation: 8))
+
+    original = v.loadThenDecrement(Packed.count, by: 11, ordering: .acquiring)
+    XCTAssertEqual(original, Packed(phase: 1, count: 11, generation: 8))
+    XCTAssertEqual(
+      v.load(ordering: .relaxed),
+      Packed(phase: 1, count: 0, generation: 8))
+  }
+
+  func test_field_compareExchange() {
+    let v = UnsafeAtomic.create(Packed(phase: 0, count: 5, generation: 1))
+    defer { v.destroy() }
+
+    var r = v.compareExchange(
+      Packed.phase, expected: 1, desired: 2, ordering: .acquiringAndReleasing)
+    XCTAssertFalse(r.exchanged)
+    XCTAssertEqual(r.original, Packed(phase: 0, count: 5, generation: 1))
+
+    r = v.compareExchange(
+      Packed.phase, expected: 0, desired: 2, ordering: .sequentiallyConsistent)
+    XCTAssertTrue(r.exchanged)
+    XCTAssertEqual(r.original, Packed(phase: 0, count: 5, generation: 1))
+    XCTAssertEqual(
+      v.load(ordering: .relaxed),
+      Packed(phase: 2, count: 5, generation: 1))
+  }
+
+  func test_concurrent_fields() {
+    // Threads increment the count while others flip the phase; neither kind
+    // of update may clobber the other.
+    let v = ManagedAtomic(Packed(phase: 0, count: 0, generation: 0))
+    let iterations = 100_000
+    let flips = ManagedAtomic<Int>(0)
+    DispatchQueue.concurrentPerform(iterations: 4) { thread in
+      if thread < 2 {
+        for _ in 0 ..< iterations {
+          v.loadThenIncrement(Packed.count, ordering: .relaxed)
+        }
+      } else {
+        for _ in 0 ..< iterations {
+          let phase = v.load(ordering: .relaxed).phase
+          if v.compareExchange(
+            Packed.phase,
+            expected: phase,
+            desired: (phase + 1) % 4,
+            ordering: .relaxed
+          ).exchanged {
+            flips.wrappingIncrement(ordering: .relaxed)
+          }
+        }
+      }
+    }
+    let result = v.load(ordering: .relaxed)
+    XCTAssertEqual(result.count, UInt64(2 * iterations))
+    XCTAssertEqual(result.phase, UInt64(flips.load(ordering: .relaxed) % 4))
+    XCTAssertEqual(result.generation, 0)
+  }
+
+#if !SWIFT_PACKAGE
+  public static var allTests = [
+    ("test_fields", test_fields),
+    ("test_increment_decrement", test_increment_decrement),
+    ("test_field_compareExchange", test_field_compareExchange),
+    ("test_concurrent_fields", test_concurrent_fields),
+  ]
+#endif
+}
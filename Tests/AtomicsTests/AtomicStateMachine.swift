@@ -0,0 +1,116 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Dispatch
+import Atomics
+
+private enum Phase: UInt8, AtomicStateMachine {
+  case idle, running, finished, cancelled
+
+  static let transitions: AtomicTransitionTable<Phase> = [
+    .idle: [.running, .cancelled],
+    .running: [.finished, .cancelled],
+  ]
+}
+
+class AtomicStateMachineTests: XCTestCase {
+  func test_table() {
+    let table = Phase.transitions
+    XCTAssertTrue(table.allows(from: .idle, to: .running))
+    XCTAssertTrue(table.allows(from: .idle, to: .cancelled))
+    XCTAssertTrue(table.allows(from: .running, to: .finished))
+    XCTAssertFalse(table.allows(from: .idle, to: .finished))
+    XCTAssertFalse(table.allows(from: .finished, to: .idle))
+    XCTAssertFalse(table.allows(from: .cancelled, to: .cancelled))
+
+    let pairs = AtomicTransitionTable<Phase>(
+      [(from: .finished, to: .idle)])
+    XCTAssertTrue(pairs.allows(from: .finished, to: .idle))
+    XCTAssertFalse(pairs.allows(from: .idle, to: .running))
+  }
+
+  func test_transition_from() {
+    let phase = ManagedAtomic(Phase.idle)
+
+    var r = phase.transition(from: .running, to: .finished, ordering: .relaxed)
+    XCTAssertFalse(r.exchanged)
+    XCTAssertEqual(r.original, .idle)
+
+    r = phase.transition(from: .idle, to: .running, ordering: .acquiringAndReleasing)
+    XCTAssertTrue(r.exchanged)
+    XCTAssertEqual(r.original, .idle)
+    XCTAssertEqual(phase.load(ordering: .relaxed), .running)
+  }
+
+  func test_transition_to() {
+    let phase = UnsafeAtomic.create(Phase.idle)
+    defer { phase.destroy() }
+
+    // Not allowed from the current state.
+    var r = phase.transition(to: .finished, ordering: .acquiring)
+    XCTAssertFalse(r.exchanged)
+    XCTAssertEqual(r.original, .idle)
+    XCTAssertEqual(phase.load(ordering: .relaxed), .idle)
+
+    r = phase.transition(to: .running, ordering: .releasing)
+    XCTAssertTrue(r.exchanged)
+    XCTAssertEqual(r.original, .idle)
+
+    r = phase.transition(to: .cancelled, ordering: .sequentiallyConsistent)
+    XCTAssertTrue(r.exchanged)
+    XCTAssertEqual(r.original, .running)
+
+    // Terminal state.
+    r = phase.transition(to: .running, ordering: .relaxed)
+    XCTAssertFalse(r.exchanged)
+    XCTAssertEqual(r.original, .cancelled)
+  }
+
+  func test_race_to_terminal_state() {
+    // A worker starts and finishes the task while others try to cancel it;
+    // exactly one of finishing and cancelling may succeed.
+    for _ in 0 ..< 1000 {
+      let phase = ManagedAtomic(Phase.idle)
+      let cancellations = ManagedAtomic<Int>(0)
+      let finished = ManagedAtomic<Bool>(false)
+      DispatchQueue.concurrentPerform(iterations: 4) { thread in
+        if thread == 0 {
+          if phase.transition(to: .running, ordering: .acquiringAndReleasing)
+            .exchanged {
+            let r = phase.transition(
+              from: .running, to: .finished, ordering: .acquiringAndReleasing)
+            finished.store(r.exchanged, ordering: .relaxed)
+          }
+        } else if phase.transition(to: .cancelled, ordering: .acquiringAndReleasing)
+          .exchanged {
+          cancellations.wrappingIncrement(ordering: .relaxed)
+        }
+      }
+      let cancelled = cancellations.load(ordering: .relaxed)
+      XCTAssertLessThanOrEqual(cancelled, 1)
+      XCTAssertNotEqual(cancelled == 1, finished.load(ordering: .relaxed))
+      XCTAssertEqual(
+        phase.load(ordering: .relaxed),
+        cancelled == 1 ? .cancelled : .finished)
+    }
+  }
+
+#if !SWIFT_PACKAGE
+  public static var allTests = [
+    ("test_table", test_table),
+    ("test_transition_from", test_transition_from),
+    ("test_transition_to", test_transition_to),
+    ("test_race_to_terminal_state", test_race_to_terminal_state),
+  ]
+#endif
+}
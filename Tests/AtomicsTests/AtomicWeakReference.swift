@@ -0,0 +1,130 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Dispatch
+import Atomics
+
+private class Target {
+  let value: Int
+
+  init(_ value: Int) {
+    self.value = value
+    Target.instances.wrappingIncrement(ordering: .relaxed)
+  }
+
+  deinit {
+    Target.instances.wrappingDecrement(ordering: .relaxed)
+  }
+
+  static let instances = ManagedAtomic<Int>(0)
+}
+
+class AtomicWeakReferenceTests: XCTestCase {
+  override func tearDown() {
+    super.tearDown()
+    XCTAssertEqual(LifetimeTracked.instances, 0)
+  }
+
+  func test_create_destroy() {
+    let v = UnsafeAtomicWeakReference<LifetimeTracked>.create()
+    defer { v.destroy() }
+    XCTAssertNil(v.load())
+  }
+
+  func test_load_doesNotRetain() {
+    let v = UnsafeAtomicWeakReference<LifetimeTracked>.create()
+    defer { v.destroy() }
+    do {
+      let ref = LifetimeTracked(42)
+      v.store(ref)
+      XCTAssertTrue(v.load() === ref)
+      XCTAssertEqual(LifetimeTracked.instances, 1)
+    }
+    XCTAssertEqual(LifetimeTracked.instances, 0)
+    XCTAssertNil(v.load())
+  }
+
+  func test_exchange() {
+    let v = ManagedAtomicWeakReference<LifetimeTracked>()
+    let a = LifetimeTracked(1)
+    let b = LifetimeTracked(2)
+    XCTAssertNil(v.exchange(a))
+    XCTAssertTrue(v.exchange(b) === a)
+    XCTAssertTrue(v.load() === b)
+    XCTAssertTrue(v.exchange(nil) === b)
+    XCTAssertNil(v.load())
+  }
+
+  func test_compareExchange() {
+    let v = ManagedAtomicWeakReference<LifetimeTracked>()
+    let a = LifetimeTracked(1)
+    let b = LifetimeTracked(2)
+
+    var r = v.compareExchange(expected: a, desired: b)
+    XCTAssertFalse(r.exchanged)
+    XCTAssertNil(r.original)
+
+    r = v.compareExchange(expected: nil, desired: a)
+    XCTAssertTrue(r.exchanged)
+    XCTAssertNil(r.original)
+    XCTAssertTrue(v.load() === a)
+
+    r = v.compareExchange(expected: b, desired: nil)
+    XCTAssertFalse(r.exchanged)
+    XCTAssertTrue(r.original === a)
+
+    r = v.compareExchange(expected: a, desired: b)
+    XCTAssertTrue(r.exchanged)
+    XCTAssertTrue(r.original === a)
+    XCTAssertTrue(v.load() === b)
+  }
+
+  func test_compareExchange_deallocatedTargetIsNil() {
+    let v = ManagedAtomicWeakReference<LifetimeTracked>()
+    do {
+      v.store(LifetimeTracked(1))
+    }
+    let a = LifetimeTracked(2)
+    let r = v.compareExchange(expected: nil, desired: a)
+    XCTAssertTrue(r.exchanged)
+    XCTAssertNil(r.original)
+    XCTAssertTrue(v.load() === a)
+  }
+
+  func test_concurrentUpgrade() {
+    let v = ManagedAtomicWeakReference<Target>()
+    DispatchQueue.concurrentPerform(iterations: 8) { id in
+      for i in 0 ..< 10_000 {
+        if id == 0 {
+          // Keep replacing the target, letting the old one die.
+          v.store(Target(i))
+        } else if let value = v.load() {
+          precondition(value.value >= 0)
+        }
+      }
+    }
+    v.store(nil)
+    XCTAssertEqual(Target.instances.load(ordering: .relaxed), 0)
+  }
+
+#if !SWIFT_PACKAGE
+  public static var allTests = [
+    ("test_create_destroy", test_create_destroy),
+    ("test_load_doesNotRetain", test_load_doesNotRetain),
+    ("test_exchange", test_exchange),
+    ("test_compareExchange", test_compareExchange),
+    ("test_compareExchange_deallocatedTargetIsNil", test_compareExchange_deallocatedTargetIsNil),
+    ("test_concurrentUpgrade", test_concurrentUpgrade),
+  ]
+#endif
+}
@@ -0,0 +1,143 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Dispatch
+import Foundation
+import Atomics
+
+/// Runs `body` on `count` dedicated threads, so that threads waiting for
+/// each other can't starve a thread pool.
+func runOnThreads(_ count: Int, _ body: @escaping (Int) -> Void) {
+  let group = DispatchGroup()
+  for index in 0 ..< count {
+    group.enter()
+    Thread {
+      body(index)
+      group.leave()
+    }.start()
+  }
+  group.wait()
+}
+
+class BroadcastRingTests: XCTestCase {
+  func checkBroadcast(
+    _ waitStrategy: RingWaitStrategy,
+    consumers: Int = 3,
+    count: Int = 20_000,
+    batchSize: Int = 1,
+    file: StaticString = #file,
+    line: UInt = #line
+  ) {
+    let ring = BroadcastRing<Int>(
+      capacity: 64,
+      consumers: consumers,
+      waitStrategy: waitStrategy)
+    let failures = ManagedAtomic<Int>(0)
+    runOnThreads(consumers + 1) { thread in
+      if thread == consumers {
+        var next = 0
+        while next < count {
+          let end = Swift.min(count, next + batchSize)
+          ring.publish(contentsOf: next ..< end)
+          next = end
+        }
+        ring.close()
+        return
+      }
+      let consumer = ring.consumer(thread)
+      var expected = 0
+      while true {
+        let read = consumer.consume { value, sequence in
+          if value != expected || sequence != expected {
+            failures.wrappingIncrement(ordering: .relaxed)
+          }
+          expected += 1
+        }
+        if read == 0 { break }
+      }
+      if expected != count {
+        failures.wrappingIncrement(ordering: .relaxed)
+      }
+    }
+    XCTAssertEqual(failures.load(ordering: .relaxed), 0, file: file, line: line)
+  }
+
+  func test_busySpin() {
+    checkBroadcast(BusySpinWaitStrategy(), consumers: 2)
+  }
+
+  func test_yielding() {
+    checkBroadcast(YieldingWaitStrategy())
+  }
+
+  func test_blocking() {
+    checkBroadcast(BlockingWaitStrategy())
+  }
+
+  func test_batches() {
+    checkBroadcast(YieldingWaitStrategy(), batchSize: 100)
+    checkBroadcast(BlockingWaitStrategy(), batchSize: 17)
+  }
+
+  func test_poll() {
+    let ring = BroadcastRing<String>(capacity: 4, consumers: 2)
+    let first = ring.consumer(0)
+    let second = ring.consumer(1)
+    XCTAssertEqual(first.poll { _, _ in XCTFail() }, 0)
+
+    let range = ring.claim(3)
+    XCTAssertEqual(range, 0 ..< 3)
+    for sequence in range {
+      ring.write("\(sequence)", at: sequence)
+    }
+    ring.publish(through: 1)
+
+    var seen: [String] = []
+    XCTAssertEqual(first.poll(maxCount: 1) { value, _ in seen.append(value) }, 1)
+    XCTAssertEqual(first.poll { value, _ in seen.append(value) }, 1)
+    XCTAssertEqual(first.poll { value, _ in seen.append(value) }, 0)
+    XCTAssertEqual(seen, ["0", "1"])
+    XCTAssertEqual(first.sequence, 1)
+    XCTAssertEqual(second.sequence, -1)
+
+    ring.publish(through: 2)
+    ring.close()
+    XCTAssertEqual(first.consume { value, _ in XCTAssertEqual(value, "2") }, 1)
+    XCTAssertEqual(first.consume { _, _ in XCTFail() }, 0)
+    XCTAssertEqual(second.consume { _, _ in }, 3)
+    XCTAssertEqual(second.consume { _, _ in XCTFail() }, 0)
+  }
+
+  func test_pollManyBatches() {
+    let ring = BroadcastRing<Int>(capacity: 4, consumers: 1)
+    let consumer = ring.consumer(0)
+    var seen: [Int] = []
+    for batch in 0 ..< 10 {
+      ring.publish(contentsOf: 3 * batch ..< 3 * batch + 3)
+      XCTAssertEqual(consumer.poll { value, _ in seen.append(value) }, 3)
+      XCTAssertEqual(consumer.sequence, 3 * batch + 2)
+    }
+    XCTAssertEqual(seen, Array(0 ..< 30))
+  }
+
+#if !SWIFT_PACKAGE
+  public static var allTests = [
+    ("test_busySpin", test_busySpin),
+    ("test_yielding", test_yielding),
+    ("test_blocking", test_blocking),
+    ("test_batches", test_batches),
+    ("test_poll", test_poll),
+    ("test_pollManyBatches", test_pollManyBatches),
+  ]
+#endif
+}
@@ -0,0 +1,119 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Dispatch
+import Foundation
+import Atomics
+
+/// Whether to run the benchmarks in this test suite. They take a long time,
+/// so they are skipped unless the `SWIFT_ATOMICS_BENCHMARKS` environment
+/// variable is set:
+///
+///     $ SWIFT_ATOMICS_BENCHMARKS=1 swift test -c release --filter benchmark
+let benchmarksEnabled =
+  ProcessInfo.processInfo.environment["SWIFT_ATOMICS_BENCHMARKS"] != nil
+
+/// Benchmarks for read-modify-write operations on a single, heavily contended
+/// atomic value. Each benchmark performs the same total number of updates,
+/// spread over a varying number of threads.
+///
+/// On Linux/AArch64, these use LSE instructions (`ldadd`, `cas`, `casp`) on
+/// CPUs that support them. To compare with the load-exclusive/store-exclusive
+/// loops used on CPUs without LSE, build with
+/// `-Xcc -DSWIFTATOMIC_DISABLE_LSE_DISPATCH`.
+///
+/// These only run when `benchmarksEnabled` is true.
+class ContentionTests: XCTestCase {
+  let updates = 4_000_000
+
+  func checkWrappingIncrement(threads: Int) {
+    guard benchmarksEnabled else { return }
+    let counter = ManagedAtomic<Int>(0)
+    measure {
+      DispatchQueue.concurrentPerform(iterations: threads) { _ in
+        for _ in 0 ..< updates / threads {
+          counter.wrappingIncrement(ordering: .relaxed)
+        }
+      }
+    }
+    XCTAssertEqual(counter.load(ordering: .relaxed) % updates, 0)
+  }
+
+  func test_benchmark_wrappingIncrement_1() {
+    checkWrappingIncrement(threads: 1)
+  }
+
+  func test_benchmark_wrappingIncrement_2() {
+    checkWrappingIncrement(threads: 2)
+  }
+
+  func test_benchmark_wrappingIncrement_4() {
+    checkWrappingIncrement(threads: 4)
+  }
+
+  func test_benchmark_wrappingIncrement_8() {
+    checkWrappingIncrement(threads: 8)
+  }
+
+  func test_benchmark_wrappingIncrement_16() {
+    checkWrappingIncrement(threads: 16)
+  }
+
+  func test_benchmark_compareExchange_8() {
+    guard benchmarksEnabled else { return }
+    let counter = ManagedAtomic<Int>(0)
+    measure {
+      DispatchQueue.concurrentPerform(iterations: 8) { _ in
+        for _ in 0 ..< updates / 8 {
+          var value = counter.load(ordering: .relaxed)
+          while true {
+            let (exchanged, original) = counter.weakCompareExchange(
+              expected: value,
+              desired: value &+ 1,
+              ordering: .acquiringAndReleasing)
+            if exchanged { break }
+            value = original
+          }
+        }
+      }
+    }
+    XCTAssertEqual(counter.load(ordering: .relaxed) % updates, 0)
+  }
+
+  func test_benchmark_doubleWordCompareExchange_8() {
+    guard benchmarksEnabled else { return }
+    let counter = ManagedAtomic(DoubleWord(high: 0, low: 0))
+    measure {
+      DispatchQueue.concurrentPerform(iterations: 8) { _ in
+        for _ in 0 ..< updates / 8 {
+          counter.loadThenWrappingIncrementLow(ordering: .acquiringAndReleasing)
+        }
+      }
+    }
+    let value = counter.load(ordering: .relaxed)
+    XCTAssertEqual(value.high, 0)
+    XCTAssertEqual(Int(value.low) % updates, 0)
+  }
+
+#if !SWIFT_PACKAGE
+  public static var allTests = [
+    ("test_benchmark_wrappingIncrement_1", test_benchmark_wrappingIncrement_1),
+    ("test_benchmark_wrappingIncrement_2", test_benchmark_wrappingIncrement_2),
+    ("test_benchmark_wrappingIncrement_4", test_benchmark_wrappingIncrement_4),
+    ("test_benchmark_wrappingIncrement_8", test_benchmark_wrappingIncrement_8),
+    ("test_benchmark_wrappingIncrement_16", test_benchmark_wrappingIncrement_16),
+    ("test_benchmark_compareExchange_8", test_benchmark_compareExchange_8),
+    ("test_benchmark_doubleWordCompareExchange_8", test_benchmark_doubleWordCompareExchange_8),
+  ]
+#endif
+}
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 import XCTest
+import Dispatch
 import Atomics
 
 class DoubleWordTests: XCTestCase {
@@ -87,6 +88,162 @@ class DoubleWordTests: XCTestCase {
     #endif
   }
 
+  func testCompareExchangeHalves() {
+    let v = ManagedAtomic(DoubleWord(high: 1, low: 2))
+
+    var r = v.compareExchangeHigh(expected: 2, desired: 3, ordering: .relaxed)
+    XCTAssertFalse(r.exchanged)
+    XCTAssertEqual(r.original, DoubleWord(high: 1, low: 2))
+
+    r = v.compareExchangeHigh(expected: 1, desired: 3, ordering: .acquiringAndReleasing)
+    XCTAssertTrue(r.exchanged)
+    XCTAssertEqual(r.original, DoubleWord(high: 1, low: 2))
+    XCTAssertEqual(v.load(ordering: .relaxed), DoubleWord(high: 3, low: 2))
+
+    r = v.compareExchangeLow(expected: 1, desired: 4, ordering: .sequentiallyConsistent)
+    XCTAssertFalse(r.exchanged)
+    XCTAssertEqual(r.original, DoubleWord(high: 3, low: 2))
+
+    r = v.compareExchangeLow(expected: 2, desired: 4, ordering: .releasing)
+    XCTAssertTrue(r.exchanged)
+    XCTAssertEqual(r.original, DoubleWord(high: 3, low: 2))
+    XCTAssertEqual(v.load(ordering: .relaxed), DoubleWord(high: 3, low: 4))
+  }
+
+  func testWrappingIncrementHalves() {
+    let v = ManagedAtomic(DoubleWord(high: 1, low: UInt.max))
+
+    var original = v.loadThenWrappingIncrementHigh(by: 2, ordering: .relaxed)
+    XCTAssertEqual(original, DoubleWord(high: 1, low: UInt.max))
+    XCTAssertEqual(v.load(ordering: .relaxed), DoubleWord(high: 3, low: UInt.max))
+
+    // Overflow doesn't carry into the high word.
+    original = v.loadThenWrappingIncrementLow(ordering: .acquiringAndReleasing)
+    XCTAssertEqual(original, DoubleWord(high: 3, low: UInt.max))
+    XCTAssertEqual(v.load(ordering: .relaxed), DoubleWord(high: 3, low: 0))
+
+    original = v.loadThenWrappingIncrementHigh(by: UInt.max, ordering: .sequentiallyConsistent)
+    XCTAssertEqual(original, DoubleWord(high: 3, low: 0))
+    XCTAssertEqual(v.load(ordering: .relaxed), DoubleWord(high: 2, low: 0))
+  }
+
+  func testArithmeticOperators() {
+    let a = DoubleWord(high: 1, low: UInt.max)
+    let one = DoubleWord(high: 0, low: 1)
+    XCTAssertEqual(a &+ one, DoubleWord(high: 2, low: 0))
+    XCTAssertEqual(DoubleWord(high: 2, low: 0) &- one, a)
+    XCTAssertEqual(
+      DoubleWord(high: 0, low: 0) &- one,
+      DoubleWord(high: UInt.max, low: UInt.max))
+    XCTAssertEqual(
+      DoubleWord(high: UInt.max, low: UInt.max) &+ one,
+      DoubleWord(high: 0, low: 0))
+    XCTAssertEqual(a & DoubleWord(high: 3, low: 6), DoubleWord(high: 1, low: 6))
+    XCTAssertEqual(a | DoubleWord(high: 2, low: 0), DoubleWord(high: 3, low: UInt.max))
+    XCTAssertEqual(a ^ a, DoubleWord(high: 0, low: 0))
+  }
+
+  func testWrappingIncrementCarries() {
+    let v = ManagedAtomic(DoubleWord(high: 1, low: UInt.max))
+
+    var original = v.loadThenWrappingIncrement(ordering: .relaxed)
+    XCTAssertEqual(original, DoubleWord(high: 1, low: UInt.max))
+    XCTAssertEqual(v.load(ordering: .relaxed), DoubleWord(high: 2, low: 0))
+
+    original = v.loadThenWrappingDecrement(
+      by: DoubleWord(high: 0, low: 2),
+      ordering: .acquiringAndReleasing)
+    XCTAssertEqual(original, DoubleWord(high: 2, low: 0))
+    XCTAssertEqual(v.load(ordering: .relaxed), DoubleWord(high: 1, low: UInt.max - 1))
+
+    XCTAssertEqual(
+      v.wrappingIncrementThenLoad(
+        by: DoubleWord(high: UInt.max, low: 2),
+        ordering: .sequentiallyConsistent),
+      DoubleWord(high: 1, low: 0))
+
+    v.wrappingDecrement(by: DoubleWord(high: 1, low: 1), ordering: .releasing)
+    XCTAssertEqual(v.load(ordering: .relaxed), DoubleWord(high: UInt.max, low: UInt.max))
+    v.wrappingIncrement(ordering: .acquiring)
+    XCTAssertEqual(v.load(ordering: .relaxed), DoubleWord(high: 0, low: 0))
+  }
+
+  func testBitwiseOperations() {
+    let v = UnsafeAtomic.create(DoubleWord(high: 0b1100, low: 0b1010))
+    defer { v.destroy() }
+
+    var original = v.loadThenBitwiseOr(
+      with: DoubleWord(high: 0b0001, low: 0b0101),
+      ordering: .relaxed)
+    XCTAssertEqual(original, DoubleWord(high: 0b1100, low: 0b1010))
+    XCTAssertEqual(v.load(ordering: .relaxed), DoubleWord(high: 0b1101, low: 0b1111))
+
+    original = v.loadThenBitwiseAnd(
+      with: DoubleWord(high: 0b0110, low: 0b0011),
+      ordering: .acquiring)
+    XCTAssertEqual(original, DoubleWord(high: 0b1101, low: 0b1111))
+    XCTAssertEqual(v.load(ordering: .relaxed), DoubleWord(high: 0b0100, low: 0b0011))
+
+    XCTAssertEqual(
+      v.bitwiseXorThenLoad(
+        with: DoubleWord(high: UInt.max, low: 0b0001),
+        ordering: .releasing),
+      DoubleWord(high: ~UInt(0b0100), low: 0b0010))
+  }
+
+  func testConcurrentWrappingIncrements() {
+    // Start right below a carry into the high word.
+    let start = DoubleWord(high: 0, low: UInt.max - 1000)
+    let v = ManagedAtomic(start)
+    let threads = 4
+    let iterations = 100_000
+    DispatchQueue.concurrentPerform(iterations: threads) { _ in
+      for _ in 0 ..< iterations {
+        v.wrappingIncrement(ordering: .relaxed)
+      }
+    }
+    XCTAssertEqual(
+      v.load(ordering: .relaxed),
+      start &+ DoubleWord(high: 0, low: UInt(threads * iterations)))
+  }
+
+  func testConcurrentLoadsAreNotTorn() {
+    let v = ManagedAtomic(DoubleWord(high: 0, low: 0))
+    let done = ManagedAtomic(false)
+    // Readers spin until the writer is done, so each needs its own thread.
+    runOnThreads(4) { id in
+      if id == 0 {
+        for i in 1 ... UInt(1_000_000) {
+          v.store(DoubleWord(high: i, low: i), ordering: .releasing)
+        }
+        done.store(true, ordering: .releasing)
+      } else {
+        while !done.load(ordering: .acquiring) {
+          let value = v.load(ordering: .acquiring)
+          precondition(value.high == value.low)
+        }
+      }
+    }
+  }
+
+  // Benchmark for read-mostly double-wide values. To compare with loads
+  // implemented via compare-exchange, build with
+  // `-Xcc -DSWIFTATOMIC_DISABLE_PLAIN_DOUBLEWIDE_ACCESS`. This only runs
+  // when `benchmarksEnabled` is true.
+  func testBenchmarkConcurrentLoads() {
+    guard benchmarksEnabled else { return }
+    let v = ManagedAtomic(DoubleWord(high: 1, low: 2))
+    measure {
+      DispatchQueue.concurrentPerform(iterations: 8) { _ in
+        var sum: UInt = 0
+        for _ in 0 ..< 1_000_000 {
+          sum &+= v.load(ordering: .acquiring).low
+        }
+        precondition(sum == 2_000_000)
+      }
+    }
+  }
+
 #if !SWIFT_PACKAGE
   public static var allTests = [
     ("testMemoryLayout", testMemoryLayout),
@@ -94,6 +251,14 @@ class DoubleWordTests: XCTestCase {
     ("testHighLowInitializer", testHighLowInitializer),
     ("testPropertyGetters", testPropertyGetters),
     ("testPropertySetters", testPropertySetters),
+    ("testCompareExchangeHalves", testCompareExchangeHalves),
+    ("testWrappingIncrementHalves", testWrappingIncrementHalves),
+    ("testArithmeticOperators", testArithmeticOperators),
+    ("testWrappingIncrementCarries", testWrappingIncrementCarries),
+    ("testBitwiseOperations", testBitwiseOperations),
+    ("testConcurrentWrappingIncrements", testConcurrentWrappingIncrements),
+    ("testConcurrentLoadsAreNotTorn", testConcurrentLoadsAreNotTorn),
+    ("testBenchmarkConcurrentLoads", testBenchmarkConcurrentLoads),
   ]
 #endif
 }
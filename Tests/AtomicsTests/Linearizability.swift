@@ -0,0 +1,196 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Atomics
+
+private struct QueueModel: SequentialModel {
+  enum Operation {
+    case enqueue(Int)
+    case dequeue
+  }
+
+  var elements: [Int] = []
+
+  mutating func apply(_ operation: Operation) -> Int? {
+    switch operation {
+    case .enqueue(let value):
+      elements.append(value)
+      return nil
+    case .dequeue:
+      return elements.isEmpty ? nil : elements.removeFirst()
+    }
+  }
+}
+
+private struct CounterModel: SequentialModel {
+  var value = 0
+
+  mutating func apply(_ increment: Bool) -> Int {
+    defer { if increment { value += 1 } }
+    return value
+  }
+}
+
+class LinearizabilityTests: XCTestCase {
+  typealias Register = AtomicRegisterModel<Int>
+  typealias Event = HistoryEvent<Register.Operation, Register.Result>
+
+  func test_linearize_accepts() {
+    // Thread 1's load overlaps with thread 0's store, so it may observe
+    // either value.
+    let history = [
+      Event(thread: 0, operation: .store(1), result: .none,
+            invocation: 0, response: 3),
+      Event(thread: 1, operation: .load, result: .value(0),
+            invocation: 1, response: 2),
+      Event(thread: 1, operation: .load, result: .value(1),
+            invocation: 4, response: 5),
+    ]
+    let order = linearize(history, from: Register(0))
+    XCTAssertEqual(order?.map { $0.invocation }, [1, 0, 4])
+  }
+
+  func test_linearize_rejects() {
+    // The second load starts after the store completed, so it must not
+    // observe the old value.
+    let history = [
+      Event(thread: 0, operation: .store(1), result: .none,
+            invocation: 0, response: 1),
+      Event(thread: 1, operation: .load, result: .value(0),
+            invocation: 2, response: 3),
+    ]
+    XCTAssertNil(linearize(history, from: Register(0)))
+
+    // Two overlapping successful compare-exchanges with the same expected
+    // value can't both be linearized.
+    let cas = [
+      Event(thread: 0,
+            operation: .compareExchange(expected: 0, desired: 1),
+            result: .exchanged(true, 0),
+            invocation: 0, response: 2),
+      Event(thread: 1,
+            operation: .compareExchange(expected: 0, desired: 2),
+            result: .exchanged(true, 0),
+            invocation: 1, response: 3),
+    ]
+    XCTAssertNil(linearize(cas, from: Register(0)))
+  }
+
+  func test_linearize_rejectsLostUpdate() {
+    // A racy increment implemented as a load followed by a store loses
+    // updates; the checker must notice.
+    let history = [
+      HistoryEvent(thread: 0, operation: true, result: 0,
+                   invocation: 0, response: 2),
+      HistoryEvent(thread: 1, operation: true, result: 0,
+                   invocation: 1, response: 3),
+      HistoryEvent(thread: 0, operation: false, result: 1,
+                   invocation: 4, response: 5),
+    ]
+    XCTAssertNil(linearize(history, from: CounterModel()))
+  }
+
+  func checkRegister<Value: AtomicValue & Hashable>(
+    _ values: [Value],
+    file: StaticString = #file,
+    line: UInt = #line
+  ) {
+    typealias Model = AtomicRegisterModel<Value>
+    func value(_ random: inout StressRandom) -> Value {
+      values[Int(random.next() % UInt64(values.count))]
+    }
+    checkLinearizability(
+      model: Model(values[0]),
+      makeSubject: { ManagedAtomic(values[0]) },
+      generate: { _, random -> Model.Operation in
+        switch random.next() % 4 {
+        case 0: return .load
+        case 1: return .store(value(&random))
+        case 2: return .exchange(value(&random))
+        default:
+          return .compareExchange(
+            expected: value(&random),
+            desired: value(&random))
+        }
+      },
+      execute: { atomic, operation in
+        Model.execute(operation, on: atomic)
+      },
+      file: file, line: line)
+  }
+
+  func test_register_Int() {
+    checkRegister([0, 1, 2, 3] as [Int])
+  }
+
+  func test_register_Bool() {
+    checkRegister([false, true])
+  }
+
+  func test_register_DoubleWord() {
+    checkRegister([
+      DoubleWord(high: 0, low: 0),
+      DoubleWord(high: 0, low: 1),
+      DoubleWord(high: 1, low: 0),
+      DoubleWord(high: .max, low: .max),
+    ])
+  }
+
+  func test_counter() {
+    checkLinearizability(
+      model: CounterModel(),
+      makeSubject: { ManagedAtomic<Int>(0) },
+      generate: { _, random in random.next() % 2 == 0 },
+      execute: { counter, increment in
+        increment
+          ? counter.loadThenWrappingIncrement(ordering: .acquiringAndReleasing)
+          : counter.load(ordering: .acquiring)
+      })
+  }
+
+  func test_LockFreeQueue() {
+    checkLinearizability(
+      model: QueueModel(),
+      makeSubject: { LockFreeQueue<Int>() },
+      tearDown: { queue in
+        while queue.dequeue() != nil {}
+      },
+      generate: { thread, random -> QueueModel.Operation in
+        random.next() % 2 == 0
+          ? .enqueue(thread << 32 | Int(random.next() % 1000))
+          : .dequeue
+      },
+      execute: { queue, operation in
+        switch operation {
+        case .enqueue(let value):
+          queue.enqueue(value)
+          return nil
+        case .dequeue:
+          return queue.dequeue()
+        }
+      })
+  }
+
+#if !SWIFT_PACKAGE
+  public static var allTests = [
+    ("test_linearize_accepts", test_linearize_accepts),
+    ("test_linearize_rejects", test_linearize_rejects),
+    ("test_linearize_rejectsLostUpdate", test_linearize_rejectsLostUpdate),
+    ("test_register_Int", test_register_Int),
+    ("test_register_Bool", test_register_Bool),
+    ("test_register_DoubleWord", test_register_DoubleWord),
+    ("test_counter", test_counter),
+    ("test_LockFreeQueue", test_LockFreeQueue),
+  ]
+#endif
+}
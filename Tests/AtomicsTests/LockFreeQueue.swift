@@ -28,7 +28,6 @@ import XCTest
 import Dispatch
 import Atomics
 
-#if !(os(Linux) && arch(x86_64)) || ENABLE_DOUBLEWIDE_ATOMICS
 private let nodeCount = ManagedAtomic<Int>(0)
 
 class LockFreeQueue<Element> {
@@ -186,5 +185,3 @@ class QueueTests: XCTestCase {
   ]
 #endif
 }
-
-#endif
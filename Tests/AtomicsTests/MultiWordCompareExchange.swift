@@ -0,0 +1,207 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Dispatch
+import Foundation
+import Atomics
+
+class MultiWordCompareExchangeTests: XCTestCase {
+  func test_singleWord() {
+    let a = UnsafeMultiWordAtomic.create(1)
+    defer { a.destroy() }
+
+    XCTAssertEqual(a.load(), 1)
+    a.store(2)
+    XCTAssertEqual(a.load(), 2)
+
+    var r = a.compareExchange(expected: 1, desired: 3)
+    XCTAssertFalse(r.exchanged)
+    XCTAssertEqual(r.original, 2)
+
+    r = a.compareExchange(expected: 2, desired: -3)
+    XCTAssertTrue(r.exchanged)
+    XCTAssertEqual(r.original, 2)
+    XCTAssertEqual(a.load(), -3)
+  }
+
+  func test_multiWord() {
+    let a = UnsafeMultiWordAtomic.create(1)
+    let b = UnsafeMultiWordAtomic.create(2)
+    let c = UnsafeMultiWordAtomic.create(3)
+    defer {
+      a.destroy()
+      b.destroy()
+      c.destroy()
+    }
+
+    XCTAssertFalse(atomicMultiWordCompareExchange([
+      (a, 1, 10),
+      (b, 2, 20),
+      (c, 4, 30),
+    ]))
+    XCTAssertEqual(a.load(), 1)
+    XCTAssertEqual(b.load(), 2)
+    XCTAssertEqual(c.load(), 3)
+
+    XCTAssertTrue(atomicMultiWordCompareExchange([
+      (c, 3, 30),
+      (a, 1, 10),
+      (b, 2, 20),
+    ]))
+    XCTAssertEqual(a.load(), 10)
+    XCTAssertEqual(b.load(), 20)
+    XCTAssertEqual(c.load(), 30)
+  }
+
+  func test_pointers() {
+    let nodes = UnsafeMutableRawPointer.allocate(byteCount: 32, alignment: 16)
+    defer { nodes.deallocate() }
+    // Pointers are stored as they are, so ones with their high bits set
+    // (signed or tagged pointers) must round-trip too.
+    let high = UnsafeMutableRawPointer(bitPattern: UInt.max &<< 2)!
+
+    let head = UnsafeMultiWordAtomic<UnsafeMutableRawPointer?>.create(nil)
+    let count = UnsafeMultiWordAtomic.create(0)
+    defer {
+      head.destroy()
+      count.destroy()
+    }
+
+    XCTAssertNil(head.load())
+    head.store(high)
+    XCTAssertEqual(head.load(), high)
+    let r = head.compareExchange(expected: high, desired: nodes)
+    XCTAssertTrue(r.exchanged)
+    XCTAssertEqual(r.original, high)
+
+    XCTAssertFalse(atomicMultiWordCompareExchange([
+      MultiWordAtomicUpdate(head, expected: nodes + 16, desired: nil),
+      MultiWordAtomicUpdate(count, expected: 0, desired: 1),
+    ]))
+    XCTAssertEqual(head.load(), nodes)
+    XCTAssertEqual(count.load(), 0)
+
+    XCTAssertTrue(atomicMultiWordCompareExchange([
+      MultiWordAtomicUpdate(head, expected: nodes, desired: nodes + 16),
+      MultiWordAtomicUpdate(count, expected: 0, desired: 1),
+    ]))
+    XCTAssertEqual(head.load(), nodes + 16)
+    XCTAssertEqual(count.load(), 1)
+  }
+
+  /// Concurrently move units between a set of accounts, checking that the
+  /// total never changes.
+  func checkTransfers(threads: Int, accounts: Int, iterations: Int) {
+    let storage = UnsafeMutablePointer<UnsafeMultiWordAtomic<Int>.Storage>
+      .allocate(capacity: accounts)
+    storage.initialize(
+      repeating: UnsafeMultiWordAtomic<Int>.Storage(1000),
+      count: accounts)
+    defer {
+      storage.deinitialize(count: accounts)
+      storage.deallocate()
+    }
+    let locations = (0 ..< accounts).map {
+      UnsafeMultiWordAtomic(at: storage + $0)
+    }
+
+    DispatchQueue.concurrentPerform(iterations: threads) { id in
+      var rng = SystemRandomNumberGenerator()
+      for _ in 0 ..< iterations {
+        let from = Int.random(in: 0 ..< accounts, using: &rng)
+        var to = Int.random(in: 0 ..< accounts - 1, using: &rng)
+        if to >= from { to += 1 }
+        while true {
+          let f = locations[from].load()
+          let t = locations[to].load()
+          if atomicMultiWordCompareExchange([
+            (locations[from], f, f - 1),
+            (locations[to], t, t + 1),
+          ]) {
+            break
+          }
+        }
+      }
+    }
+
+    let total = locations.reduce(0) { $0 + $1.load() }
+    XCTAssertEqual(total, 1000 * accounts)
+  }
+
+  func test_transfers_2_4() {
+    checkTransfers(threads: 2, accounts: 4, iterations: 100_000)
+  }
+
+  func test_transfers_8_4() {
+    checkTransfers(threads: 8, accounts: 4, iterations: 100_000)
+  }
+
+  func test_transfers_16_64() {
+    checkTransfers(threads: 16, accounts: 64, iterations: 10_000)
+  }
+
+  // Benchmarks comparing a four-word compare and exchange with the same
+  // update done under a lock. These only run when `benchmarksEnabled` is
+  // true.
+
+  func test_benchmark_multiWord() {
+    guard benchmarksEnabled else { return }
+    let locations = (0 ..< 4).map { UnsafeMultiWordAtomic.create($0) }
+    defer { locations.forEach { $0.destroy() } }
+    measure {
+      DispatchQueue.concurrentPerform(iterations: 4) { _ in
+        for _ in 0 ..< 100_000 {
+          while true {
+            let values = locations.map { $0.load() }
+            if atomicMultiWordCompareExchange([
+              (locations[0], values[0], values[0] + 1),
+              (locations[1], values[1], values[1] + 1),
+              (locations[2], values[2], values[2] + 1),
+              (locations[3], values[3], values[3] + 1),
+            ]) {
+              break
+            }
+          }
+        }
+      }
+    }
+  }
+
+  func test_benchmark_lock() {
+    guard benchmarksEnabled else { return }
+    let lock = NSLock()
+    var values = [0, 1, 2, 3]
+    measure {
+      DispatchQueue.concurrentPerform(iterations: 4) { _ in
+        for _ in 0 ..< 100_000 {
+          lock.lock()
+          for i in values.indices { values[i] += 1 }
+          lock.unlock()
+        }
+      }
+    }
+  }
+
+#if !SWIFT_PACKAGE
+  public static var allTests = [
+    ("test_singleWord", test_singleWord),
+    ("test_multiWord", test_multiWord),
+    ("test_pointers", test_pointers),
+    ("test_transfers_2_4", test_transfers_2_4),
+    ("test_transfers_8_4", test_transfers_8_4),
+    ("test_transfers_16_64", test_transfers_16_64),
+    ("test_benchmark_multiWord", test_benchmark_multiWord),
+    ("test_benchmark_lock", test_benchmark_lock),
+  ]
+#endif
+}
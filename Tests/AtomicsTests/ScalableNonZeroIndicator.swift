@@ -0,0 +1,92 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Dispatch
+import Atomics
+
+class ScalableNonZeroIndicatorTests: XCTestCase {
+  func test_basics() {
+    let snzi = ScalableNonZeroIndicator(leafCount: 4)
+    XCTAssertEqual(snzi.leafCount, 4)
+    XCTAssertFalse(snzi.isNonZero)
+
+    let a = snzi.arrive(hint: 0)
+    XCTAssertTrue(snzi.isNonZero)
+    let b = snzi.arrive(hint: 3)
+    let c = snzi.arrive(hint: 3)
+    snzi.depart(a)
+    XCTAssertTrue(snzi.isNonZero)
+    snzi.depart(b)
+    XCTAssertTrue(snzi.isNonZero)
+    snzi.depart(c)
+    XCTAssertFalse(snzi.isNonZero)
+
+    let d = snzi.arrive()
+    XCTAssertTrue(snzi.isNonZero)
+    snzi.depart(d)
+    XCTAssertFalse(snzi.isNonZero)
+  }
+
+  func test_leafCount() {
+    XCTAssertEqual(ScalableNonZeroIndicator(leafCount: 1).leafCount, 1)
+    XCTAssertEqual(ScalableNonZeroIndicator(leafCount: 5).leafCount, 8)
+    XCTAssertGreaterThanOrEqual(ScalableNonZeroIndicator().leafCount, 1)
+  }
+
+  func test_concurrent() {
+    let snzi = ScalableNonZeroIndicator(leafCount: 4)
+    // A reader that stays for the whole test keeps the indicator nonzero.
+    let anchor = snzi.arrive(hint: 1)
+    let failures = ManagedAtomic<Int>(0)
+    DispatchQueue.concurrentPerform(iterations: 8) { thread in
+      for i in 0 ..< 20_000 {
+        let ticket = snzi.arrive(hint: thread &+ i % 3)
+        if !snzi.isNonZero {
+          failures.wrappingIncrement(ordering: .relaxed)
+        }
+        snzi.depart(ticket)
+      }
+    }
+    XCTAssertEqual(failures.load(ordering: .relaxed), 0)
+    XCTAssertTrue(snzi.isNonZero)
+    snzi.depart(anchor)
+    XCTAssertFalse(snzi.isNonZero)
+  }
+
+  func test_concurrent_zeroCrossings() {
+    // Without an anchor, the tree keeps going between zero and nonzero,
+    // exercising the half-arrival helping logic.
+    let snzi = ScalableNonZeroIndicator(leafCount: 2)
+    let failures = ManagedAtomic<Int>(0)
+    DispatchQueue.concurrentPerform(iterations: 8) { thread in
+      for _ in 0 ..< 20_000 {
+        let ticket = snzi.arrive(hint: thread)
+        if !snzi.isNonZero {
+          failures.wrappingIncrement(ordering: .relaxed)
+        }
+        snzi.depart(ticket)
+      }
+    }
+    XCTAssertEqual(failures.load(ordering: .relaxed), 0)
+    XCTAssertFalse(snzi.isNonZero)
+  }
+
+#if !SWIFT_PACKAGE
+  public static var allTests = [
+    ("test_basics", test_basics),
+    ("test_leafCount", test_leafCount),
+    ("test_concurrent", test_concurrent),
+    ("test_concurrent_zeroCrossings", test_concurrent_zeroCrossings),
+  ]
+#endif
+}
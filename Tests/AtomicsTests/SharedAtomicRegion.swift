@@ -0,0 +1,146 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Dispatch
+import Atomics
+
+#if !os(Windows)
+private func temporaryPath(_ name: String) -> String {
+  let path = NSTemporaryDirectory() + "atomics-\(name)-\(getpid())"
+  unlink(path)
+  return path
+}
+#endif
+
+class SharedAtomicRegionTests: XCTestCase {
+  func test_wait_valueChanged() {
+    let word = ManagedAtomic<UInt32>(1)
+    XCTAssertEqual(word.wait(whileEqualTo: 0), .valueChanged)
+  }
+
+  func test_wait_timeout() {
+    let word = ManagedAtomic<UInt32>(0)
+    XCTAssertEqual(
+      word.wait(whileEqualTo: 0, timeoutNanoseconds: 1_000_000),
+      .timedOut)
+  }
+
+  func test_wait_wake() {
+    let word = ManagedAtomic<UInt32>(0)
+    // The waiter blocks, so it needs a thread of its own.
+    runOnThreads(2) { thread in
+      if thread == 0 {
+        while word.load(ordering: .acquiring) == 0 {
+          word.wait(whileEqualTo: 0)
+        }
+      } else {
+        word.store(1, ordering: .releasing)
+        word.wakeAll()
+      }
+    }
+    XCTAssertEqual(word.load(ordering: .relaxed), 1)
+  }
+
+  func test_layout() {
+    var layout = SharedAtomicLayout()
+    let flag = layout.allocate(Bool.self, initialValue: true)
+    let head = layout.allocate(UInt64.self, cacheLineAligned: true)
+    let slots = layout.allocate(UInt32.self, count: 10)
+    XCTAssertEqual(flag.offset, 64)
+    XCTAssertEqual(head.offset, 128)
+    XCTAssertEqual(slots.offset, 192)
+    XCTAssertEqual(slots.count, 10)
+    XCTAssertEqual(layout.size, 232)
+  }
+
+#if !os(Windows)
+  func test_twoMappings() throws {
+    let path = temporaryPath("twoMappings")
+    defer { unlink(path) }
+
+    var layout = SharedAtomicLayout()
+    let counter = layout.allocate(Int.self, cacheLineAligned: true)
+    let ready = layout.allocate(UInt32.self)
+    let values = layout.allocate(Int64.self, count: 4, initialValue: -1)
+
+    // Mapping the same file twice gives two different addresses for the
+    // same memory, as if it was shared by two processes.
+    let first = try SharedAtomicRegion(path: path, layout: layout)
+    let second = try SharedAtomicRegion(path: path, layout: layout)
+    XCTAssertNotEqual(first.baseAddress, second.baseAddress)
+
+    XCTAssertEqual(second[values, 3].load(ordering: .relaxed), -1)
+    first[values, 3].store(42, ordering: .relaxed)
+    XCTAssertEqual(second[values, 3].load(ordering: .relaxed), 42)
+
+    let regions = [first, second]
+    DispatchQueue.concurrentPerform(iterations: 4) { thread in
+      let region = regions[thread % 2]
+      for _ in 0 ..< 10_000 {
+        region[counter].wrappingIncrement(ordering: .relaxed)
+      }
+    }
+    XCTAssertEqual(first[counter].load(ordering: .relaxed), 40_000)
+
+    runOnThreads(2) { thread in
+      if thread == 0 {
+        let flag = first[ready]
+        while flag.load(ordering: .acquiring) == 0 {
+          flag.wait(whileEqualTo: 0)
+        }
+      } else {
+        second[ready].store(1, ordering: .releasing)
+        second[ready].wakeAll()
+      }
+    }
+  }
+
+  func test_layoutMismatch() throws {
+    let path = temporaryPath("layoutMismatch")
+    defer { unlink(path) }
+
+    var layout = SharedAtomicLayout()
+    _ = layout.allocate(Int.self, count: 2)
+    let region = try SharedAtomicRegion(path: path, layout: layout)
+
+    var other = SharedAtomicLayout()
+    _ = other.allocate(UInt.self, count: 2)
+    XCTAssertThrowsError(try SharedAtomicRegion(path: path, layout: other))
+
+    var larger = layout
+    _ = larger.allocate(Int.self)
+    XCTAssertThrowsError(
+      try SharedAtomicRegion(path: path, layout: larger, create: false))
+
+    withExtendedLifetime(region) {}
+  }
+#endif
+
+#if !SWIFT_PACKAGE
+  public static var allTests: [(String, (SharedAtomicRegionTests) -> () throws -> Void)] = {
+    var tests: [(String, (SharedAtomicRegionTests) -> () throws -> Void)] = [
+      ("test_wait_valueChanged", test_wait_valueChanged),
+      ("test_wait_timeout", test_wait_timeout),
+      ("test_wait_wake", test_wait_wake),
+      ("test_layout", test_layout),
+    ]
+#if !os(Windows)
+    tests += [
+      ("test_twoMappings", test_twoMappings),
+      ("test_layoutMismatch", test_layoutMismatch),
+    ]
+#endif
+    return tests
+  }()
+#endif
+}
@@ -0,0 +1,318 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Dispatch
+import Atomics
+import _AtomicsShims
+
+/// A sequential specification of a concurrent data structure, used to check
+/// that concurrent histories recorded by `checkLinearizability` are
+/// linearizable.
+///
+/// Conforming types represent the abstract state of the data structure. They
+/// must have value semantics: the checker applies operations to copies of the
+/// state while it searches for a valid linearization, and it remembers the
+/// states it has already visited.
+protocol SequentialModel: Hashable {
+  associatedtype Operation
+  associatedtype Result: Equatable
+
+  /// Performs `operation` on this state and returns its result.
+  mutating func apply(_ operation: Operation) -> Result
+}
+
+/// An operation that completed during a stress test.
+struct HistoryEvent<Operation, Result> {
+  let thread: Int
+  let operation: Operation
+  let result: Result
+
+  /// Timestamps taken immediately before the operation was invoked and after
+  /// it returned. Timestamps are drawn from a single sequentially consistent
+  /// counter, so if `a.response < b.invocation`, then `a` completed before
+  /// `b` started.
+  let invocation: Int
+  let response: Int
+}
+
+/// Collects a concurrent history of operations. Each thread appends events
+/// to its own log; the only state shared between threads is the clock.
+final class HistoryRecorder<Operation, Result> {
+  typealias Event = HistoryEvent<Operation, Result>
+
+  private final class Log {
+    var events: [Event] = []
+  }
+
+  private let clock = ManagedAtomic<Int>(0)
+  private let logs: [Log]
+
+  init(threads: Int) {
+    logs = (0 ..< threads).map { _ in Log() }
+  }
+
+  /// Performs `operation` by calling `body`, and records it as an event on
+  /// the given thread. Each thread must only use its own index.
+  func record(
+    thread: Int,
+    _ operation: Operation,
+    _ body: (Operation) -> Result
+  ) {
+    let invocation = clock.loadThenWrappingIncrement(
+      ordering: .sequentiallyConsistent)
+    let result = body(operation)
+    let response = clock.loadThenWrappingIncrement(
+      ordering: .sequentiallyConsistent)
+    logs[thread].events.append(Event(
+        thread: thread,
+        operation: operation,
+        result: result,
+        invocation: invocation,
+        response: response))
+  }
+
+  /// The events recorded so far. This must not be called while threads are
+  /// still recording.
+  var history: [Event] {
+    logs.flatMap { $0.events }
+  }
+}
+
+private struct LinearizationKey<Model: Hashable>: Hashable {
+  var linearized: [UInt64]
+  var state: Model
+}
+
+/// Searches for a sequential ordering of `history` that respects real-time
+/// order (an operation that completed before another started is ordered
+/// before it) and that produces the recorded results when replayed on the
+/// model, starting from `initialState`.
+///
+/// This is the Wing & Gong search, with Lowe's memoization of visited
+/// (linearized set, state) pairs. It is exponential in the worst case, so
+/// keep histories to a few hundred events.
+///
+/// Returns the linearization if one exists, or nil if the history isn't
+/// linearizable.
+func linearize<Model: SequentialModel>(
+  _ history: [HistoryEvent<Model.Operation, Model.Result>],
+  from initialState: Model
+) -> [HistoryEvent<Model.Operation, Model.Result>]? {
+  let events = history.sorted { $0.invocation < $1.invocation }
+  var linearized = [UInt64](repeating: 0, count: (events.count + 63) / 64)
+  var order: [Int] = []
+  var visited: Set<LinearizationKey<Model>> = []
+
+  func isLinearized(_ i: Int) -> Bool {
+    linearized[i / 64] & (1 << UInt64(i % 64)) != 0
+  }
+
+  func search(_ state: Model) -> Bool {
+    if order.count == events.count { return true }
+    // Only pending events that were invoked before the earliest pending
+    // response can be linearized next.
+    var deadline = Int.max
+    for i in events.indices where !isLinearized(i) {
+      deadline = Swift.min(deadline, events[i].response)
+    }
+    for i in events.indices where !isLinearized(i) {
+      let event = events[i]
+      if event.invocation > deadline { break }
+      var next = state
+      guard next.apply(event.operation) == event.result else { continue }
+      linearized[i / 64] |= 1 << UInt64(i % 64)
+      if visited.insert(LinearizationKey(linearized: linearized, state: next)).inserted {
+        order.append(i)
+        if search(next) { return true }
+        order.removeLast()
+      }
+      linearized[i / 64] &= ~(1 << UInt64(i % 64))
+    }
+    return false
+  }
+
+  guard search(initialState) else { return nil }
+  return order.map { events[$0] }
+}
+
+/// A small, fast pseudo-random number generator (SplitMix64), so that stress
+/// tests can be reproduced from their seed.
+struct StressRandom: RandomNumberGenerator {
+  private var state: UInt64
+
+  init(seed: UInt64) {
+    self.state = seed
+  }
+
+  mutating func next() -> UInt64 {
+    state &+= 0x9E3779B97F4A7C15
+    var z = state
+    z = (z ^ (z >> 30)) &* 0xBF58476D1CE4E5B9
+    z = (z ^ (z >> 27)) &* 0x94D049BB133111EB
+    return z ^ (z >> 31)
+  }
+
+  /// Randomly delays the current thread by yielding it or by spinning for a
+  /// short while, to shake up the interleaving of operations.
+  mutating func perturb() {
+    switch next() % 32 {
+    case 0:
+      _sa_thread_yield()
+    case 1 ..< 8:
+      _stressSpin(Int(next() % 512))
+    default:
+      break
+    }
+  }
+}
+
+@inline(never)
+func _stressSpin(_ count: Int) {
+  var i = 0
+  while i < count { i = _stressIdentity(i) + 1 }
+}
+
+@inline(never)
+func _stressIdentity(_ value: Int) -> Int { value }
+
+extension XCTestCase {
+  /// Runs a randomized stress test of a concurrent data structure and checks
+  /// that its behavior is linearizable with respect to the sequential `model`.
+  ///
+  /// Each round creates a new subject with `makeSubject`, then has `threads`
+  /// threads each perform `operationsPerThread` operations chosen by
+  /// `generate`, randomly perturbing the schedule between operations. The
+  /// resulting history is checked by `linearize(_:from:)`; on failure, the
+  /// history is reported along with the seed that reproduces it.
+  ///
+  /// `generate` and `execute` are called concurrently from all threads.
+  func checkLinearizability<Model: SequentialModel, Subject>(
+    model: Model,
+    threads: Int = 4,
+    operationsPerThread: Int = 50,
+    rounds: Int = 100,
+    seed: UInt64? = nil,
+    makeSubject: () -> Subject,
+    tearDown: (Subject) -> Void = { _ in },
+    generate: (_ thread: Int, _ random: inout StressRandom) -> Model.Operation,
+    execute: (Subject, Model.Operation) -> Model.Result,
+    file: StaticString = #file,
+    line: UInt = #line
+  ) {
+    let seed = seed ?? UInt64.random(in: 0 ... .max)
+    var seeds = StressRandom(seed: seed)
+    for round in 0 ..< rounds {
+      let roundSeed = seeds.next()
+      let subject = makeSubject()
+      let recorder = HistoryRecorder<Model.Operation, Model.Result>(
+        threads: threads)
+      let ready = ManagedAtomic<Int>(0)
+      DispatchQueue.concurrentPerform(iterations: threads) { thread in
+        var random = StressRandom(seed: roundSeed ^ (UInt64(thread) << 56))
+        // Try to start all threads at the same time, but don't wait forever
+        // in case the system runs fewer threads than requested.
+        ready.wrappingIncrement(ordering: .acquiringAndReleasing)
+        var spins = 0
+        while ready.load(ordering: .acquiring) < threads && spins < 100_000 {
+          spins += 1
+        }
+        for _ in 0 ..< operationsPerThread {
+          random.perturb()
+          let operation = generate(thread, &random)
+          recorder.record(thread: thread, operation) { execute(subject, $0) }
+        }
+      }
+      tearDown(subject)
+
+      let history = recorder.history
+      if linearize(history, from: model) == nil {
+        let events = history
+          .sorted { $0.invocation < $1.invocation }
+          .map { e in
+            "  [\(e.invocation)-\(e.response)] thread \(e.thread): " +
+            "\(e.operation) -> \(e.result)"
+          }
+          .joined(separator: "\n")
+        XCTFail(
+          """
+          Non-linearizable history in round \(round) (seed \(seed)):
+          \(events)
+          """,
+          file: file, line: line)
+        return
+      }
+    }
+  }
+}
+
+/// A sequential model of an atomic variable, for stress testing atomic
+/// operations on any `AtomicValue` type.
+struct AtomicRegisterModel<Value: AtomicValue & Hashable>: SequentialModel {
+  enum Operation {
+    case load
+    case store(Value)
+    case exchange(Value)
+    case compareExchange(expected: Value, desired: Value)
+  }
+
+  enum Result: Equatable {
+    case none
+    case value(Value)
+    case exchanged(Bool, Value)
+  }
+
+  var value: Value
+
+  init(_ value: Value) {
+    self.value = value
+  }
+
+  mutating func apply(_ operation: Operation) -> Result {
+    switch operation {
+    case .load:
+      return .value(value)
+    case .store(let new):
+      value = new
+      return .none
+    case .exchange(let new):
+      defer { value = new }
+      return .value(value)
+    case let .compareExchange(expected: expected, desired: desired):
+      let original = value
+      if original == expected { value = desired }
+      return .exchanged(original == expected, original)
+    }
+  }
+
+  /// Performs `operation` on `atomic` with sequentially consistent ordering.
+  static func execute(
+    _ operation: Operation,
+    on atomic: ManagedAtomic<Value>
+  ) -> Result {
+    switch operation {
+    case .load:
+      return .value(atomic.load(ordering: .sequentiallyConsistent))
+    case .store(let new):
+      atomic.store(new, ordering: .sequentiallyConsistent)
+      return .none
+    case .exchange(let new):
+      return .value(atomic.exchange(new, ordering: .sequentiallyConsistent))
+    case let .compareExchange(expected: expected, desired: desired):
+      let (exchanged, original) = atomic.compareExchange(
+        expected: expected,
+        desired: desired,
+        ordering: .sequentiallyConsistent)
+      return .exchanged(exchanged, original)
+    }
+  }
+}
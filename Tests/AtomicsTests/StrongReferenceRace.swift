@@ -14,7 +14,6 @@ import XCTest
 import Atomics
 import Dispatch
 
-#if !(os(Linux) && arch(x86_64)) || ENABLE_DOUBLEWIDE_ATOMICS
 let iterations = 1_000_000
 
 private class Node: AtomicReference {
@@ -282,4 +281,3 @@ class StrongReferenceRace: XCTestCase {
   ]
 #endif
 }
-#endif
@@ -19,7 +19,6 @@ import XCTest
 import Atomics
 import Dispatch
 
-#if !(os(Linux) && arch(x86_64)) || ENABLE_DOUBLEWIDE_ATOMICS
 private let nodeCount = ManagedAtomic<Int>(0)
 
 private class List<Value: Equatable> {
@@ -284,4 +283,3 @@ class StrongReferenceShuffleTests: XCTestCase {
   ]
 #endif
 }
-#endif
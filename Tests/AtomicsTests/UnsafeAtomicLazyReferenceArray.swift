@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Dispatch
+import Atomics
+
+class UnsafeAtomicLazyReferenceArrayTests: XCTestCase {
+  func test_create_destroy() {
+    let a = UnsafeAtomicLazyReferenceArray<LifetimeTracked>.create(count: 10)
+    defer { a.destroy() }
+    XCTAssertEqual(a.count, 10)
+    XCTAssertTrue((0 ..< 10).allSatisfy { a.load(at: $0) == nil })
+  }
+
+  func test_storeIfNilThenLoad() {
+    do {
+      let a = UnsafeAtomicLazyReferenceArray<LifetimeTracked>.create(count: 4)
+
+      let ref = LifetimeTracked(42)
+      XCTAssertTrue(a.storeIfNilThenLoad(ref, at: 1) === ref)
+      XCTAssertTrue(a.load(at: 1) === ref)
+      XCTAssertNil(a.load(at: 0))
+      XCTAssertNil(a.load(at: 2))
+
+      let ref2 = LifetimeTracked(23)
+      XCTAssertTrue(a.storeIfNilThenLoad(ref2, at: 1) === ref)
+      XCTAssertTrue(a.storeIfNilThenLoad(ref2, at: 3) === ref2)
+      XCTAssertTrue(a[3].load() === ref2)
+
+      XCTAssertEqual(a.disposeAll(), 2)
+      XCTAssertNil(a.load(at: 1))
+      _ = a.storeIfNilThenLoad(LifetimeTracked(1), at: 0)
+      a.destroy()
+    }
+    XCTAssertEqual(LifetimeTracked.instances, 0)
+  }
+
+  func test_race() {
+    final class Box {
+      let thread: Int
+      init(_ thread: Int) { self.thread = thread }
+    }
+    let count = 1000
+    let a = UnsafeAtomicLazyReferenceArray<Box>.create(count: count)
+    defer { a.destroy() }
+    let mismatches = ManagedAtomic<Int>(0)
+    DispatchQueue.concurrentPerform(iterations: 8) { thread in
+      for index in 0 ..< count {
+        let winner = a.storeIfNilThenLoad(Box(thread), at: index)
+        if a.load(at: index) !== winner {
+          mismatches.wrappingIncrement(ordering: .relaxed)
+        }
+      }
+    }
+    XCTAssertEqual(mismatches.load(ordering: .relaxed), 0)
+    XCTAssertTrue((0 ..< count).allSatisfy { a.load(at: $0) != nil })
+  }
+
+#if !SWIFT_PACKAGE
+  public static var allTests = [
+    ("test_create_destroy", test_create_destroy),
+    ("test_storeIfNilThenLoad", test_storeIfNilThenLoad),
+    ("test_race", test_race),
+  ]
+#endif
+}
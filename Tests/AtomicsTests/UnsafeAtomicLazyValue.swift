@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Dispatch
+import Atomics
+
+private struct Table {
+  var header: UInt8
+  var entries: [LifetimeTracked]
+}
+
+class UnsafeAtomicLazyValueTests: XCTestCase {
+  func test_create_destroy() {
+    let v = UnsafeAtomicLazyValue<Table>.create()
+    defer { v.destroy() }
+    XCTAssertNil(v.load())
+    XCTAssertNil(v.withUnsafeLoadedValue { $0.pointee.header })
+  }
+
+  func test_storeIfNilThenLoad() {
+    do {
+      let v = UnsafeAtomicLazyValue<Table>.create()
+      XCTAssertNil(v.load())
+
+      let table = Table(header: 1, entries: [LifetimeTracked(42)])
+      XCTAssertEqual(v.storeIfNilThenLoad(table).header, 1)
+      XCTAssertEqual(v.load()?.header, 1)
+
+      let table2 = Table(header: 2, entries: [LifetimeTracked(23)])
+      XCTAssertEqual(v.storeIfNilThenLoad(table2).header, 1)
+      XCTAssertEqual(
+        v.withUnsafeLoadedValue { $0.pointee.entries[0].value },
+        42)
+
+      XCTAssertEqual(v.destroy()?.header, 1)
+    }
+    XCTAssertEqual(LifetimeTracked.instances, 0)
+  }
+
+  func test_smallValues() {
+    let v = UnsafeAtomicLazyValue<UInt8>.create()
+    defer { v.destroy() }
+    XCTAssertEqual(v.storeIfNilThenLoad(7), 7)
+    XCTAssertEqual(v.storeIfNilThenLoad(8), 7)
+    XCTAssertEqual(v.withUnsafeLoadedValue { $0.pointee }, 7)
+  }
+
+  func test_race() {
+    let v = UnsafeAtomicLazyValue<[Int]>.create()
+    defer { v.destroy() }
+    let mismatches = ManagedAtomic<Int>(0)
+    DispatchQueue.concurrentPerform(iterations: 8) { thread in
+      let mine = Array(repeating: thread, count: 1000)
+      let winner = v.storeIfNilThenLoad(mine)
+      if winner != v.load() || Set(winner).count != 1 {
+        mismatches.wrappingIncrement(ordering: .relaxed)
+      }
+    }
+    XCTAssertEqual(mismatches.load(ordering: .relaxed), 0)
+  }
+
+#if !SWIFT_PACKAGE
+  public static var allTests = [
+    ("test_create_destroy", test_create_destroy),
+    ("test_storeIfNilThenLoad", test_storeIfNilThenLoad),
+    ("test_smallValues", test_smallValues),
+    ("test_race", test_race),
+  ]
+#endif
+}
@@ -0,0 +1,126 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Dispatch
+import Atomics
+
+private final class Item {
+  let value: Int
+  let taken = ManagedAtomic<Int>(0)
+
+  init(_ value: Int) {
+    self.value = value
+  }
+}
+
+class WorkStealingDequeTests: XCTestCase {
+  func test_ownerAndThief() {
+    let deque = WorkStealingDeque<LifetimeTracked>(capacity: 2)
+    XCTAssertTrue(deque.isEmpty)
+    XCTAssertNil(deque.pop())
+    XCTAssertNil(deque.steal())
+
+    for i in 0 ..< 10 {
+      deque.push(LifetimeTracked(i))
+    }
+    XCTAssertEqual(deque.count, 10)
+    XCTAssertEqual(deque.pop()?.value, 9)
+    XCTAssertEqual(deque.steal()?.value, 0)
+    XCTAssertEqual(deque.pop()?.value, 8)
+    XCTAssertEqual(deque.steal()?.value, 1)
+    XCTAssertEqual(deque.count, 6)
+  }
+
+  func test_remainingElementsAreReleased() {
+    let instances = LifetimeTracked.instances
+    do {
+      let deque = WorkStealingDeque<LifetimeTracked>(capacity: 4)
+      for i in 0 ..< 100 {
+        deque.push(LifetimeTracked(i))
+      }
+      _ = deque.steal()
+      _ = deque.pop()
+    }
+    XCTAssertEqual(LifetimeTracked.instances, instances)
+  }
+
+  func test_batchSteal() {
+    let victim = WorkStealingDeque<LifetimeTracked>()
+    let thief = WorkStealingDeque<LifetimeTracked>()
+    for i in 0 ..< 10 {
+      victim.push(LifetimeTracked(i))
+    }
+    let first = victim.steal(maxCount: 100, into: thief)
+    XCTAssertEqual(first?.value, 0)
+    // Half of the elements were stolen; the first one was returned.
+    XCTAssertEqual(victim.count, 5)
+    XCTAssertEqual(thief.count, 4)
+    XCTAssertEqual(thief.pop()?.value, 4)
+    XCTAssertEqual(thief.steal()?.value, 1)
+
+    XCTAssertEqual(victim.steal(maxCount: 2, into: thief)?.value, 5)
+    XCTAssertEqual(victim.count, 3)
+    XCTAssertEqual(thief.count, 3)
+  }
+
+  func test_concurrent() {
+    let count = 100_000
+    let thieves = 4
+    let items = (0 ..< count).map { Item($0) }
+    let deque = WorkStealingDeque<Item>(capacity: 8)
+    let done = ManagedAtomic<Bool>(false)
+
+    runOnThreads(thieves + 1) { thread in
+      if thread == 0 {
+        for (index, item) in items.enumerated() {
+          deque.push(item)
+          if index % 3 == 0, let item = deque.pop() {
+            item.taken.wrappingIncrement(ordering: .relaxed)
+          }
+        }
+        while let item = deque.pop() {
+          item.taken.wrappingIncrement(ordering: .relaxed)
+        }
+        done.store(true, ordering: .releasing)
+        return
+      }
+      let local = WorkStealingDeque<Item>()
+      while true {
+        let item = thread % 2 == 0
+          ? deque.steal()
+          : deque.steal(maxCount: 8, into: local)
+        if let item = item {
+          item.taken.wrappingIncrement(ordering: .relaxed)
+        } else if done.load(ordering: .acquiring) {
+          break
+        }
+        while let item = local.pop() {
+          item.taken.wrappingIncrement(ordering: .relaxed)
+        }
+      }
+    }
+
+    XCTAssertTrue(deque.isEmpty)
+    let wrong = items.filter { $0.taken.load(ordering: .relaxed) != 1 }
+    XCTAssertEqual(wrong.map { $0.value }, [])
+  }
+
+#if !SWIFT_PACKAGE
+  public static var allTests = [
+    ("test_ownerAndThief", test_ownerAndThief),
+    ("test_remainingElementsAreReleased", test_remainingElementsAreReleased),
+    ("test_batchSteal", test_batchSteal),
+    ("test_concurrent", test_concurrent),
+  ]
+#endif
+}
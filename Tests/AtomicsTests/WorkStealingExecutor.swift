@@ -0,0 +1,138 @@
+//===----------------------------------------------------------------------===//
+//
+// This source file is part of the Swift Atomics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Dispatch
+import Foundation
+import Atomics
+import AtomicsExecutor
+
+private func fibonacci(_ n: Int, on executor: WorkStealingExecutor) -> Int {
+  if n < 2 { return n }
+  if n < 12 {
+    return fibonacci(n - 1, on: executor) + fibonacci(n - 2, on: executor)
+  }
+  let first = executor.spawn { fibonacci(n - 1, on: executor) }
+  let second = fibonacci(n - 2, on: executor)
+  return first.join() + second
+}
+
+class WorkStealingExecutorTests: XCTestCase {
+  func test_execute() {
+    let executor = WorkStealingExecutor(workerCount: 4)
+    let counter = ManagedAtomic<Int>(0)
+    for _ in 0 ..< 10_000 {
+      executor.execute {
+        counter.wrappingIncrement(ordering: .relaxed)
+      }
+    }
+    executor.shutdown()
+    XCTAssertEqual(counter.load(ordering: .relaxed), 10_000)
+  }
+
+  func test_spawnJoin() {
+    let executor = WorkStealingExecutor(workerCount: 2)
+    let handles = (0 ..< 1000).map { i in executor.spawn { i * i } }
+    XCTAssertEqual(handles.map { $0.join() }, (0 ..< 1000).map { $0 * $0 })
+    XCTAssertTrue(handles.allSatisfy { $0.isFinished })
+  }
+
+  func test_nestedSpawns() {
+    // Tasks that join their children run other tasks while they wait, so
+    // this doesn't deadlock even with a single worker.
+    for workers in [1, 4] {
+      let executor = WorkStealingExecutor(workerCount: workers)
+      let result = executor.spawn { fibonacci(20, on: executor) }.join()
+      XCTAssertEqual(result, 6765)
+    }
+  }
+
+  func test_idleWorkersWakeUp() {
+    let executor = WorkStealingExecutor(workerCount: 4)
+    for _ in 0 ..< 20 {
+      // Give the workers time to park.
+      Thread.sleep(forTimeInterval: 0.002)
+      XCTAssertEqual(executor.spawn { 42 }.join(), 42)
+    }
+  }
+
+  // Benchmarks comparing the latency of spawning a task and waiting for its
+  // result with Dispatch. These only run when `benchmarksEnabled` is true,
+  // and are most meaningful in release builds:
+  //
+  //     $ SWIFT_ATOMICS_BENCHMARKS=1 swift test -c release \
+  //         --filter WorkStealingExecutorTests
+
+  func test_benchmark_spawnJoin_executor() {
+    guard benchmarksEnabled else { return }
+    let executor = WorkStealingExecutor()
+    measure {
+      for i in 0 ..< 10_000 {
+        _ = executor.spawn { i }.join()
+      }
+    }
+  }
+
+  func test_benchmark_spawnJoin_dispatch() {
+    guard benchmarksEnabled else { return }
+    let queue = DispatchQueue.global()
+    measure {
+      for i in 0 ..< 10_000 {
+        let done = DispatchSemaphore(value: 0)
+        var result = 0
+        queue.async {
+          result = i
+          done.signal()
+        }
+        done.wait()
+        _ = result
+      }
+    }
+  }
+
+  func test_benchmark_fanOut_executor() {
+    guard benchmarksEnabled else { return }
+    let executor = WorkStealingExecutor()
+    measure {
+      let handles = (0 ..< 100_000).map { i in executor.spawn { i } }
+      _ = handles.reduce(0) { $0 &+ $1.join() }
+    }
+  }
+
+  func test_benchmark_fanOut_dispatch() {
+    guard benchmarksEnabled else { return }
+    let queue = DispatchQueue.global()
+    measure {
+      let group = DispatchGroup()
+      let total = ManagedAtomic<Int>(0)
+      for i in 0 ..< 100_000 {
+        queue.async(group: group) {
+          total.wrappingIncrement(by: i, ordering: .relaxed)
+        }
+      }
+      group.wait()
+    }
+  }
+
+#if !SWIFT_PACKAGE
+  public static var allTests = [
+    ("test_execute", test_execute),
+    ("test_spawnJoin", test_spawnJoin),
+    ("test_nestedSpawns", test_nestedSpawns),
+    ("test_idleWorkersWakeUp", test_idleWorkersWakeUp),
+    ("test_benchmark_spawnJoin_executor", test_benchmark_spawnJoin_executor),
+    ("test_benchmark_spawnJoin_dispatch", test_benchmark_spawnJoin_dispatch),
+    ("test_benchmark_fanOut_executor", test_benchmark_fanOut_executor),
+    ("test_benchmark_fanOut_dispatch", test_benchmark_fanOut_dispatch),
+  ]
+#endif
+}
@@ -42,7 +42,6 @@ private class Bar: Equatable, CustomStringConvertible {
   }
 }
 
-#if !(os(Linux) && arch(x86_64)) || ENABLE_DOUBLEWIDE_ATOMICS
 private class Baz: Equatable, CustomStringConvertible, AtomicReference {
   var value: Int
   init(_ value: Int) { self.value = value }
@@ -51,14 +50,12 @@ private class Baz: Equatable, CustomStringConvertible, AtomicReference {
     left === right
   }
 }
-#endif
 
 private enum Fred: Int, AtomicValue {
   case one
   case two
 }
 
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicIntTests: XCTestCase {
@@ -2589,8 +2586,6 @@ class BasicAtomicIntTests: XCTestCase {
     ("test_bitwiseXorThenLoad_sequentiallyConsistent", test_bitwiseXorThenLoad_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicInt8Tests: XCTestCase {
@@ -5121,8 +5116,6 @@ class BasicAtomicInt8Tests: XCTestCase {
     ("test_bitwiseXorThenLoad_sequentiallyConsistent", test_bitwiseXorThenLoad_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicInt16Tests: XCTestCase {
@@ -7653,8 +7646,6 @@ class BasicAtomicInt16Tests: XCTestCase {
     ("test_bitwiseXorThenLoad_sequentiallyConsistent", test_bitwiseXorThenLoad_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicInt32Tests: XCTestCase {
@@ -10185,8 +10176,6 @@ class BasicAtomicInt32Tests: XCTestCase {
     ("test_bitwiseXorThenLoad_sequentiallyConsistent", test_bitwiseXorThenLoad_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicInt64Tests: XCTestCase {
@@ -12717,8 +12706,6 @@ class BasicAtomicInt64Tests: XCTestCase {
     ("test_bitwiseXorThenLoad_sequentiallyConsistent", test_bitwiseXorThenLoad_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicUIntTests: XCTestCase {
@@ -15249,8 +15236,6 @@ class BasicAtomicUIntTests: XCTestCase {
     ("test_bitwiseXorThenLoad_sequentiallyConsistent", test_bitwiseXorThenLoad_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicUInt8Tests: XCTestCase {
@@ -17781,8 +17766,6 @@ class BasicAtomicUInt8Tests: XCTestCase {
     ("test_bitwiseXorThenLoad_sequentiallyConsistent", test_bitwiseXorThenLoad_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicUInt16Tests: XCTestCase {
@@ -20313,8 +20296,6 @@ class BasicAtomicUInt16Tests: XCTestCase {
     ("test_bitwiseXorThenLoad_sequentiallyConsistent", test_bitwiseXorThenLoad_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicUInt32Tests: XCTestCase {
@@ -22845,8 +22826,6 @@ class BasicAtomicUInt32Tests: XCTestCase {
     ("test_bitwiseXorThenLoad_sequentiallyConsistent", test_bitwiseXorThenLoad_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicUInt64Tests: XCTestCase {
@@ -25377,8 +25356,6 @@ class BasicAtomicUInt64Tests: XCTestCase {
     ("test_bitwiseXorThenLoad_sequentiallyConsistent", test_bitwiseXorThenLoad_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicBoolTests: XCTestCase {
@@ -27529,8 +27506,6 @@ class BasicAtomicBoolTests: XCTestCase {
     ("test_logicalXorThenLoad_sequentiallyConsistent", test_logicalXorThenLoad_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicPointerTests: XCTestCase {
@@ -29130,8 +29105,6 @@ class BasicAtomicPointerTests: XCTestCase {
     ("test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent", test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicOptionalPointerTests: XCTestCase {
@@ -30731,8 +30704,6 @@ class BasicAtomicOptionalPointerTests: XCTestCase {
     ("test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent", test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicMutablePointerTests: XCTestCase {
@@ -32332,8 +32303,6 @@ class BasicAtomicMutablePointerTests: XCTestCase {
     ("test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent", test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicOptionalMutablePointerTests: XCTestCase {
@@ -33933,8 +33902,6 @@ class BasicAtomicOptionalMutablePointerTests: XCTestCase {
     ("test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent", test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicRawPointerTests: XCTestCase {
@@ -35523,8 +35490,6 @@ class BasicAtomicRawPointerTests: XCTestCase {
     ("test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent", test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicOptionalRawPointerTests: XCTestCase {
@@ -37113,8 +37078,6 @@ class BasicAtomicOptionalRawPointerTests: XCTestCase {
     ("test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent", test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicMutableRawPointerTests: XCTestCase {
@@ -38703,8 +38666,6 @@ class BasicAtomicMutableRawPointerTests: XCTestCase {
     ("test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent", test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicOptionalMutableRawPointerTests: XCTestCase {
@@ -40293,8 +40254,6 @@ class BasicAtomicOptionalMutableRawPointerTests: XCTestCase {
     ("test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent", test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicUnmanagedTests: XCTestCase {
@@ -41880,8 +41839,6 @@ class BasicAtomicUnmanagedTests: XCTestCase {
     ("test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent", test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicOptionalUnmanagedTests: XCTestCase {
@@ -43467,8 +43424,6 @@ class BasicAtomicOptionalUnmanagedTests: XCTestCase {
     ("test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent", test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent),
   ]
 }
-#endif
-#if true
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicRawRepresentableTests: XCTestCase {
@@ -45047,8 +45002,6 @@ class BasicAtomicRawRepresentableTests: XCTestCase {
     ("test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent", test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent),
   ]
 }
-#endif
-#if !(os(Linux) && arch(x86_64)) || ENABLE_DOUBLEWIDE_ATOMICS
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicDoubleWordTests: XCTestCase {
@@ -46627,8 +46580,6 @@ class BasicAtomicDoubleWordTests: XCTestCase {
     ("test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent", test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent),
   ]
 }
-#endif
-#if !(os(Linux) && arch(x86_64)) || ENABLE_DOUBLEWIDE_ATOMICS
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicReferenceTests: XCTestCase {
@@ -48209,8 +48160,6 @@ class BasicAtomicReferenceTests: XCTestCase {
     ("test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent", test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent),
   ]
 }
-#endif
-#if !(os(Linux) && arch(x86_64)) || ENABLE_DOUBLEWIDE_ATOMICS
 /// Exercises all operations in a single-threaded context, verifying
 /// they provide the expected results.
 class BasicAtomicOptionalReferenceTests: XCTestCase {
@@ -49791,4 +49740,3 @@ class BasicAtomicOptionalReferenceTests: XCTestCase {
     ("test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent", test_weakCompareExchange_sequentiallyConsistent_sequentiallyConsistent),
   ]
 }
-#endif
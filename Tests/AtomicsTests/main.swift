@@ -41,15 +41,66 @@ XCTMain([
   testCase(BasicAtomicReferenceTests.allTests),
   testCase(BasicAtomicOptionalReferenceTests.allTests),
 
+  // AtomicBatchedCounter
+  testCase(AtomicBatchedCounterTests.allTests),
+
+  // AtomicBuffer
+  testCase(AtomicBufferTests.allTests),
+
+  // AtomicContentionProfiler
+  testCase(AtomicContentionProfilerTests.allTests),
+
+  // AtomicHistogram
+  testCase(AtomicHistogramTests.allTests),
+
+  // AtomicInstrumentation
+  testCase(AtomicInstrumentationTests.allTests),
+
+  // AtomicModelChecker
+  testCase(AtomicModelCheckerTests.allTests),
+
+  // AtomicOnceCell
+  testCase(AtomicOnceCellTests.allTests),
+
+  // AtomicOrderingAdvisor
+  testCase(AtomicOrderingAdvisorTests.allTests),
+
+  // AtomicPackedValue
+  testCase(AtomicPackedValueTests.allTests),
+
+  // AtomicStateMachine
+  testCase(AtomicStateMachineTests.allTests),
+
+  // AtomicWeakReference
+  testCase(AtomicWeakReferenceTests.allTests),
+
+  // BroadcastRing
+  testCase(BroadcastRingTests.allTests),
+
+  // Contention
+  testCase(ContentionTests.allTests),
+
   // DoubleWord
   testCase(DoubleWordTests.allTests),
 
+  // Linearizability
+  testCase(LinearizabilityTests.allTests),
+
+  // MultiWordCompareExchange
+  testCase(MultiWordCompareExchangeTests.allTests),
+
   // LockFreeQueue
   testCase(QueueTests.allTests),
 
   // LockFreeSingleConsumerStackTests
   testCase(LockFreeSingleConsumerStackTests.allTests),
 
+  // ScalableNonZeroIndicator
+  testCase(ScalableNonZeroIndicatorTests.allTests),
+
+  // SharedAtomicRegion
+  testCase(SharedAtomicRegionTests.allTests),
+
   // StrongReferenceRace
   testCase(StrongReferenceRace.allTests),
 
@@ -58,5 +109,17 @@ XCTMain([
 
   // UnsafeAtomicLazyReferenceTests
   testCase(UnsafeAtomicLazyReferenceTests.allTests),
+
+  // UnsafeAtomicLazyReferenceArray
+  testCase(UnsafeAtomicLazyReferenceArrayTests.allTests),
+
+  // UnsafeAtomicLazyValue
+  testCase(UnsafeAtomicLazyValueTests.allTests),
+
+  // WorkStealingDeque
+  testCase(WorkStealingDequeTests.allTests),
+
+  // WorkStealingExecutor
+  testCase(WorkStealingExecutorTests.allTests),
 ])
 #endif